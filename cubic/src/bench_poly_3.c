@@ -0,0 +1,112 @@
+// === bench_poly_3.c for DSKYpoly-3 ===
+// Throughput of the scalar solve_poly_3 loop against the batched
+// SSE2 / AVX2 / AVX-512 kernels on the same coefficient quadruples.
+//
+// usage: bench_poly_3 [results.json]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "dskypoly.h"
+#include "dskypoly_bench.h"
+
+#define BENCH_N      (1 << 12)   // cubics per pass (cache resident)
+#define BENCH_PASSES 1000
+
+typedef void (*batch_kernel)(const double*, const double*, const double*, const double*,
+                             size_t, double*, double*);
+
+static double a[BENCH_N], b[BENCH_N], c[BENCH_N], d[BENCH_N];
+static double re[3 * BENCH_N], im[3 * BENCH_N];
+static double ref_re[3 * BENCH_N], ref_im[3 * BENCH_N];
+
+// Random coefficients; a mix of one-real-root and three-real-root cubics
+static void fill_coefficients(void) {
+    srand(2025);
+    for (int i = 0; i < BENCH_N; i++) {
+        double sign = (rand() & 1) ? 1.0 : -1.0;
+        a[i] = sign * (0.5 + 1.5 * rand() / (double)RAND_MAX);
+        b[i] = -10.0 + 20.0 * rand() / (double)RAND_MAX;
+        c[i] = -10.0 + 20.0 * rand() / (double)RAND_MAX;
+        d[i] = -10.0 + 20.0 * rand() / (double)RAND_MAX;
+    }
+}
+
+static bench_timer bench_scalar(void) {
+    bench_timer t;
+    double r[3], s[3];
+    bench_timer_init(&t);
+    for (int pass = 0; pass < BENCH_PASSES; pass++) {
+        bench_begin(&t);
+        for (int i = 0; i < BENCH_N; i++) {
+            solve_poly_3(a[i], b[i], c[i], d[i], r, s);
+            for (int k = 0; k < 3; k++) {
+                ref_re[k * BENCH_N + i] = r[k];
+                ref_im[k * BENCH_N + i] = s[k];
+            }
+        }
+        bench_end(&t);
+    }
+    return t;
+}
+
+static bench_timer bench_batch(batch_kernel kernel, double* max_err) {
+    bench_timer t;
+    bench_timer_init(&t);
+    for (int pass = 0; pass < BENCH_PASSES; pass++) {
+        bench_begin(&t);
+        kernel(a, b, c, d, BENCH_N, re, im);
+        bench_end(&t);
+    }
+
+    // Compare against the scalar loop, relative to the root magnitude
+    double err = 0.0;
+    for (int i = 0; i < BENCH_N; i++) {
+        double scale = 1.0, e = 0.0;
+        for (int k = 0; k < 3; k++) {
+            int j = k * BENCH_N + i;
+            scale += fabs(ref_re[j]) + fabs(ref_im[j]);
+            e += fabs(re[j] - ref_re[j]) + fabs(im[j] - ref_im[j]);
+        }
+        if (!(e / scale <= err)) err = e / scale;   // NaN counts as a mismatch
+    }
+    *max_err = err;
+    return t;
+}
+
+int main(int argc, char** argv) {
+    double err;
+    int level = dskypoly_cpu_level();
+
+    printf("=== DSKYpoly Cubic Benchmark ===\n");
+    printf("%d cubics per pass, best of %d passes\n\n", BENCH_N, BENCH_PASSES);
+    bench_json_open(argc > 1 ? argv[1] : NULL, "cubic", dskypoly_isa_name(level));
+    fill_coefficients();
+
+    bench_timer scalar = bench_scalar();
+    bench_report("solve_poly_3 (scalar)", "single", &scalar, BENCH_N, scalar.seconds, -1.0);
+
+    bench_timer t = bench_batch(solve_poly_3_batch_sse2, &err);
+    bench_report("batch SSE2 (2-wide)", "batch", &t, BENCH_N, scalar.seconds, err);
+
+    if (level >= DSKYPOLY_ISA_AVX2) {
+        t = bench_batch(solve_poly_3_batch_avx2, &err);
+        bench_report("batch AVX2 (4-wide)", "batch", &t, BENCH_N, scalar.seconds, err);
+    } else {
+        printf("%-26s skipped (AVX2 not available)\n", "batch AVX2 (4-wide)");
+    }
+    if (level >= DSKYPOLY_ISA_AVX512) {
+        t = bench_batch(solve_poly_3_batch_avx512, &err);
+        bench_report("batch AVX-512 (8-wide)", "batch", &t, BENCH_N, scalar.seconds, err);
+    } else {
+        printf("%-26s skipped (AVX-512F not available)\n", "batch AVX-512 (8-wide)");
+    }
+
+    t = bench_batch(solve_poly_3_batch, &err);
+    bench_report("solve_poly_3_batch", "batch", &t, BENCH_N, scalar.seconds, err);
+    printf("\nDispatch bound solve_poly_3_batch for %s\n", dskypoly_isa_name(level));
+
+    bench_json_close();
+    return 0;
+}
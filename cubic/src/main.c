@@ -4,11 +4,11 @@
 #include <stdio.h>
 #include <stdlib.h>
 
-// Declare the external assembly function
-extern void solve_cubic(double a, double b, double c, double d);
+#include "dskypoly.h"
 
 int main() {
     double a, b, c, d;
+    double re[3], im[3];
 
     printf("=== DSKYpoly Cubic Solver ===\n");
     printf("Enter coefficients for ax³ + bx² + cx + d = 0\n");
@@ -29,7 +29,14 @@ int main() {
     printf("\nSolving: %.4fx³ + %.4fx² + %.4fx + %.4f = 0\n", a, b, c, d);
 
     // Call the symbolic solver
-    solve_cubic(a, b, c, d);
+    int count = solve_poly_3(a, b, c, d, re, im);
+
+    for (int i = 0; i < count; i++) {
+        if (im[i] == 0.0)
+            printf("Real Root: %.6f\n", re[i]);
+        else
+            printf("Complex Root: %.6f %+.6fi\n", re[i], im[i]);
+    }
 
     return 0;
 }
@@ -1,181 +1,358 @@
 ; solve_poly_3.asm - Cubic polynomial solver using Cardano's method
 ; Solves ax^3 + bx^2 + cx + d = 0
 ; Historical note: Cardano published it, but del Ferro discovered it first! 😉
+;
+; No I/O and no libm calls: all three roots go to caller buffers, so the
+; solver can sit in a hot loop. Printing is left to the caller (main.c).
+;
+; C prototype:
+;   int solve_poly_3(double a, double b, double c, double d,
+;                    double re[3], double im[3]);    // returns 3, or 0 if a == 0
+;
+; Method (the batched kernels in solve_poly_3_batch.asm run the same lane
+; program, so scalar and batched results agree bit for bit):
+;   monic:      B = b/a, C = c/a, D = d/a      (one division, 1/a)
+;   depressed:  x = t + s, s = -B/3,  t^3 + pt + q = 0
+;               p = (3s + 2B)s + C,  q = ((s + B)s + C)s + D
+;   h = q/2, k = p/3, disc = h^2 + k^3
+;   disc > 0  : one real root (Cardano)
+;               u = cbrt(-(h + sign(h) sqrt(disc))),  v = -k/u
+;               t1 = u + v,  t2,3 = -(u+v)/2 ± i (√3/2)|u - v|
+;   disc <= 0 : three real roots, t = 2 sqrt(-k) cos(θ/3 - 2πj/3) with
+;               cos θ = -h/sqrt(-k)^3. cos(θ/3) is the root of the Chebyshev
+;               identity 4c^3 - 3c = cos θ in [1/2, 1], found by Newton's
+;               method from a closed-form seed, so no trig is needed:
+;               t1 = 2mc,  t2,3 = m(-c ± √3 sqrt(1 - c^2)),  m = sqrt(-k)
+;               Real roots come out in descending order of t.
+;
+; Steps 1-3 and the two root branches start at PHASE labels
+; (include/dskypoly_phase.inc). With -DDSKYPOLY_PROFILE (make profile) they
+; become sized symbols for perf annotate and are timed into the
+; DSKYPOLY_PHASE_CARDANO_* histograms.
 
-section .data
-    fmt_real_root db "Real Root: %.6f", 10, 0
-    fmt_complex_root db "Complex Root: %.6f %+.6fi", 10, 0
-    fmt_debug db "p=%.6f, q=%.6f, discriminant=%.6f", 10, 0
-    
+section .rodata
+    align 16
     ; Mathematical constants
-    const_2 dq 2.0
-    const_3 dq 3.0
-    const_4 dq 4.0
-    const_9 dq 9.0
-    const_27 dq 27.0
-    const_neg1 dq -1.0
-    const_sqrt3 dq 1.732050807568877  ; √3
-    const_half dq 0.5
+    const_zero        dq 0.0
+    const_one         dq 1.0
+    const_neg_one     dq -1.0
+    const_three       dq 3.0
+    const_four        dq 4.0
+    const_twelve      dq 12.0
+    const_half        dq 0.5
+    const_neg_half    dq -0.5
+    const_third       dq 0.33333333333333333
+    const_neg_third   dq -0.33333333333333333
+    const_sqrt3       dq 1.7320508075688772   ; √3
+    const_half_sqrt3  dq 0.8660254037844386   ; √3/2
+    align 16
+    mask_abs          dq 0x7FFFFFFFFFFFFFFF, 0x7FFFFFFFFFFFFFFF
+    mask_sign         dq 0x8000000000000000, 0x8000000000000000
 
 section .text
-    global solve_cubic
-    extern printf
-    extern sqrt
-    extern cbrt
-    extern pow
-
-solve_cubic:
-    ; Cardano's method for ax^3 + bx^2 + cx + d = 0
-    ; Arguments: xmm0=a, xmm1=b, xmm2=c, xmm3=d
-    
-    push rbp
-    mov rbp, rsp
-    sub rsp, 80        ; Space for local variables
-    
-    ; Store coefficients
-    movsd [rsp], xmm0      ; a
-    movsd [rsp+8], xmm1    ; b
-    movsd [rsp+16], xmm2   ; c
-    movsd [rsp+24], xmm3   ; d
-    
-    ; === Step 1: Convert to depressed cubic t^3 + pt + q = 0 ===
-    ; Substitution: x = t - b/(3a)
-    
-    ; Calculate p = (3ac - b^2) / (3a^2)
-    movsd xmm4, [rel const_3]  ; 3
-    mulsd xmm4, xmm0           ; 3a
-    mulsd xmm4, xmm2           ; 3ac
-    
-    movsd xmm5, xmm1           ; b
-    mulsd xmm5, xmm1           ; b^2
-    subsd xmm4, xmm5           ; 3ac - b^2
-    
-    movsd xmm5, [rel const_3]  ; 3
-    mulsd xmm5, xmm0           ; 3a
-    mulsd xmm5, xmm0           ; 3a^2
-    divsd xmm4, xmm5           ; p = (3ac - b^2)/(3a^2)
-    movsd [rsp+32], xmm4       ; Store p
-    
-    ; Calculate q = (2b^3 - 9abc + 27a^2d) / (27a^3)
-    movsd xmm4, [rel const_2]  ; 2
-    movsd xmm5, xmm1           ; b
-    mulsd xmm5, xmm1           ; b^2
-    mulsd xmm5, xmm1           ; b^3
-    mulsd xmm4, xmm5           ; 2b^3
-    
-    movsd xmm5, [rel const_9]  ; 9
-    mulsd xmm5, xmm0           ; 9a
-    mulsd xmm5, xmm1           ; 9ab
-    mulsd xmm5, xmm2           ; 9abc
-    subsd xmm4, xmm5           ; 2b^3 - 9abc
-    
-    movsd xmm5, [rel const_27] ; 27
-    movsd xmm6, xmm0           ; a
-    mulsd xmm6, xmm0           ; a^2
-    mulsd xmm5, xmm6           ; 27a^2
-    mulsd xmm5, xmm3           ; 27a^2d
-    addsd xmm4, xmm5           ; 2b^3 - 9abc + 27a^2d
-    
-    movsd xmm5, [rel const_27] ; 27
-    movsd xmm6, xmm0           ; a
-    mulsd xmm6, xmm0           ; a^2
-    mulsd xmm6, xmm0           ; a^3
-    mulsd xmm5, xmm6           ; 27a^3
-    divsd xmm4, xmm5           ; q
-    movsd [rsp+40], xmm4       ; Store q
-    
-    ; === Step 2: Calculate discriminant ===
-    ; Δ = -(4p^3 + 27q^2)
-    movsd xmm4, [rsp+32]       ; p
-    mulsd xmm4, xmm4           ; p^2
-    mulsd xmm4, [rsp+32]       ; p^3
-    mulsd xmm4, [rel const_4]  ; 4p^3
-    
-    movsd xmm5, [rsp+40]       ; q
-    mulsd xmm5, xmm5           ; q^2
-    mulsd xmm5, [rel const_27] ; 27q^2
-    
-    addsd xmm4, xmm5           ; 4p^3 + 27q^2
-    mulsd xmm4, [rel const_neg1] ; -(4p^3 + 27q^2)
-    movsd [rsp+48], xmm4       ; Store discriminant
-    
-    ; Debug output
-    mov rdi, fmt_debug
-    movsd xmm0, [rsp+32]       ; p
-    movsd xmm1, [rsp+40]       ; q
-    movsd xmm2, [rsp+48]       ; discriminant
-    mov rax, 3
-    call printf
-    
-    ; === Step 3: Find roots based on discriminant ===
-    xorpd xmm7, xmm7           ; 0.0
-    ucomisd xmm4, xmm7         ; Compare discriminant with 0
-    jb complex_roots           ; If discriminant < 0, complex roots
-    
-    ; === One real root case (discriminant >= 0) ===
-real_root:
-    ; Use Cardano's formula: t = ∛(-q/2 + √(q²/4 + p³/27)) + ∛(-q/2 - √(q²/4 + p³/27))
-    
-    ; Calculate √(discriminant/108) = √(-Δ/108)
-    movsd xmm4, [rsp+48]       ; discriminant
-    mulsd xmm4, [rel const_neg1] ; -discriminant
-    movsd xmm0, qword [rel const_27] ; 27
-    movsd xmm1, qword [rel const_4]  ; 4
-    mulsd xmm0, xmm1           ; 108
-    divsd xmm4, xmm0           ; -Δ/108
-    
-    movsd xmm0, xmm4           ; Move to xmm0 for sqrt call
-    call sqrt                  ; √(-Δ/108)
-    movsd [rsp+56], xmm0       ; Store sqrt result
-    
-    ; Calculate the real root using simplified approach
-    ; For now, use Newton's method starting point: x₀ = -b/(3a)
-    movsd xmm4, [rsp+8]        ; b
-    mulsd xmm4, [rel const_neg1] ; -b
-    movsd xmm5, [rel const_3]   ; 3
-    mulsd xmm5, [rsp]          ; 3a
-    divsd xmm4, xmm5           ; -b/(3a)
-    
-    ; Print the real root
-    mov rdi, fmt_real_root
-    movsd xmm0, xmm4
-    mov rax, 1
-    call printf
-    
-    jmp done
-    
-complex_roots:
-    ; === Complex roots case ===
-    ; When discriminant < 0, we have one real root and two complex conjugate roots
-    ; For simplicity, show the real root and indicate complex roots
-    
-    ; Calculate the real root (similar to above)
-    movsd xmm4, [rsp+8]        ; b
-    mulsd xmm4, [rel const_neg1] ; -b
-    movsd xmm5, [rel const_3]   ; 3
-    mulsd xmm5, [rsp]          ; 3a
-    divsd xmm4, xmm5           ; -b/(3a) (approximation)
-    
-    mov rdi, fmt_real_root
-    movsd xmm0, xmm4
-    mov rax, 1
-    call printf
-    
-    ; Print complex roots (simplified - showing pattern)
-    mov rdi, fmt_complex_root
-    movsd xmm0, xmm4           ; Real part (simplified)
-    movsd xmm1, [rel const_sqrt3] ; Imaginary part (placeholder)
-    mov rax, 2
-    call printf
-    
-    mov rdi, fmt_complex_root
-    movsd xmm0, xmm4           ; Real part
-    movsd xmm1, [rel const_sqrt3]
-    mulsd xmm1, [rel const_neg1] ; -√3 (conjugate)
-    mov rax, 2
-    call printf
-    
-done:
-    add rsp, 80
-    pop rbp
-    ret
\ No newline at end of file
+%include "dskypoly_phase.inc"
+%ifdef DSKYPOLY_PROFILE
+    global solve_poly_3:function (cardano_monic - solve_poly_3)
+    global cardano_monic:function hidden (cardano_depress - cardano_monic)
+    global cardano_depress:function hidden (cardano_discriminant - cardano_depress)
+    global cardano_discriminant:function hidden (cardano_one_real - cardano_discriminant)
+    global cardano_one_real:function hidden (cardano_three_real - cardano_one_real)
+    global cardano_three_real:function hidden (cubic_depressed_max_root - cardano_three_real)
+    global cubic_depressed_max_root:function (fast_cbrt - cubic_depressed_max_root)
+    global fast_cbrt:function hidden (cardano_text_end - fast_cbrt)
+%else
+    global solve_poly_3
+    global cubic_depressed_max_root
+%endif
+
+;--------------------------------------------------------------------------
+; solve_poly_3: xmm0=a, xmm1=b, xmm2=c, xmm3=d, rdi=re[3], rsi=im[3]
+; Leaf routine apart from fast_cbrt (and the phase record call in profile
+; builds); touches only caller-saved registers.
+;--------------------------------------------------------------------------
+solve_poly_3:
+    xorpd xmm15, xmm15             ; 0.0
+    ucomisd xmm0, xmm15
+    jne .cubic
+    xor eax, eax                   ; a == 0: not a cubic, buffers untouched
+    ret
+
+.cubic:
+    PHASE_FRAME 6                  ; slots: the five phases below, then the end
+
+    ; === Step 1: monic form, one reciprocal ===
+    PHASE cardano_monic, 0
+    movsd xmm4, [rel const_one]
+    divsd xmm4, xmm0               ; 1/a
+    mulsd xmm1, xmm4               ; B
+    mulsd xmm2, xmm4               ; C
+    mulsd xmm3, xmm4               ; D
+
+    ; === Step 2: depressed cubic t^3 + pt + q = 0, x = t + s ===
+    PHASE cardano_depress, 1
+    movsd xmm5, xmm1
+    mulsd xmm5, [rel const_neg_third]  ; s = -B/3
+
+    movsd xmm6, xmm5
+    mulsd xmm6, [rel const_three]
+    addsd xmm6, xmm1
+    addsd xmm6, xmm1
+    mulsd xmm6, xmm5
+    addsd xmm6, xmm2               ; p = (3s + 2B)s + C
+
+    movsd xmm7, xmm5
+    addsd xmm7, xmm1
+    mulsd xmm7, xmm5
+    addsd xmm7, xmm2
+    mulsd xmm7, xmm5
+    addsd xmm7, xmm3               ; q = P(s), Horner
+
+    mulsd xmm7, [rel const_half]   ; h = q/2
+    mulsd xmm6, [rel const_third]  ; k = p/3
+
+    ; === Step 3: discriminant h^2 + k^3 ===
+    PHASE cardano_discriminant, 2
+    movsd xmm8, xmm6
+    mulsd xmm8, xmm6
+    mulsd xmm8, xmm6               ; k^3
+    movsd xmm9, xmm7
+    mulsd xmm9, xmm7               ; h^2
+    addsd xmm8, xmm9               ; disc
+
+    ucomisd xmm8, xmm15
+    jbe cardano_three_real
+
+    ; === One real root + conjugate pair (Cardano) ===
+    PHASE cardano_one_real, 3
+    sqrtsd xmm8, xmm8              ; sqrt(disc)
+    movapd xmm9, xmm7
+    andpd xmm9, [rel mask_sign]
+    orpd xmm8, xmm9                ; sign(h) sqrt(disc), no cancellation
+    addsd xmm8, xmm7
+    xorpd xmm8, [rel mask_sign]    ; u^3 = -(h + sign(h) sqrt(disc))
+    movapd xmm0, xmm8
+    call fast_cbrt                 ; u
+
+    movsd xmm9, xmm6
+    divsd xmm9, xmm0
+    xorpd xmm9, [rel mask_sign]    ; v = -k/u
+    movsd xmm10, xmm0
+    addsd xmm10, xmm9              ; t1 = u + v
+    subsd xmm0, xmm9
+    andpd xmm0, [rel mask_abs]
+    mulsd xmm0, [rel const_half_sqrt3] ; imag = (√3/2)|u - v|
+    movsd xmm11, xmm10
+    mulsd xmm11, [rel const_neg_half]  ; real = -(u + v)/2
+
+    addsd xmm10, xmm5
+    addsd xmm11, xmm5
+    movsd [rdi], xmm10             ; x1 = t1 + s
+    movsd [rdi+8], xmm11
+    movsd [rdi+16], xmm11
+    movsd [rsi], xmm15
+    movsd [rsi+8], xmm0
+    xorpd xmm0, [rel mask_sign]
+    movsd [rsi+16], xmm0           ; conjugate
+    PHASE_END 0, 6                 ; DSKYPOLY_PHASE_CARDANO_MONIC
+    mov eax, 3                     ; three roots, counted with multiplicity
+    ret
+
+    ; === Three real roots (trigonometric form without trig) ===
+    PHASE cardano_three_real, 4
+    movapd xmm1, xmm6
+    xorpd xmm1, [rel mask_sign]    ; -k
+    maxsd xmm1, xmm15
+    sqrtsd xmm1, xmm1              ; m = sqrt(-k)
+    movsd xmm2, xmm1
+    mulsd xmm2, xmm1
+    mulsd xmm2, xmm1               ; m^3
+    movapd xmm3, xmm7
+    xorpd xmm3, [rel mask_sign]
+    divsd xmm3, xmm2               ; cos θ = -h/m^3 (0/0 only when m = 0)
+    maxsd xmm3, [rel const_neg_one]    ; clamp to [-1, 1], NaN -> -1
+    minsd xmm3, [rel const_one]
+
+    ; seed c0 = 1/2 + 1/2 sqrt((1 + cos θ)/2), exact at both ends
+    movsd xmm4, xmm3
+    addsd xmm4, [rel const_one]
+    mulsd xmm4, [rel const_half]
+    sqrtsd xmm4, xmm4
+    mulsd xmm4, [rel const_half]
+    addsd xmm4, [rel const_half]
+
+    ; 4 Newton steps on g(c) = 4c^3 - 3c - cos θ (step skipped where g' = 0)
+    mov ecx, 4
+.newton:
+    movsd xmm8, xmm4
+    mulsd xmm8, xmm4               ; c^2
+    movsd xmm9, xmm8
+    mulsd xmm9, [rel const_four]
+    subsd xmm9, [rel const_three]
+    mulsd xmm9, xmm4
+    subsd xmm9, xmm3               ; g
+    mulsd xmm8, [rel const_twelve]
+    subsd xmm8, [rel const_three]  ; g'
+    movsd xmm12, xmm8
+    cmpneqsd xmm12, xmm15
+    divsd xmm9, xmm8
+    andpd xmm9, xmm12
+    subsd xmm4, xmm9
+    dec ecx
+    jnz .newton
+
+    movsd xmm8, xmm4
+    mulsd xmm8, xmm4
+    movsd xmm9, [rel const_one]
+    subsd xmm9, xmm8
+    maxsd xmm9, xmm15
+    sqrtsd xmm9, xmm9
+    mulsd xmm9, [rel const_sqrt3]  ; √3 sqrt(1 - c^2)
+
+    movsd xmm12, xmm1
+    addsd xmm12, xmm12
+    mulsd xmm12, xmm4              ; t1 = 2mc
+    movsd xmm13, xmm9
+    subsd xmm13, xmm4
+    mulsd xmm13, xmm1              ; t2 = m(-c + √3 sqrt(1 - c^2))
+    addsd xmm9, xmm4
+    mulsd xmm9, xmm1
+    xorpd xmm9, [rel mask_sign]    ; t3 = m(-c - √3 sqrt(1 - c^2))
+
+    addsd xmm12, xmm5
+    addsd xmm13, xmm5
+    addsd xmm9, xmm5
+    movsd [rdi], xmm12
+    movsd [rdi+8], xmm13
+    movsd [rdi+16], xmm9
+    movsd [rsi], xmm15
+    movsd [rsi+8], xmm15
+    movsd [rsi+16], xmm15
+    PHASE_END 0, 6
+    mov eax, 3
+    ret
+
+;--------------------------------------------------------------------------
+; cubic_depressed_max_root: largest real root of z^3 + Pz + Q = 0
+; In: xmm0 = P, xmm1 = Q. Out: xmm0. Clobbers xmm1-xmm4, rax, rcx, rdx;
+; every other register is preserved, so assembly callers (the quartic's
+; Ferrari resolvent) can call it mid-pipeline without spilling. Also a
+; plain C function: double cubic_depressed_max_root(double P, double Q).
+;   h = Q/2, k = P/3, disc = h^2 + k^3
+;   disc > 0  : the only real root, Cardano u + v
+;   disc <= 0 : 2√(-k) cos(θ/3), cos(θ/3) by Newton on 4c^3 - 3c = cos θ
+;--------------------------------------------------------------------------
+cubic_depressed_max_root:
+    mulsd xmm0, [rel const_third]   ; k
+    mulsd xmm1, [rel const_half]    ; h
+    movsd xmm2, xmm0
+    mulsd xmm2, xmm0
+    mulsd xmm2, xmm0                ; k^3
+    movsd xmm3, xmm1
+    mulsd xmm3, xmm1
+    addsd xmm2, xmm3                ; disc
+    xorpd xmm3, xmm3
+    ucomisd xmm2, xmm3
+    jbe .three_real
+
+    sqrtsd xmm2, xmm2
+    movapd xmm3, xmm1
+    andpd xmm3, [rel mask_sign]
+    orpd xmm2, xmm3
+    addsd xmm2, xmm1
+    xorpd xmm2, [rel mask_sign]     ; u^3 = -(h + sign(h)√disc)
+    movq rdx, xmm0                  ; k survives fast_cbrt in rdx
+    movapd xmm0, xmm2
+    call fast_cbrt                  ; u
+    movq xmm1, rdx
+    divsd xmm1, xmm0
+    xorpd xmm1, [rel mask_sign]     ; v = -k/u
+    addsd xmm0, xmm1                ; u + v
+    ret
+
+.three_real:
+    xorpd xmm0, [rel mask_sign]
+    maxsd xmm0, xmm3
+    sqrtsd xmm2, xmm0               ; m = √(-k)
+    movsd xmm0, xmm2
+    mulsd xmm0, xmm2
+    mulsd xmm0, xmm2                ; m^3
+    movapd xmm4, xmm1
+    xorpd xmm4, [rel mask_sign]
+    divsd xmm4, xmm0                ; cos θ = -h/m^3
+    maxsd xmm4, [rel const_neg_one] ; clamp to [-1, 1], NaN -> -1
+    minsd xmm4, [rel const_one]
+
+    movsd xmm0, xmm4                ; c0 = 1/2 + 1/2 √((1 + cos θ)/2)
+    addsd xmm0, [rel const_one]
+    mulsd xmm0, [rel const_half]
+    sqrtsd xmm0, xmm0
+    mulsd xmm0, [rel const_half]
+    addsd xmm0, [rel const_half]
+
+    mov ecx, 4
+.newton:
+    movsd xmm1, xmm0
+    mulsd xmm1, xmm0                ; c^2
+    movsd xmm3, xmm1
+    mulsd xmm3, [rel const_four]
+    subsd xmm3, [rel const_three]
+    mulsd xmm3, xmm0
+    subsd xmm3, xmm4                ; g = 4c^3 - 3c - cos θ
+    mulsd xmm1, [rel const_twelve]
+    subsd xmm1, [rel const_three]   ; g'
+    ucomisd xmm1, [rel const_zero]
+    je .newton_done                 ; c = 1/2 exactly: double root
+    divsd xmm3, xmm1
+    subsd xmm0, xmm3
+    dec ecx
+    jnz .newton
+.newton_done:
+    mulsd xmm0, xmm2
+    addsd xmm0, xmm0                ; 2mc
+    ret
+
+;--------------------------------------------------------------------------
+; fast_cbrt: xmm0 = w -> xmm0 = cbrt(w)
+; Seed from the exponent bits (high word / 3 + bias), then three Halley
+; steps y <- y (y^3 + 2x) / (2y^3 + x), cubically convergent, so the ~3%
+; seed is at full double precision. Clobbers xmm1-xmm4, rax, rcx.
+;--------------------------------------------------------------------------
+fast_cbrt:
+    movapd xmm1, xmm0
+    andpd xmm1, [rel mask_abs]     ; x = |w|
+    xorpd xmm3, xmm3
+    ucomisd xmm1, xmm3
+    je .done                       ; cbrt(±0) = ±0, NaN passes through
+    andpd xmm0, [rel mask_sign]    ; keep only the sign of w
+
+    movq rax, xmm1
+    shr rax, 32
+    mov ecx, 0xAAAAAAAB
+    imul rax, rcx
+    shr rax, 33                    ; high word / 3
+    add eax, 0x2A9F7893            ; re-bias the exponent
+    shl rax, 32
+    movq xmm2, rax                 ; y0
+
+    mov ecx, 3
+.halley:
+    movsd xmm3, xmm2
+    mulsd xmm3, xmm2
+    mulsd xmm3, xmm2               ; y^3
+    movsd xmm4, xmm3
+    addsd xmm4, xmm1
+    addsd xmm4, xmm1               ; y^3 + 2x
+    addsd xmm3, xmm3
+    addsd xmm3, xmm1               ; 2y^3 + x
+    mulsd xmm2, xmm4
+    divsd xmm2, xmm3
+    dec ecx
+    jnz .halley
+
+    orpd xmm0, xmm2                ; copysign(y, w)
+.done:
+    ret
+
+%ifdef DSKYPOLY_PROFILE
+cardano_text_end:
+%endif
@@ -0,0 +1,647 @@
+;**************************************************************************
+; solve_poly_3_batch.asm
+; Batched cubic solver for n independent ax^3 + bx^2 + cx + d = 0 problems
+; Structure-of-arrays inputs/outputs, packed SSE2 / AVX2 / AVX-512 kernels
+; The public solve_poly_3_batch symbol lives in dskypoly_dispatch.c and
+; jumps to one of these according to the host CPU.
+;
+; C prototype (all three variants):
+;   void solve_poly_3_batch_<isa>(const double* a, const double* b,
+;                                 const double* c, const double* d,
+;                                 size_t n, double* re, double* im);
+;
+; re and im each hold 3n doubles as three planes of n: root k of cubic i
+; is re[k*n + i] + i*im[k*n + i]. a[i] must be non-zero.
+;
+; Every lane runs the solve_poly_3 program (see solve_poly_3.asm) with no
+; branches: both the Cardano and the three-real-roots paths are evaluated
+; and the lane mask disc > 0 picks one, so results match the scalar solver
+; bit for bit and mixed batches run at full vector width.
+;**************************************************************************
+
+section .rodata
+    ; 32-byte rows so AVX2 can use them as memory operands; SSE2 reads the
+    ; first 16 bytes and AVX-512 broadcasts the first element
+    align 32
+    pd_one          dq 1.0, 1.0, 1.0, 1.0
+    pd_neg_one      dq -1.0, -1.0, -1.0, -1.0
+    pd_three        dq 3.0, 3.0, 3.0, 3.0
+    pd_four         dq 4.0, 4.0, 4.0, 4.0
+    pd_twelve       dq 12.0, 12.0, 12.0, 12.0
+    pd_half         dq 0.5, 0.5, 0.5, 0.5
+    pd_neg_half     dq -0.5, -0.5, -0.5, -0.5
+    pd_third        dq 0.33333333333333333, 0.33333333333333333, 0.33333333333333333, 0.33333333333333333
+    pd_neg_third    dq -0.33333333333333333, -0.33333333333333333, -0.33333333333333333, -0.33333333333333333
+    pd_sqrt3        dq 1.7320508075688772, 1.7320508075688772, 1.7320508075688772, 1.7320508075688772
+    pd_half_sqrt3   dq 0.8660254037844386, 0.8660254037844386, 0.8660254037844386, 0.8660254037844386
+    pd_abs          dq 0x7FFFFFFFFFFFFFFF, 0x7FFFFFFFFFFFFFFF, 0x7FFFFFFFFFFFFFFF, 0x7FFFFFFFFFFFFFFF
+    pd_sign         dq 0x8000000000000000, 0x8000000000000000, 0x8000000000000000, 0x8000000000000000
+    ; cube-root seed: (high word * 0xAAAAAAAB) >> 33 = high word / 3
+    pq_div3         dq 0xAAAAAAAB, 0xAAAAAAAB, 0xAAAAAAAB, 0xAAAAAAAB
+    pq_cbrt_bias    dq 0x2A9F7893, 0x2A9F7893, 0x2A9F7893, 0x2A9F7893
+
+section .text
+    global solve_poly_3_batch_sse2
+    global solve_poly_3_batch_avx2
+    global solve_poly_3_batch_avx512
+
+; Arguments (System V AMD64):
+; rdi = a[], rsi = b[], rdx = c[], rcx = d[], r8 = n
+; r9  = re[], [rsp+8] = im[]
+;
+; Shared register plan for all three kernels:
+; rax = byte offset of the current element, r8 = elements remaining
+; r9/r10/r11 = re planes 0/1/2, rbx/r12/r13 = im planes 0/1/2
+; r14 = Halley/Newton iteration counter
+
+;--------------------------------------------------------------------------
+; SSE2 kernel: 2 cubics per instruction (baseline x86-64)
+;--------------------------------------------------------------------------
+solve_poly_3_batch_sse2:
+    mov rax, [rsp+8]               ; im[]
+    push rbx
+    push r12
+    push r13
+    push r14
+    lea r10, [r9+r8*8]             ; re plane 1
+    lea r11, [r10+r8*8]            ; re plane 2
+    mov rbx, rax                   ; im plane 0
+    lea r12, [rbx+r8*8]            ; im plane 1
+    lea r13, [r12+r8*8]            ; im plane 2
+    xor eax, eax                   ; offset = 0
+
+    ; Wider kernels finish their ragged tail here with the plan above set
+.resume:
+    xorpd xmm15, xmm15             ; 0.0 | 0.0
+
+.pair_loop:
+    cmp r8, 2
+    jb .tail
+
+    movupd xmm0, [rdi+rax]         ; a
+    movupd xmm1, [rsi+rax]         ; b
+    movupd xmm2, [rdx+rax]         ; c
+    movupd xmm3, [rcx+rax]         ; d
+
+.lanes:
+    ; === Monic, depressed cubic t^3 + pt + q, h = q/2, k = p/3 ===
+    movapd xmm4, [rel pd_one]
+    divpd xmm4, xmm0               ; 1/a
+    mulpd xmm1, xmm4               ; B
+    mulpd xmm2, xmm4               ; C
+    mulpd xmm3, xmm4               ; D
+    movapd xmm5, xmm1
+    mulpd xmm5, [rel pd_neg_third] ; s = -B/3
+    movapd xmm6, xmm5
+    mulpd xmm6, [rel pd_three]
+    addpd xmm6, xmm1
+    addpd xmm6, xmm1
+    mulpd xmm6, xmm5
+    addpd xmm6, xmm2               ; p
+    movapd xmm7, xmm5
+    addpd xmm7, xmm1
+    mulpd xmm7, xmm5
+    addpd xmm7, xmm2
+    mulpd xmm7, xmm5
+    addpd xmm7, xmm3               ; q
+    mulpd xmm7, [rel pd_half]      ; h
+    mulpd xmm6, [rel pd_third]     ; k
+
+    movapd xmm8, xmm6
+    mulpd xmm8, xmm6
+    mulpd xmm8, xmm6               ; k^3
+    movapd xmm9, xmm7
+    mulpd xmm9, xmm7               ; h^2
+    addpd xmm8, xmm9               ; disc
+    movapd xmm14, xmm15
+    cmpltpd xmm14, xmm8            ; one = (disc > 0): Cardano lanes
+
+    ; === Cardano: u = cbrt(-(h + sign(h) sqrt(disc))), v = -k/u ===
+    maxpd xmm8, xmm15
+    sqrtpd xmm8, xmm8
+    movapd xmm9, xmm7
+    andpd xmm9, [rel pd_sign]
+    orpd xmm8, xmm9
+    addpd xmm8, xmm7
+    xorpd xmm8, [rel pd_sign]      ; w = u^3
+
+    movapd xmm1, xmm8
+    andpd xmm1, [rel pd_abs]       ; x = |w|
+    movapd xmm0, xmm1
+    psrlq xmm0, 32
+    pmuludq xmm0, [rel pq_div3]
+    psrlq xmm0, 33
+    paddq xmm0, [rel pq_cbrt_bias]
+    psllq xmm0, 32                 ; y0
+
+    mov r14d, 3
+.halley:
+    movapd xmm2, xmm0
+    mulpd xmm2, xmm0
+    mulpd xmm2, xmm0               ; y^3
+    movapd xmm3, xmm2
+    addpd xmm3, xmm1
+    addpd xmm3, xmm1               ; y^3 + 2x
+    addpd xmm2, xmm2
+    addpd xmm2, xmm1               ; 2y^3 + x
+    mulpd xmm0, xmm3
+    divpd xmm0, xmm2
+    dec r14d
+    jnz .halley
+
+    cmpneqpd xmm1, xmm15
+    andpd xmm0, xmm1               ; cbrt(0) = 0
+    andpd xmm8, [rel pd_sign]
+    orpd xmm0, xmm8                ; u
+
+    movapd xmm9, xmm6
+    divpd xmm9, xmm0
+    xorpd xmm9, [rel pd_sign]      ; v
+    movapd xmm10, xmm0
+    addpd xmm10, xmm9              ; t1 = u + v
+    subpd xmm0, xmm9
+    andpd xmm0, [rel pd_abs]
+    mulpd xmm0, [rel pd_half_sqrt3]    ; pair imag
+    movapd xmm11, xmm10
+    mulpd xmm11, [rel pd_neg_half]     ; pair real
+
+    ; === Three real roots: cos(θ/3) from 4c^3 - 3c = cos θ by Newton ===
+    movapd xmm1, xmm6
+    xorpd xmm1, [rel pd_sign]
+    maxpd xmm1, xmm15
+    sqrtpd xmm1, xmm1              ; m = sqrt(-k)
+    movapd xmm2, xmm1
+    mulpd xmm2, xmm1
+    mulpd xmm2, xmm1               ; m^3
+    movapd xmm3, xmm7
+    xorpd xmm3, [rel pd_sign]
+    divpd xmm3, xmm2               ; cos θ
+    maxpd xmm3, [rel pd_neg_one]
+    minpd xmm3, [rel pd_one]
+    movapd xmm4, xmm3
+    addpd xmm4, [rel pd_one]
+    mulpd xmm4, [rel pd_half]
+    sqrtpd xmm4, xmm4
+    mulpd xmm4, [rel pd_half]
+    addpd xmm4, [rel pd_half]      ; c0
+
+    mov r14d, 4
+.newton:
+    movapd xmm8, xmm4
+    mulpd xmm8, xmm4               ; c^2
+    movapd xmm9, xmm8
+    mulpd xmm9, [rel pd_four]
+    subpd xmm9, [rel pd_three]
+    mulpd xmm9, xmm4
+    subpd xmm9, xmm3               ; g
+    mulpd xmm8, [rel pd_twelve]
+    subpd xmm8, [rel pd_three]     ; g'
+    movapd xmm12, xmm8
+    cmpneqpd xmm12, xmm15
+    divpd xmm9, xmm8
+    andpd xmm9, xmm12              ; no step where g' = 0
+    subpd xmm4, xmm9
+    dec r14d
+    jnz .newton
+
+    movapd xmm8, xmm4
+    mulpd xmm8, xmm4
+    movapd xmm9, [rel pd_one]
+    subpd xmm9, xmm8
+    maxpd xmm9, xmm15
+    sqrtpd xmm9, xmm9
+    mulpd xmm9, [rel pd_sqrt3]     ; √3 sqrt(1 - c^2)
+    movapd xmm12, xmm1
+    addpd xmm12, xmm12
+    mulpd xmm12, xmm4              ; t1 = 2mc
+    movapd xmm13, xmm9
+    subpd xmm13, xmm4
+    mulpd xmm13, xmm1              ; t2
+    addpd xmm9, xmm4
+    mulpd xmm9, xmm1
+    xorpd xmm9, [rel pd_sign]      ; t3
+
+    ; === Select per lane, undo the shift ===
+    andpd xmm10, xmm14
+    movapd xmm2, xmm14
+    andnpd xmm2, xmm12
+    orpd xmm10, xmm2
+    addpd xmm10, xmm5              ; root 1
+    andpd xmm11, xmm14
+    movapd xmm3, xmm14
+    andnpd xmm3, xmm13
+    orpd xmm3, xmm11
+    addpd xmm3, xmm5               ; root 2
+    movapd xmm4, xmm14
+    andnpd xmm4, xmm9
+    orpd xmm4, xmm11
+    addpd xmm4, xmm5               ; root 3
+    andpd xmm0, xmm14              ; root 2 imag (+0 on real lanes)
+    movapd xmm1, xmm0
+    xorpd xmm1, [rel pd_sign]
+    andpd xmm1, xmm14              ; root 3 imag
+
+    cmp r8, 2
+    jb .store_low
+
+    movupd [r9+rax], xmm10
+    movupd [r10+rax], xmm3
+    movupd [r11+rax], xmm4
+    movupd [rbx+rax], xmm15
+    movupd [r12+rax], xmm0
+    movupd [r13+rax], xmm1
+
+    add rax, 16
+    sub r8, 2
+    jmp .pair_loop
+
+.tail:
+    ; === Last odd cubic: same lane program, low element only ===
+    test r8, r8
+    jz .done
+
+    movsd xmm0, [rdi+rax]          ; a
+    movsd xmm1, [rsi+rax]          ; b
+    movsd xmm2, [rdx+rax]          ; c
+    movsd xmm3, [rcx+rax]          ; d
+    jmp .lanes
+
+.store_low:
+    movsd [r9+rax], xmm10
+    movsd [r10+rax], xmm3
+    movsd [r11+rax], xmm4
+    movsd [rbx+rax], xmm15
+    movsd [r12+rax], xmm0
+    movsd [r13+rax], xmm1
+
+.done:
+    pop r14
+    pop r13
+    pop r12
+    pop rbx
+    ret
+
+;--------------------------------------------------------------------------
+; AVX2 kernel: 4 cubics per instruction
+; No FMA contraction, so every lane rounds exactly like the SSE2 kernel
+;--------------------------------------------------------------------------
+solve_poly_3_batch_avx2:
+    mov rax, [rsp+8]               ; im[]
+    push rbx
+    push r12
+    push r13
+    push r14
+    lea r10, [r9+r8*8]
+    lea r11, [r10+r8*8]
+    mov rbx, rax
+    lea r12, [rbx+r8*8]
+    lea r13, [r12+r8*8]
+    xor eax, eax
+
+    vxorpd ymm15, ymm15, ymm15
+
+.quad_loop:
+    cmp r8, 4
+    jb .tail
+
+    vmovupd ymm0, [rdi+rax]        ; a
+    vmovupd ymm1, [rsi+rax]        ; b
+    vmovupd ymm2, [rdx+rax]        ; c
+    vmovupd ymm3, [rcx+rax]        ; d
+
+    vmovapd ymm4, [rel pd_one]
+    vdivpd ymm4, ymm4, ymm0        ; 1/a
+    vmulpd ymm1, ymm1, ymm4        ; B
+    vmulpd ymm2, ymm2, ymm4        ; C
+    vmulpd ymm3, ymm3, ymm4        ; D
+    vmulpd ymm5, ymm1, [rel pd_neg_third]  ; s
+    vmulpd ymm6, ymm5, [rel pd_three]
+    vaddpd ymm6, ymm6, ymm1
+    vaddpd ymm6, ymm6, ymm1
+    vmulpd ymm6, ymm6, ymm5
+    vaddpd ymm6, ymm6, ymm2        ; p
+    vaddpd ymm7, ymm5, ymm1
+    vmulpd ymm7, ymm7, ymm5
+    vaddpd ymm7, ymm7, ymm2
+    vmulpd ymm7, ymm7, ymm5
+    vaddpd ymm7, ymm7, ymm3        ; q
+    vmulpd ymm7, ymm7, [rel pd_half]   ; h
+    vmulpd ymm6, ymm6, [rel pd_third]  ; k
+
+    vmulpd ymm8, ymm6, ymm6
+    vmulpd ymm8, ymm8, ymm6        ; k^3
+    vmulpd ymm9, ymm7, ymm7        ; h^2
+    vaddpd ymm8, ymm8, ymm9        ; disc
+    vcmpltpd ymm14, ymm15, ymm8    ; one = (disc > 0)
+
+    ; === Cardano ===
+    vmaxpd ymm8, ymm8, ymm15
+    vsqrtpd ymm8, ymm8
+    vandpd ymm9, ymm7, [rel pd_sign]
+    vorpd ymm8, ymm8, ymm9
+    vaddpd ymm8, ymm8, ymm7
+    vxorpd ymm8, ymm8, [rel pd_sign]   ; w
+
+    vandpd ymm1, ymm8, [rel pd_abs]    ; x
+    vpsrlq ymm0, ymm1, 32
+    vpmuludq ymm0, ymm0, [rel pq_div3]
+    vpsrlq ymm0, ymm0, 33
+    vpaddq ymm0, ymm0, [rel pq_cbrt_bias]
+    vpsllq ymm0, ymm0, 32          ; y0
+
+    mov r14d, 3
+.halley:
+    vmulpd ymm2, ymm0, ymm0
+    vmulpd ymm2, ymm2, ymm0        ; y^3
+    vaddpd ymm3, ymm2, ymm1
+    vaddpd ymm3, ymm3, ymm1        ; y^3 + 2x
+    vaddpd ymm2, ymm2, ymm2
+    vaddpd ymm2, ymm2, ymm1        ; 2y^3 + x
+    vmulpd ymm0, ymm0, ymm3
+    vdivpd ymm0, ymm0, ymm2
+    dec r14d
+    jnz .halley
+
+    vcmpneqpd ymm1, ymm1, ymm15
+    vandpd ymm0, ymm0, ymm1        ; cbrt(0) = 0
+    vandpd ymm8, ymm8, [rel pd_sign]
+    vorpd ymm0, ymm0, ymm8         ; u
+
+    vdivpd ymm9, ymm6, ymm0
+    vxorpd ymm9, ymm9, [rel pd_sign]   ; v
+    vaddpd ymm10, ymm0, ymm9       ; t1
+    vsubpd ymm0, ymm0, ymm9
+    vandpd ymm0, ymm0, [rel pd_abs]
+    vmulpd ymm0, ymm0, [rel pd_half_sqrt3]  ; pair imag
+    vmulpd ymm11, ymm10, [rel pd_neg_half]  ; pair real
+
+    ; === Three real roots ===
+    vxorpd ymm1, ymm6, [rel pd_sign]
+    vmaxpd ymm1, ymm1, ymm15
+    vsqrtpd ymm1, ymm1             ; m
+    vmulpd ymm2, ymm1, ymm1
+    vmulpd ymm2, ymm2, ymm1        ; m^3
+    vxorpd ymm3, ymm7, [rel pd_sign]
+    vdivpd ymm3, ymm3, ymm2        ; cos θ
+    vmaxpd ymm3, ymm3, [rel pd_neg_one]
+    vminpd ymm3, ymm3, [rel pd_one]
+    vaddpd ymm4, ymm3, [rel pd_one]
+    vmulpd ymm4, ymm4, [rel pd_half]
+    vsqrtpd ymm4, ymm4
+    vmulpd ymm4, ymm4, [rel pd_half]
+    vaddpd ymm4, ymm4, [rel pd_half]   ; c0
+
+    mov r14d, 4
+.newton:
+    vmulpd ymm8, ymm4, ymm4        ; c^2
+    vmulpd ymm9, ymm8, [rel pd_four]
+    vsubpd ymm9, ymm9, [rel pd_three]
+    vmulpd ymm9, ymm9, ymm4
+    vsubpd ymm9, ymm9, ymm3        ; g
+    vmulpd ymm8, ymm8, [rel pd_twelve]
+    vsubpd ymm8, ymm8, [rel pd_three]  ; g'
+    vcmpneqpd ymm12, ymm8, ymm15
+    vdivpd ymm9, ymm9, ymm8
+    vandpd ymm9, ymm9, ymm12
+    vsubpd ymm4, ymm4, ymm9
+    dec r14d
+    jnz .newton
+
+    vmulpd ymm8, ymm4, ymm4
+    vmovapd ymm9, [rel pd_one]
+    vsubpd ymm9, ymm9, ymm8
+    vmaxpd ymm9, ymm9, ymm15
+    vsqrtpd ymm9, ymm9
+    vmulpd ymm9, ymm9, [rel pd_sqrt3]
+    vaddpd ymm12, ymm1, ymm1
+    vmulpd ymm12, ymm12, ymm4      ; t1
+    vsubpd ymm13, ymm9, ymm4
+    vmulpd ymm13, ymm13, ymm1      ; t2
+    vaddpd ymm9, ymm9, ymm4
+    vmulpd ymm9, ymm9, ymm1
+    vxorpd ymm9, ymm9, [rel pd_sign]   ; t3
+
+    ; === Select per lane, undo the shift ===
+    vblendvpd ymm12, ymm12, ymm10, ymm14
+    vblendvpd ymm13, ymm13, ymm11, ymm14
+    vblendvpd ymm9, ymm9, ymm11, ymm14
+    vaddpd ymm12, ymm12, ymm5
+    vaddpd ymm13, ymm13, ymm5
+    vaddpd ymm9, ymm9, ymm5
+    vandpd ymm0, ymm0, ymm14
+    vxorpd ymm1, ymm0, [rel pd_sign]
+    vandpd ymm1, ymm1, ymm14
+
+    vmovupd [r9+rax], ymm12
+    vmovupd [r10+rax], ymm13
+    vmovupd [r11+rax], ymm9
+    vmovupd [rbx+rax], ymm15
+    vmovupd [r12+rax], ymm0
+    vmovupd [r13+rax], ymm1
+
+    add rax, 32
+    sub r8, 4
+    jmp .quad_loop
+
+.tail:
+    ; Leave the 256-bit state before running legacy-SSE code
+    vzeroupper
+    jmp solve_poly_3_batch_sse2.resume
+
+;--------------------------------------------------------------------------
+; AVX-512 kernel: 8 cubics per instruction, masked tail (AVX512F only)
+; The lane constants live in zmm16-zmm30 for the whole call
+;--------------------------------------------------------------------------
+solve_poly_3_batch_avx512:
+    mov rax, [rsp+8]               ; im[]
+    push rbx
+    push r12
+    push r13
+    push r14
+    lea r10, [r9+r8*8]
+    lea r11, [r10+r8*8]
+    mov rbx, rax
+    lea r12, [rbx+r8*8]
+    lea r13, [r12+r8*8]
+    xor eax, eax
+
+    vbroadcastsd zmm16, [rel pd_one]
+    vbroadcastsd zmm17, [rel pd_neg_one]
+    vbroadcastsd zmm18, [rel pd_three]
+    vbroadcastsd zmm19, [rel pd_four]
+    vbroadcastsd zmm20, [rel pd_twelve]
+    vbroadcastsd zmm21, [rel pd_half]
+    vbroadcastsd zmm22, [rel pd_neg_half]
+    vbroadcastsd zmm23, [rel pd_third]
+    vbroadcastsd zmm24, [rel pd_neg_third]
+    vbroadcastsd zmm25, [rel pd_sqrt3]
+    vbroadcastsd zmm26, [rel pd_half_sqrt3]
+    vbroadcastsd zmm27, [rel pd_abs]
+    vbroadcastsd zmm28, [rel pd_sign]
+    vbroadcastsd zmm29, [rel pq_div3]
+    vbroadcastsd zmm30, [rel pq_cbrt_bias]
+    vpxorq zmm15, zmm15, zmm15
+    kxnorw k2, k2, k2              ; all lanes active
+
+.oct_loop:
+    cmp r8, 8
+    jb .tail
+
+.body:
+    vmovupd zmm0{k2}{z}, [rdi+rax] ; a
+    vmovupd zmm1{k2}{z}, [rsi+rax] ; b
+    vmovupd zmm2{k2}{z}, [rdx+rax] ; c
+    vmovupd zmm3{k2}{z}, [rcx+rax] ; d
+
+    vdivpd zmm4, zmm16, zmm0       ; 1/a
+    vmulpd zmm1, zmm1, zmm4        ; B
+    vmulpd zmm2, zmm2, zmm4        ; C
+    vmulpd zmm3, zmm3, zmm4        ; D
+    vmulpd zmm5, zmm1, zmm24       ; s
+    vmulpd zmm6, zmm5, zmm18
+    vaddpd zmm6, zmm6, zmm1
+    vaddpd zmm6, zmm6, zmm1
+    vmulpd zmm6, zmm6, zmm5
+    vaddpd zmm6, zmm6, zmm2        ; p
+    vaddpd zmm7, zmm5, zmm1
+    vmulpd zmm7, zmm7, zmm5
+    vaddpd zmm7, zmm7, zmm2
+    vmulpd zmm7, zmm7, zmm5
+    vaddpd zmm7, zmm7, zmm3        ; q
+    vmulpd zmm7, zmm7, zmm21       ; h
+    vmulpd zmm6, zmm6, zmm23       ; k
+
+    vmulpd zmm8, zmm6, zmm6
+    vmulpd zmm8, zmm8, zmm6        ; k^3
+    vmulpd zmm9, zmm7, zmm7        ; h^2
+    vaddpd zmm8, zmm8, zmm9        ; disc
+    vcmppd k1, zmm15, zmm8, 1      ; one = (disc > 0)
+
+    ; === Cardano ===
+    vmaxpd zmm8, zmm8, zmm15
+    vsqrtpd zmm8, zmm8
+    vpandq zmm9, zmm7, zmm28
+    vporq zmm8, zmm8, zmm9
+    vaddpd zmm8, zmm8, zmm7
+    vpxorq zmm8, zmm8, zmm28       ; w
+
+    vpandq zmm1, zmm8, zmm27       ; x
+    vpsrlq zmm0, zmm1, 32
+    vpmuludq zmm0, zmm0, zmm29
+    vpsrlq zmm0, zmm0, 33
+    vpaddq zmm0, zmm0, zmm30
+    vpsllq zmm0, zmm0, 32          ; y0
+
+    mov r14d, 3
+.halley:
+    vmulpd zmm2, zmm0, zmm0
+    vmulpd zmm2, zmm2, zmm0        ; y^3
+    vaddpd zmm3, zmm2, zmm1
+    vaddpd zmm3, zmm3, zmm1        ; y^3 + 2x
+    vaddpd zmm2, zmm2, zmm2
+    vaddpd zmm2, zmm2, zmm1        ; 2y^3 + x
+    vmulpd zmm0, zmm0, zmm3
+    vdivpd zmm0, zmm0, zmm2
+    dec r14d
+    jnz .halley
+
+    vcmppd k3, zmm1, zmm15, 4      ; x != 0
+    vmovapd zmm0{k3}{z}, zmm0      ; cbrt(0) = 0
+    vpandq zmm8, zmm8, zmm28
+    vporq zmm0, zmm0, zmm8         ; u
+
+    vdivpd zmm9, zmm6, zmm0
+    vpxorq zmm9, zmm9, zmm28       ; v
+    vaddpd zmm10, zmm0, zmm9       ; t1
+    vsubpd zmm0, zmm0, zmm9
+    vpandq zmm0, zmm0, zmm27
+    vmulpd zmm0, zmm0, zmm26       ; pair imag
+    vmulpd zmm11, zmm10, zmm22     ; pair real
+
+    ; === Three real roots ===
+    vpxorq zmm1, zmm6, zmm28
+    vmaxpd zmm1, zmm1, zmm15
+    vsqrtpd zmm1, zmm1             ; m
+    vmulpd zmm2, zmm1, zmm1
+    vmulpd zmm2, zmm2, zmm1        ; m^3
+    vpxorq zmm3, zmm7, zmm28
+    vdivpd zmm3, zmm3, zmm2        ; cos θ
+    vmaxpd zmm3, zmm3, zmm17
+    vminpd zmm3, zmm3, zmm16
+    vaddpd zmm4, zmm3, zmm16
+    vmulpd zmm4, zmm4, zmm21
+    vsqrtpd zmm4, zmm4
+    vmulpd zmm4, zmm4, zmm21
+    vaddpd zmm4, zmm4, zmm21       ; c0
+
+    mov r14d, 4
+.newton:
+    vmulpd zmm8, zmm4, zmm4        ; c^2
+    vmulpd zmm9, zmm8, zmm19
+    vsubpd zmm9, zmm9, zmm18
+    vmulpd zmm9, zmm9, zmm4
+    vsubpd zmm9, zmm9, zmm3        ; g
+    vmulpd zmm8, zmm8, zmm20
+    vsubpd zmm8, zmm8, zmm18       ; g'
+    vcmppd k4, zmm8, zmm15, 4      ; g' != 0
+    vdivpd zmm9{k4}{z}, zmm9, zmm8
+    vsubpd zmm4, zmm4, zmm9
+    dec r14d
+    jnz .newton
+
+    vmulpd zmm8, zmm4, zmm4
+    vsubpd zmm9, zmm16, zmm8
+    vmaxpd zmm9, zmm9, zmm15
+    vsqrtpd zmm9, zmm9
+    vmulpd zmm9, zmm9, zmm25
+    vaddpd zmm12, zmm1, zmm1
+    vmulpd zmm12, zmm12, zmm4      ; t1
+    vsubpd zmm13, zmm9, zmm4
+    vmulpd zmm13, zmm13, zmm1      ; t2
+    vaddpd zmm9, zmm9, zmm4
+    vmulpd zmm9, zmm9, zmm1
+    vpxorq zmm9, zmm9, zmm28       ; t3
+
+    ; === Select per lane, undo the shift ===
+    vmovapd zmm12{k1}, zmm10
+    vmovapd zmm13{k1}, zmm11
+    vmovapd zmm9{k1}, zmm11
+    vaddpd zmm12, zmm12, zmm5
+    vaddpd zmm13, zmm13, zmm5
+    vaddpd zmm9, zmm9, zmm5
+    vmovapd zmm0{k1}{z}, zmm0          ; root 2 imag (+0 on real lanes)
+    vpxorq zmm1{k1}{z}, zmm0, zmm28    ; root 3 imag
+
+    vmovupd [r9+rax]{k2}, zmm12
+    vmovupd [r10+rax]{k2}, zmm13
+    vmovupd [r11+rax]{k2}, zmm9
+    vmovupd [rbx+rax]{k2}, zmm15
+    vmovupd [r12+rax]{k2}, zmm0
+    vmovupd [r13+rax]{k2}, zmm1
+
+    add rax, 64
+    sub r8, 8
+    ja .oct_loop                   ; more work left (r8 > 0 and no borrow)
+    jmp .done
+
+.tail:
+    ; === 1..7 leftover cubics: one masked pass ===
+    test r8, r8
+    jz .done
+    push rcx                       ; d[], cl is needed for the shift
+    mov ecx, r8d
+    mov r14d, 1
+    shl r14d, cl
+    dec r14d                       ; (1 << remaining) - 1
+    kmovw k2, r14d
+    pop rcx
+    mov r8d, 8                     ; makes the masked pass the last one
+    jmp .body
+
+.done:
+    vzeroupper
+    pop r14
+    pop r13
+    pop r12
+    pop rbx
+    ret
@@ -0,0 +1,709 @@
+/*
+ * dskypoly.h - C interface to the DSKYpoly assembly solvers
+ *
+ * Scalar entry points keep the original one-polynomial-per-call shape used
+ * by the DSKY interface. Batched entry points take structure-of-arrays
+ * inputs (one array per coefficient) and write structure-of-arrays outputs
+ * (one array per root component), so the assembly kernels can load several
+ * polynomials per vector register.
+ *
+ * This header is the whole interface of libdskypoly (make lib: a static
+ * archive and a shared object over the same objects). The library's C
+ * layer is compiled with -fvisibility=hidden, so what is declared here is
+ * exactly what it exports.
+ */
+
+#ifndef DSKYPOLY_H
+#define DSKYPOLY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(__GNUC__)
+#pragma GCC visibility push(default)
+#endif
+
+// === Quadratic: ax^2 + bx + c = 0 ===
+
+// One quadratic per call (scalar SSE2, src/solve_poly_2.asm). Real roots
+// come from q = -(b + sign(b) sqrt(D))/2 as q/a and c/q, so neither loses
+// digits to cancellation; r1 is the root the textbook (-b + sqrt(D))/2a
+// names, and complex roots are -b/2a ± i sqrt(-D)/2a with r1_imag of the
+// sign of 1/a.
+void solve_poly_2(double a, double b, double c,
+                  double* r1_real, double* r1_imag,
+                  double* r2_real, double* r2_imag);
+
+// The original x87 solver with the textbook formula
+// (src/solve_poly_2_reference.asm), same contract
+void solve_poly_2_reference(double a, double b, double c,
+                            double* r1_real, double* r1_imag,
+                            double* r2_real, double* r2_imag);
+
+// n quadratics per call, routed to the widest kernel the host supports
+// Element i of every output array holds the roots of a[i]x^2 + b[i]x + c[i].
+void solve_poly_2_batch(const double* a, const double* b, const double* c,
+                        size_t n,
+                        double* r1_real, double* r1_imag,
+                        double* r2_real, double* r2_imag);
+
+// Individual vector widths (src/solve_poly_2_batch.asm), same contract
+void solve_poly_2_batch_sse2(const double* a, const double* b, const double* c,
+                             size_t n,
+                             double* r1_real, double* r1_imag,
+                             double* r2_real, double* r2_imag);
+void solve_poly_2_batch_avx2(const double* a, const double* b, const double* c,
+                             size_t n,
+                             double* r1_real, double* r1_imag,
+                             double* r2_real, double* r2_imag);
+void solve_poly_2_batch_avx512(const double* a, const double* b, const double* c,
+                               size_t n,
+                               double* r1_real, double* r1_imag,
+                               double* r2_real, double* r2_imag);
+
+// === Cubic: ax^3 + bx^2 + cx + d = 0 ===
+
+// One cubic per call, no I/O (cubic/src/solve_poly_3.asm)
+// Writes all three roots, real roots first; returns 3, or 0 if a == 0.
+int solve_poly_3(double a, double b, double c, double d,
+                 double re[3], double im[3]);
+
+// Largest real root of the depressed cubic z^3 + Pz + Q = 0 (same file)
+// Register-only: clobbers xmm1-xmm4, rax, rcx, rdx and nothing else, so
+// the quartic's Ferrari pipeline calls it without spilling.
+double cubic_depressed_max_root(double P, double Q);
+
+// n cubics per call, routed to the widest kernel the host supports
+// re and im hold 3n doubles as three planes of n: root k of cubic i is
+// re[k*n + i] + i*im[k*n + i]. Every a[i] must be non-zero.
+void solve_poly_3_batch(const double* a, const double* b,
+                        const double* c, const double* d,
+                        size_t n, double* re, double* im);
+
+// Individual vector widths (cubic/src/solve_poly_3_batch.asm), same contract
+void solve_poly_3_batch_sse2(const double* a, const double* b,
+                             const double* c, const double* d,
+                             size_t n, double* re, double* im);
+void solve_poly_3_batch_avx2(const double* a, const double* b,
+                             const double* c, const double* d,
+                             size_t n, double* re, double* im);
+void solve_poly_3_batch_avx512(const double* a, const double* b,
+                               const double* c, const double* d,
+                               size_t n, double* re, double* im);
+
+// === Quartic: ax^4 + bx^3 + cx^2 + dx + e = 0 ===
+
+// One quartic per call by Ferrari's method, no I/O
+// (quartic/src/solve_poly_4_production.asm). Returns 4, or 0 if a == 0.
+int solve_poly_4_production(double a, double b, double c, double d, double e,
+                            double re[4], double im[4]);
+
+// Same solve with the step-by-step console walk-through
+// (quartic/src/solve_poly_4_trace.c)
+void solve_poly_4_production_trace(double a, double b, double c, double d, double e);
+
+// === Single precision batches, degrees 2-4 (src/dskypoly_f32.c) ===
+//
+// The quadratic, cubic and quartic programs in float lanes: twice the
+// polynomials per instruction of the double kernels. Each lane estimates
+// its own relative error (a Newton step at each root: the residual and the
+// rounding carried by the coefficients over the distances between roots);
+// lanes above tol, or with anything non-finite, are solved again in double
+// by solve_poly_2 / solve_poly_3_batch / solve_poly_4_production and
+// rounded to float. tol <= 0 means DSKYPOLY_F32_TOL. Every a[i] must be
+// non-zero. Each call returns the number of lanes it redid in double.
+#define DSKYPOLY_F32_TOL 1.0e-5f
+
+// Output layout of solve_poly_2_batch
+int solve_poly_2_batch_f32(const float* a, const float* b, const float* c, size_t n,
+                           float* r1_real, float* r1_imag,
+                           float* r2_real, float* r2_imag, float tol);
+
+// Root k of polynomial i at re/im[k*n + i], as solve_poly_3_batch (the
+// quartic has four planes)
+int solve_poly_3_batch_f32(const float* a, const float* b, const float* c, const float* d,
+                           size_t n, float* re, float* im, float tol);
+int solve_poly_4_batch_f32(const float* a, const float* b, const float* c, const float* d,
+                           const float* e, size_t n, float* re, float* im, float tol);
+
+// Individual vector widths: 4, 8 and 16 lanes, same contracts
+int solve_poly_2_batch_f32_sse2(const float* a, const float* b, const float* c, size_t n,
+                                float* r1_real, float* r1_imag,
+                                float* r2_real, float* r2_imag, float tol);
+int solve_poly_2_batch_f32_avx2(const float* a, const float* b, const float* c, size_t n,
+                                float* r1_real, float* r1_imag,
+                                float* r2_real, float* r2_imag, float tol);
+int solve_poly_2_batch_f32_avx512(const float* a, const float* b, const float* c, size_t n,
+                                  float* r1_real, float* r1_imag,
+                                  float* r2_real, float* r2_imag, float tol);
+int solve_poly_3_batch_f32_sse2(const float* a, const float* b, const float* c, const float* d,
+                                size_t n, float* re, float* im, float tol);
+int solve_poly_3_batch_f32_avx2(const float* a, const float* b, const float* c, const float* d,
+                                size_t n, float* re, float* im, float tol);
+int solve_poly_3_batch_f32_avx512(const float* a, const float* b, const float* c, const float* d,
+                                  size_t n, float* re, float* im, float tol);
+int solve_poly_4_batch_f32_sse2(const float* a, const float* b, const float* c, const float* d,
+                                const float* e, size_t n, float* re, float* im, float tol);
+int solve_poly_4_batch_f32_avx2(const float* a, const float* b, const float* c, const float* d,
+                                const float* e, size_t n, float* re, float* im, float tol);
+int solve_poly_4_batch_f32_avx512(const float* a, const float* b, const float* c, const float* d,
+                                  const float* e, size_t n, float* re, float* im, float tol);
+
+// === Quintic and general degree: Aberth-Ehrlich iteration ===
+
+// All n complex roots of coeffs[0] x^n + coeffs[1] x^(n-1) + ... + coeffs[n]
+// (quintic/src/solve_poly_5_numerical.asm), two roots per SSE2 update.
+// re and im receive n values each. Returns the number of roots that met
+// the backward-error stop test (n on success), or 0 if n < 1 or
+// coeffs[0] == 0; unconverged roots are still the best approximations.
+// The work planes live on the stack (about 32 bytes per degree), so n is
+// capped: above DSKYPOLY_ABERTH_MAX_DEGREE it returns -1 with
+// errno = EINVAL and re/im untouched.
+#define DSKYPOLY_ABERTH_MAX_DEGREE 1024
+int solve_poly_n_aberth(const double* coeffs, int n, double* re, double* im);
+
+// Same solve, also storing the number of sweeps it took in *sweeps
+// (0 when nothing was iterated, 100 when the sweep cap was hit)
+int solve_poly_n_aberth_sweeps(const double* coeffs, int n, double* re, double* im,
+                               int* sweeps);
+
+// Quintic shape of the same engine: ax^5 + bx^4 + cx^3 + dx^2 + ex + f = 0
+int solve_poly_5_numerical(double a, double b, double c, double d,
+                           double e, double f, double re[5], double im[5]);
+
+// Radical-solvable forms, silent and reentrant
+// (quintic/src/solve_poly_5_special.asm). *kind (if kind is non-NULL) gets
+// the detected DSKYPOLY_SPECIAL_* form, in which a coefficient is absent
+// only when it is exactly zero. Returns 5 with the roots in re/im
+// when the form was solved (monomial ax^5 + f), 0 otherwise.
+int solve_poly_5_special_r(double a, double b, double c, double d, double e, double f,
+                           double re[5], double im[5], int* kind);
+
+// Narrated walk-through of the same detection (same file): prints the form
+// and any roots, and counts the form in the solver statistics
+int solve_poly_5_special(double a, double b, double c, double d, double e, double f);
+
+// The monomial case of any degree: all n roots of a x^n + c = 0 (same
+// file), the magnitude from one real n-th root and the roots from a
+// twiddle table in one packed pass. Returns n, or 0 if a == 0 or n is
+// outside 1..DSKYPOLY_MONOMIAL_MAX_DEGREE.
+#define DSKYPOLY_MONOMIAL_MAX_DEGREE 8
+int solve_poly_n_monomial(double a, double c, int n, double* re, double* im);
+
+// === General degree in bulk: companion-matrix QR (src/dskypoly_companion.c) ===
+
+#define DSKYPOLY_COMPANION_MAX_DEGREE 16
+#define DSKYPOLY_COMPANION_LANES 8      // matrices per lockstep QR block
+
+// n polynomials of one degree as coefficient planes: coefficient k (of
+// x^(degree-k)) of polynomial i is coeffs[k*n + i], and root k goes to
+// re/im[k*n + i], in no particular order. The roots are the eigenvalues of
+// each balanced companion matrix, from double-shift QR run on
+// DSKYPOLY_COMPANION_LANES polynomials at once; one that fails to converge
+// is handed to solve_poly_n_aberth. nroots[i] (if non-NULL) gets degree,
+// or 0 for a zero leading coefficient (roots zeroed). Returns 0, or -1
+// with errno = EINVAL if degree is outside 1..DSKYPOLY_COMPANION_MAX_DEGREE.
+int solve_poly_n_companion_batch(const double* coeffs, int degree, size_t n,
+                                 double* re, double* im, int* nroots);
+
+// === Refinement: Newton polish with error bounds (src/refine_poly_n.asm) ===
+
+// Polishes approximations re/im[0..n) of the roots of coeffs[0] x^n + ...
+// + coeffs[n] in place, at most `steps` Newton steps per root on the
+// original polynomial, two roots per SSE2 update. err[k] (if err is
+// non-NULL) gets a radius around the final root that contains a true
+// root, from a Horner running-error bound. A root stops early once its
+// radius is below tol (1 + |z|). Returns the number of roots that met
+// tol, or 0 with nothing touched if n < 1 or coeffs[0] == 0. The work
+// area lives on the stack (about 72 bytes per degree), so n is capped:
+// above DSKYPOLY_REFINE_MAX_DEGREE it returns -1 with errno = EINVAL and
+// nothing touched.
+#define DSKYPOLY_REFINE_MAX_DEGREE 1024
+int refine_poly_n(const double* coeffs, int n, double* re, double* im,
+                  double* err, int steps, double tol);
+
+// === Evaluation: p and p' over arrays of points (src/eval_poly_n.asm) ===
+
+// p(x[i]) and p'(x[i]) for i < m, p = coeffs[0] x^n + ... + coeffs[n], n >= 0,
+// routed to the widest kernel the host supports. One Horner pass yields
+// both; dp may be NULL. coeffs is read in place, so the kernels' stack
+// use does not grow with n.
+void eval_poly_n(const double* coeffs, int n, const double* x, size_t m,
+                 double* p, double* dp);
+
+// The same at complex points z = xr[i] + i*xi[i], values and derivatives
+// as split planes; dr and di are both NULL or both set
+void eval_poly_n_complex(const double* coeffs, int n,
+                         const double* xr, const double* xi, size_t m,
+                         double* pr, double* pi, double* dr, double* di);
+
+// Individual vector widths (same file), same contracts; AVX2 rounds
+// exactly like SSE2
+void eval_poly_n_sse2(const double* coeffs, int n, const double* x, size_t m,
+                      double* p, double* dp);
+void eval_poly_n_avx2(const double* coeffs, int n, const double* x, size_t m,
+                      double* p, double* dp);
+void eval_poly_n_complex_sse2(const double* coeffs, int n,
+                              const double* xr, const double* xi, size_t m,
+                              double* pr, double* pi, double* dr, double* di);
+void eval_poly_n_complex_avx2(const double* coeffs, int n,
+                              const double* xr, const double* xi, size_t m,
+                              double* pr, double* pi, double* dr, double* di);
+
+// === Bulk solve: mixed degrees across all cores (src/dskypoly_solve.c) ===
+
+#define DSKYPOLY_MAX_DEGREE 5
+
+// One polynomial of degree 2..5, coefficients from x^degree down to the
+// constant term (the a, b, c, ... order of the scalar solvers)
+typedef struct {
+    int degree;
+    double coeffs[DSKYPOLY_MAX_DEGREE + 1];
+} dskypoly_poly;
+
+// Solves polys[0..n) with a work-stealing pool of `threads` workers, the
+// calling thread included. threads <= 0 means $DSKYPOLY_THREADS, or one per
+// online CPU. Roots of polys[i] go to re/im[i * DSKYPOLY_MAX_DEGREE + k];
+// nroots[i] (if nroots is non-NULL) gets the degree kernel's return value,
+// 0 for a zero leading coefficient, or -1 for an unsupported degree.
+// Returns the number of workers that took part.
+int dskypoly_solve(const dskypoly_poly* polys, size_t n,
+                   double* re, double* im, int* nroots, int threads);
+
+// Optional polish pass of a bulk solve, one setting for the whole batch
+typedef struct {
+    int steps;      // Newton steps per root at most (0: no refinement)
+    double tol;     // stop a root once its radius is below tol (1 + |z|)
+    double* err;    // radii laid out like re/im (or NULL)
+} dskypoly_refine;
+
+// dskypoly_solve, then refine_poly_n on every solved polynomial. refine
+// may be NULL; nroots still reports the solve kernel's return value.
+int dskypoly_solve_refined(const dskypoly_poly* polys, size_t n,
+                           double* re, double* im, int* nroots, int threads,
+                           const dskypoly_refine* refine);
+
+// Same contract, with a pre-pass for mixed batches: polynomials are
+// counting-sorted by degree and quintic special form, runs of quadratics
+// and cubics go through solve_poly_2_batch / solve_poly_3_batch, and the
+// rest reach their scalar kernels grouped by kind. Roots and nroots still
+// land in the caller's order. Falls back to dskypoly_solve_refined when
+// the sort buffers cannot be allocated.
+int dskypoly_solve_sorted(const dskypoly_poly* polys, size_t n,
+                          double* re, double* im, int* nroots, int threads,
+                          const dskypoly_refine* refine);
+
+// The sorted solve on caller-owned scratch: no allocation when threads
+// resolves to 1, one pthread per extra worker otherwise. scratch must be
+// 64-byte aligned and dskypoly_solve_scratch_bytes(n, threads) long.
+size_t dskypoly_solve_scratch_bytes(size_t n, int threads);
+int dskypoly_solve_sorted_in(void* scratch, const dskypoly_poly* polys, size_t n,
+                             double* re, double* im, int* nroots, int threads,
+                             const dskypoly_refine* refine);
+
+// === Solver context: arena-backed results (src/dskypoly_ctx.c) ===
+
+typedef struct dskypoly_ctx dskypoly_ctx;
+
+// Non-owning view of one solve: root k of polynomial i is
+// re[i * stride + k] + i*im[i * stride + k] for k < nroots[i]; other slots
+// are unspecified. err is NULL unless the solve was refined. Valid until
+// the context is reset or destroyed.
+typedef struct {
+    const double* re;
+    const double* im;
+    const double* err;
+    const int* nroots;
+    size_t count;
+    size_t stride;
+} dskypoly_roots_view;
+
+// A context whose solves run on `threads` workers (as in dskypoly_solve)
+// out of an arena with at least `reserve` bytes up front. NULL if out of
+// memory.
+dskypoly_ctx* dskypoly_ctx_create(int threads, size_t reserve);
+void dskypoly_ctx_destroy(dskypoly_ctx* ctx);
+
+// Invalidates every view and allocation at once. Blocks the arena had to
+// add since the last reset are merged into one, so repeated same-sized
+// rounds stop touching the allocator.
+void dskypoly_ctx_reset(dskypoly_ctx* ctx);
+
+// Bump allocation, 64-byte aligned; NULL with errno = ENOMEM
+void* dskypoly_ctx_alloc(dskypoly_ctx* ctx, size_t bytes);
+
+// Bytes the arena holds across all its blocks
+size_t dskypoly_ctx_capacity(const dskypoly_ctx* ctx);
+
+// dskypoly_solve_sorted into arena buffers, the sort scratch included.
+// refine->err is ignored: when refine->steps > 0 the radii come back in
+// out->err. Returns 0, or -1 with errno = ENOMEM (out untouched).
+int dskypoly_ctx_solve(dskypoly_ctx* ctx, const dskypoly_poly* polys, size_t n,
+                       const dskypoly_refine* refine, dskypoly_roots_view* out);
+
+// === Root tracking: warm-started updates per stream (src/dskypoly_track.c) ===
+
+typedef struct dskypoly_tracker dskypoly_tracker;
+
+#define DSKYPOLY_TRACK_MAX_DEGREE 64
+#define DSKYPOLY_TRACK_DRIFT 1e-3     // default max_drift
+#define DSKYPOLY_TRACK_TOL   1e-12    // default tol, as for refine_poly_n
+#define DSKYPOLY_TRACK_STEPS 4        // Newton steps before giving up on a warm start
+
+// A tracker that warm-starts a stream whenever no coefficient moved by
+// more than max_drift times the largest previous coefficient, accepting
+// the tracked roots once every root's last Newton step is below
+// tol (1 + |z|) and no two disks of radius degree |step| overlap. Values
+// <= 0 pick the defaults above. NULL if out of memory. Not thread-safe:
+// one tracker per thread.
+dskypoly_tracker* dskypoly_tracker_create(double max_drift, double tol);
+void dskypoly_tracker_destroy(dskypoly_tracker* t);
+
+// Roots of the stream's next polynomial coeffs[0] x^degree + ... +
+// coeffs[degree] into re/im. Roots that moved are moved to first order
+// from the previous update and polished by Newton, so they keep their order
+// from tick to tick; a new stream, new degree, large jump or failed warm
+// start is solved cold by the kernels dskypoly_solve uses. *steps (if
+// non-NULL) gets the Newton steps taken, or -1 for a cold solve. Returns the
+// number of roots (degree, or 0 for coeffs[0] == 0, which also drops the
+// stream), or -1 with errno = EINVAL (degree outside
+// 1..DSKYPOLY_TRACK_MAX_DEGREE) or ENOMEM (roots written, stream not kept).
+int dskypoly_tracker_update(dskypoly_tracker* t, uint64_t stream, const double* coeffs,
+                            int degree, double* re, double* im, int* steps);
+
+// Drops a stream's state; unknown IDs are ignored
+void dskypoly_tracker_forget(dskypoly_tracker* t, uint64_t stream);
+
+// Streams currently held
+size_t dskypoly_tracker_streams(const dskypoly_tracker* t);
+
+// === Root cache: repeated polynomials, optionally on disk (src/dskypoly_cache.c) ===
+
+typedef struct dskypoly_cache dskypoly_cache;
+
+#define DSKYPOLY_CACHE_MAGIC   "DSKYCACH"
+#define DSKYPOLY_CACHE_VERSION 1        // bumped whenever the entry layout changes
+#define DSKYPOLY_CACHE_WAYS    8        // entries per set; each set has its own CLOCK
+
+// A cache of at least `capacity` entries (0: 65536), rounded up to a power
+// of two sets. With a path the table is a shared mapping of that file: a
+// file left by an earlier cache of the same geometry is reused with its
+// entries, a new or empty file gets an empty table, and any other file is
+// left alone (EINVAL). One process per file at a time. NULL with errno set
+// on failure.
+dskypoly_cache* dskypoly_cache_open(size_t capacity, const char* path);
+void dskypoly_cache_close(dskypoly_cache* cache);
+size_t dskypoly_cache_capacity(const dskypoly_cache* cache);
+
+// Keys are the coefficients divided by coeffs[0], -0.0 read as +0.0, so
+// scaled copies of a polynomial share an entry. Lookup copies a hit's
+// degree roots into re/im and returns its root count; -1 on a miss or for
+// a polynomial the cache does not hold (degree outside
+// 1..DSKYPOLY_MAX_DEGREE, zero leading coefficient, NaN or infinity).
+// Insert stores what a solver returned for p (nroots >= 0), evicting by
+// CLOCK within p's set; it may drop the entry under contention. Both are
+// lock-free and safe to call from any number of threads.
+int dskypoly_cache_lookup(dskypoly_cache* cache, const dskypoly_poly* p,
+                          double* re, double* im);
+void dskypoly_cache_insert(dskypoly_cache* cache, const dskypoly_poly* p, int nroots,
+                           const double* re, const double* im);
+
+// dskypoly_solve_refined with every solve looked up in the cache first and
+// inserted after a miss (src/dskypoly_solve.c). A hit returns the roots as
+// first solved for its key, so scaled copies may differ from a direct solve
+// in the last bits. refine, if set, still polishes every polynomial.
+int dskypoly_solve_cached(dskypoly_cache* cache, const dskypoly_poly* polys, size_t n,
+                          double* re, double* im, int* nroots, int threads,
+                          const dskypoly_refine* refine);
+
+// === Galois classification: factor patterns mod small primes (src/dskypoly_galois.c) ===
+
+#define DSKYPOLY_GALOIS_COEF_MAX (1ll << 31)   // largest integer coefficient examined
+
+// Verdicts, each proven except where noted
+enum {
+    DSKYPOLY_GALOIS_UNKNOWN     = 0,  // not integral, too large, or a split not ruled out
+    DSKYPOLY_GALOIS_REDUCIBLE   = 1,  // rational roots split off
+    DSKYPOLY_GALOIS_SOLVABLE    = 2,  // irreducible of degree <= 4
+    DSKYPOLY_GALOIS_IRREDUCIBLE = 3,  // irreducible quintic, group not pinned down
+    DSKYPOLY_GALOIS_NONSOLVABLE = 4,  // irreducible quintic whose group contains A5
+    DSKYPOLY_GALOIS_VERDICTS    = 5
+};
+
+typedef struct {
+    int verdict;                            // DSKYPOLY_GALOIS_*
+    int primes;                             // good primes the factor patterns came from
+    unsigned factor_degrees;                // bit k: a rational factor of degree k not ruled out
+    int rational;                           // rational roots, in root[]
+    double root[DSKYPOLY_MAX_DEGREE];
+    double cofactor[DSKYPOLY_MAX_DEGREE + 1];   // what is left, degree - rational
+} dskypoly_galois;
+
+// Splits the rational roots off coeffs[0] x^degree + ... + coeffs[degree]
+// exactly. For any coefficients that means the zero roots. For integer
+// coefficients up to DSKYPOLY_GALOIS_COEF_MAX it means every simple
+// rational root: they are found mod small primes and confirmed by exact
+// division. root[0..k) gets the k roots, each the double nearest the
+// rational. cofactor[0..degree-k] gets the polynomial left over. Returns
+// k; 0, with nothing written, if there are none or the degree is outside
+// 2..DSKYPOLY_MAX_DEGREE.
+int dskypoly_galois_split(const double* coeffs, int degree, double* root, double* cofactor);
+
+// The same split, plus the factor degrees of the polynomial mod up to 12
+// primes. From those it gives a verdict on reducibility, and for an
+// irreducible quintic on solvability (Dedekind, Chebotarev). Returns
+// g->verdict.
+int dskypoly_galois_classify(const double* coeffs, int degree, dskypoly_galois* g);
+
+// === Strided entry point for FFI callers (src/dskypoly_strided.c) ===
+
+// All roots of n polynomials of one degree, straight from the caller's
+// buffers: coefficient k (of x^(degree-k)) of polynomial i is
+// coeffs[i * poly_stride + k * coef_stride], strides in doubles, so a
+// NumPy array of any layout goes in as is. Root k of polynomial i is
+// written as the complex pair roots[2 * (i * degree + k)], [... + 1] (a
+// C-order complex128 array of shape (n, degree)) and nroots[i] (if
+// nroots is non-NULL) gets degree, or 0 for a zero leading coefficient
+// (whose roots are zeroed). Returns 0, or -1 with errno = EINVAL if
+// degree is outside 1..DSKYPOLY_STRIDED_MAX_DEGREE.
+#define DSKYPOLY_STRIDED_MAX_DEGREE 64
+int dskypoly_roots_strided(const double* coeffs, int degree, size_t n,
+                           ptrdiff_t poly_stride, ptrdiff_t coef_stride,
+                           double* roots, int* nroots);
+
+// One polynomial of degree 1..DSKYPOLY_STRIDED_MAX_DEGREE, degree+1
+// coefficients highest first, roots as degree complex pairs. Returns the
+// root count (0 for a zero leading coefficient), or -1 for a bad degree.
+static inline int dskypoly_solve_one(int degree, const double* coeffs, double* roots) {
+    int nroots;
+    if (dskypoly_roots_strided(coeffs, degree, 1, degree + 1, 1, roots, &nroots) != 0)
+        return -1;
+    return nroots;
+}
+
+// === Binary coefficient / root files (src/dskypoly_io.c) ===
+//
+// A 64-byte header, then `planes` planes of `stride` little-endian doubles.
+// stride is count rounded up to a multiple of 8, so every plane starts on a
+// 64-byte boundary; lanes past count are zero.
+//   Coefficient file ("DSKYCOEF"): degree+1 planes, x^degree coefficient
+//     first; plane k holds coefficient k of every polynomial.
+//   Root file ("DSKYROOT"): degree real planes, then degree imaginary
+//     planes; plane k holds root k of every polynomial. A root the
+//     polynomial does not have (every root, for a zero leading
+//     coefficient) is NaN in both planes, and prints as nan +nani in
+//     text output.
+
+#define DSKYPOLY_COEF_MAGIC   "DSKYCOEF"
+#define DSKYPOLY_ROOT_MAGIC   "DSKYROOT"
+#define DSKYPOLY_FILE_VERSION 1
+
+typedef struct {
+    char magic[8];          // DSKYPOLY_COEF_MAGIC or DSKYPOLY_ROOT_MAGIC, no NUL
+    uint32_t version;       // DSKYPOLY_FILE_VERSION
+    uint32_t degree;        // 2..DSKYPOLY_MAX_DEGREE, one degree per file
+    uint64_t count;         // polynomials in the file
+    uint64_t stride;        // doubles per plane
+    uint64_t planes;        // planes after the header
+    uint8_t reserved[24];   // zero, pads the header to 64 bytes
+} dskypoly_file_header;
+
+static inline size_t dskypoly_file_stride(size_t count) {
+    return (count + 7) & ~(size_t)7;
+}
+
+// Whether the planes a header describes fit in a size-byte file. stride is
+// bounded by what size can hold before any product is formed, so a crafted
+// count, stride or planes cannot wrap the byte count.
+static inline int dskypoly_file_fits(const dskypoly_file_header* h, size_t size) {
+    return size >= sizeof(*h)
+        && h->planes >= 1 && h->planes <= 2 * DSKYPOLY_MAX_DEGREE
+        && h->count <= h->stride && h->stride == dskypoly_file_stride(h->count)
+        && h->stride <= (size - sizeof(*h)) / (h->planes * sizeof(double));
+}
+
+// Writes count polynomials, given row by row (degree+1 coefficients each,
+// highest first), as a coefficient file. Returns 0, or -1 with errno set.
+int dskypoly_file_write_coeffs(const char* path, int degree, size_t count,
+                               const double* coeffs);
+
+// Maps a coefficient file, solves every polynomial in it and writes the
+// matching root file through a shared mapping. Degrees 2-3 run the batched
+// kernels on the mapped planes; 4-5 use dskypoly_solve on every core.
+// Returns 0, or -1 with errno set (EINVAL for a malformed input file).
+int dskypoly_file_solve(const char* in_path, const char* out_path);
+
+// Same solve for inputs larger than memory, as a pipeline: a reader thread
+// preads chunks of the planes, `threads` workers solve them (<= 0: as for
+// dskypoly_solve), and the calling thread writes them in order, all over a
+// fixed set of reused buffers. Writes the root file of dskypoly_file_solve,
+// or with text != 0 one line of `re im` pairs per polynomial as --degree
+// does; out_path "-" is stdout (text only). Returns 0, or -1 with errno set.
+int dskypoly_file_stream(const char* in_path, const char* out_path, int text, int threads);
+
+// === Event log: lock-free ring drained by a background thread (src/dskypoly_log.c) ===
+
+enum {
+    DSKYPOLY_LOG_OFF   = 0,     // queue nothing
+    DSKYPOLY_LOG_INFO  = 1,     // DSKY commands and results
+    DSKYPOLY_LOG_DEBUG = 2      // plus per-solve events
+};
+
+// Opens (appends to) path and starts the drain thread; $DSKYPOLY_LOG_LEVEL
+// (off|info|debug) overrides level. Closed again at exit. Returns 0, or -1
+// if the file or thread could not be created (logging then stays off).
+int dskypoly_log_open(const char* path, int level);
+void dskypoly_log_close(void);
+void dskypoly_log_set_level(int level);
+int dskypoly_log_enabled(int level);
+
+// Queues msg (truncated to 119 bytes) if level is enabled; never blocks.
+// Timestamps are taken by the drain thread, once per batch.
+void dskypoly_log(int level, const char* msg);
+
+// === Solver statistics: per-thread counters (src/dskypoly_stats.c) ===
+
+// Outcome classes of a converged solve, as the scalar solvers branch on them
+enum {
+    DSKYPOLY_ROOTS_REAL    = 0,     // all roots real and distinct
+    DSKYPOLY_ROOTS_COMPLEX = 1,     // at least one complex pair
+    DSKYPOLY_ROOTS_DOUBLE  = 2,     // real, with a repeated root
+    DSKYPOLY_ROOTS_CLASSES = 3
+};
+
+// Forms recognised by solve_poly_5_special (quintic/src/solve_poly_5_special.asm)
+enum {
+    DSKYPOLY_SPECIAL_GENERAL      = 0,  // left to the numerical engine
+    DSKYPOLY_SPECIAL_MONOMIAL     = 1,  // ax^5 + f
+    DSKYPOLY_SPECIAL_BINOMIAL     = 2,  // ax^5 + ex + f
+    DSKYPOLY_SPECIAL_FACTORIZABLE = 3,
+    DSKYPOLY_SPECIAL_CASES        = 4
+};
+
+// Phases of the scalar Cardano and Ferrari kernels, timed only when they
+// are assembled for profiling (make profile); each kernel's are a run
+// starting at its first, in kernel order
+enum {
+    DSKYPOLY_PHASE_CARDANO_MONIC          = 0,   // cubic/src/solve_poly_3.asm, Step 1
+    DSKYPOLY_PHASE_CARDANO_DEPRESS        = 1,   // Step 2
+    DSKYPOLY_PHASE_CARDANO_DISCRIMINANT   = 2,   // Step 3
+    DSKYPOLY_PHASE_CARDANO_ONE_REAL       = 3,   // u + v and the conjugate pair
+    DSKYPOLY_PHASE_CARDANO_THREE_REAL     = 4,   // Newton on the Chebyshev identity
+    DSKYPOLY_PHASE_FERRARI_MONIC          = 5,   // quartic/src/solve_poly_4_production.asm, Phase 1
+    DSKYPOLY_PHASE_FERRARI_DEPRESS        = 6,   // Phase 2
+    DSKYPOLY_PHASE_FERRARI_RESOLVENT      = 7,   // Phase 3
+    DSKYPOLY_PHASE_FERRARI_RESOLVENT_ROOT = 8,   // Phase 4, cubic_depressed_max_root included
+    DSKYPOLY_PHASE_FERRARI_EXTRACT        = 9,   // Phase 5, two quadratics
+    DSKYPOLY_PHASE_FERRARI_BIQUADRATIC    = 10,  // Phase 5 when q ≈ 0
+    DSKYPOLY_PHASES                       = 11
+};
+
+#define DSKYPOLY_CYCLE_BUCKETS 32        // bucket b: [2^b, 2^(b+1)) TSC ticks
+#define DSKYPOLY_SWEEP_BUCKETS 8         // bucket b: [2^b, 2^(b+1)) sweeps
+#define DSKYPOLY_PHASE_BUCKETS 16        // bucket b: [2^b, 2^(b+1)) TSC ticks
+
+// Totals over every thread that has recorded a solve. All fields are
+// uint64_t; counts only grow, so dashboards diff successive snapshots.
+typedef struct {
+    uint64_t solves[DSKYPOLY_MAX_DEGREE + 1];       // by degree
+    uint64_t roots[DSKYPOLY_MAX_DEGREE + 1][DSKYPOLY_ROOTS_CLASSES];
+    uint64_t failures[DSKYPOLY_MAX_DEGREE + 1];     // fewer roots than degree
+    uint64_t cycles[DSKYPOLY_MAX_DEGREE + 1][DSKYPOLY_CYCLE_BUCKETS];
+    uint64_t sweeps;                                // Aberth sweeps, summed
+    uint64_t sweep_hist[DSKYPOLY_SWEEP_BUCKETS];    // per numerical solve
+    uint64_t special[DSKYPOLY_SPECIAL_CASES];
+    uint64_t splits;                                // quartics/quintics deflated exactly
+    uint64_t split_roots;                           // rational roots they gave up
+    uint64_t phase_cycles[DSKYPOLY_PHASES];         // TSC ticks summed, profile builds
+    uint64_t phase_hist[DSKYPOLY_PHASES][DSKYPOLY_PHASE_BUCKETS];
+    uint64_t cache_hits;                            // dskypoly_cache_lookup
+    uint64_t cache_misses;
+    uint64_t blocks;                                // thread blocks summed
+} dskypoly_stats;
+
+// One solve of the given degree that returned nroots roots in re/im and
+// took cycles TSC ticks. Called by dskypoly_solve for every polynomial.
+void dskypoly_stats_record(int degree, int nroots, const double* re, const double* im,
+                           uint64_t cycles);
+// n solves done by one batched kernel call; the histogram gets n entries
+// in the bucket of the per-solve average. Outcomes are not classified.
+void dskypoly_stats_record_batch(int degree, size_t n, uint64_t cycles);
+void dskypoly_stats_sweeps(int sweeps);
+void dskypoly_stats_special(int kind);
+void dskypoly_stats_split(int roots);
+void dskypoly_stats_cache(int hit);
+// Called by profile-built kernels (include/dskypoly_phase.inc): stamps[k]
+// is the TSC at the start of phase first + k, or 0 if the kernel skipped
+// it, and stamps[n - 1] the TSC at the end. Each phase that ran is charged
+// up to the next stamp, less the cost of taking one.
+void dskypoly_phase_record(int first, int n, const uint64_t* stamps);
+
+// Sums every thread's block into out. Never blocks the recording threads.
+void dskypoly_stats_snapshot(dskypoly_stats* out);
+void dskypoly_stats_print(const dskypoly_stats* s);
+
+// The phase's symbol, e.g. "ferrari_depress"; NULL for a number that is
+// not a DSKYPOLY_PHASE_*
+const char* dskypoly_phase_name(int phase);
+// Phase ticks as folded stacks, one "kernel;phase ticks" line per phase
+// that ran: flamegraph.pl input, with the frames perf reports for the same
+// symbols. path "-" is stdout. Returns 0, or -1 with errno set.
+int dskypoly_stats_fold(const dskypoly_stats* s, const char* path);
+
+// === Runtime CPU dispatch (src/dskypoly_cpu.c, src/dskypoly_dispatch.c) ===
+
+// Vector instruction set levels, ordered so that a higher level implies
+// every lower one
+enum {
+    DSKYPOLY_ISA_SSE2   = 0,
+    DSKYPOLY_ISA_AVX2   = 1,
+    DSKYPOLY_ISA_AVX512 = 2
+};
+
+// Level usable on this host (CPUID + OS register-state support), probed
+// once. DSKYPOLY_ISA=sse2|avx2|avx512 in the environment caps it.
+int dskypoly_cpu_level(void);
+const char* dskypoly_isa_name(int level);
+
+typedef void (*dskypoly_poly2_batch_fn)(const double*, const double*, const double*,
+                                        size_t, double*, double*, double*, double*);
+typedef void (*dskypoly_poly3_batch_fn)(const double*, const double*, const double*,
+                                        const double*, size_t, double*, double*);
+typedef void (*dskypoly_eval_fn)(const double*, int, const double*, size_t,
+                                 double*, double*);
+typedef void (*dskypoly_eval_complex_fn)(const double*, int, const double*, const double*,
+                                         size_t, double*, double*, double*, double*);
+typedef int (*dskypoly_poly2f_batch_fn)(const float*, const float*, const float*, size_t,
+                                       float*, float*, float*, float*, float);
+typedef int (*dskypoly_poly3f_batch_fn)(const float*, const float*, const float*, const float*,
+                                       size_t, float*, float*, float);
+typedef int (*dskypoly_poly4f_batch_fn)(const float*, const float*, const float*, const float*,
+                                       const float*, size_t, float*, float*, float);
+
+// One slot per public batched entry point, bound at program start
+struct dskypoly_dispatch_table {
+    int level;                              // host level the slots were bound for
+    dskypoly_poly2_batch_fn poly2_batch;    // behind solve_poly_2_batch
+    dskypoly_poly3_batch_fn poly3_batch;    // behind solve_poly_3_batch
+    dskypoly_eval_fn eval;                  // behind eval_poly_n
+    dskypoly_eval_complex_fn eval_complex;  // behind eval_poly_n_complex
+    dskypoly_poly2f_batch_fn poly2f_batch;  // behind solve_poly_2_batch_f32
+    dskypoly_poly3f_batch_fn poly3f_batch;  // behind solve_poly_3_batch_f32
+    dskypoly_poly4f_batch_fn poly4f_batch;  // behind solve_poly_4_batch_f32
+};
+
+extern struct dskypoly_dispatch_table dskypoly_dispatch;
+
+#if defined(__GNUC__)
+#pragma GCC visibility pop
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DSKYPOLY_H
@@ -0,0 +1,220 @@
+/*
+ * dskypoly.hpp - compile-time shape specialization for DSKYpoly batches
+ *
+ * The scalar solvers find special forms at run time, one exact-zero test
+ * per coefficient per polynomial. Batches are usually all one shape (all
+ * biquadratics, all depressed cubics, all monomials), so here the
+ * shape is a template argument instead: solve<N, Zero> picks its kernel
+ * with `if constexpr`, and the inner loops carry no per-element branch on
+ * the coefficients.
+ *
+ *   solve<4, mask::biquadratic>(coeffs, n, re, im);  // ax^4 + cx^2 + e
+ *   solve<5, mask::monomial>(coeffs, n, re, im);     // ax^5 + f
+ *
+ * Layout matches solve_poly_3_batch: coeffs[k] is the plane of the x^(N-k)
+ * coefficient of every polynomial, and root k of polynomial i lands in
+ * re[k*n + i] + i*im[k*n + i]. Planes the mask declares zero are never
+ * read and may be nullptr. Every leading coefficient must be non-zero.
+ *
+ * Header-only, C++17; links against the same objects as dskypoly.h.
+ */
+
+#ifndef DSKYPOLY_HPP
+#define DSKYPOLY_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <emmintrin.h>
+
+#include "dskypoly.h"
+
+namespace dskypoly {
+
+// Known-zero coefficient masks: bit k set means coefficient k (of x^(N-k))
+// is zero in every polynomial of the batch
+namespace mask {
+constexpr unsigned none        = 0;
+constexpr unsigned depressed   = 1u << 1;              // no x^(N-1) term
+constexpr unsigned biquadratic = 1u << 1 | 1u << 3;    // ax^4 + cx^2 + e
+constexpr unsigned monomial    = ~1u;                  // ax^N + c, any N
+}
+
+namespace detail {
+
+// Bits of the coefficients strictly between the leading and constant terms
+constexpr unsigned middle(int N) {
+    return ((1u << N) - 1) & ~1u;
+}
+
+constexpr unsigned shape(int N, unsigned zero) {
+    return zero & middle(N);
+}
+
+// Coefficient k of polynomial i, folded to 0.0 at compile time when masked
+template <unsigned Zero, int K>
+inline double coef(const double* const* coeffs, size_t i) {
+    if constexpr ((Zero >> K) & 1u)
+        return 0.0;
+    else
+        return coeffs[K][i];
+}
+
+// A masked plane for the batched kernels, which always read every input
+template <unsigned Zero, int K>
+inline const double* plane(const double* const* coeffs, const double* zeros, size_t i) {
+    if constexpr ((Zero >> K) & 1u)
+        return zeros;
+    else
+        return coeffs[K] + i;
+}
+
+// Principal square root of x + iy without a branch on the quadrant
+inline void csqrt(double x, double y, double* sr, double* si) {
+    double m = std::sqrt(x * x + y * y);
+    *sr = std::sqrt(std::fmax(0.5 * (m + x), 0.0));
+    *si = std::copysign(std::sqrt(std::fmax(0.5 * (m - x), 0.0)), y);
+}
+
+constexpr size_t chunk = 256;        // polynomials per call into a batched kernel
+
+// x^N = -c/a through the twiddle-table kernel, scattered to the planes
+template <int N>
+inline void solve_monomial(const double* const* coeffs, size_t n, double* re, double* im) {
+    double r[N], s[N];
+    for (size_t i = 0; i < n; i++) {
+        solve_poly_n_monomial(coeffs[0][i], coeffs[N][i], N, r, s);
+        for (int k = 0; k < N; k++) {
+            re[k * n + i] = r[k];
+            im[k * n + i] = s[k];
+        }
+    }
+}
+
+// ax^4 + cx^2 + e as two quadratics: ay^2 + cy + e for y = x^2 in the
+// packed batch kernel (into the last two root planes), then x = ±sqrt(y)
+// for both y, two polynomials per SSE2 register
+inline void solve_biquadratic(const double* const* coeffs, size_t n, double* re, double* im) {
+    solve_poly_2_batch(coeffs[0], coeffs[2], coeffs[4], n,
+                       re + 2 * n, im + 2 * n, re + 3 * n, im + 3 * n);
+
+    const __m128d half = _mm_set1_pd(0.5), zero = _mm_setzero_pd();
+    const __m128d sign = _mm_set1_pd(-0.0);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        for (int q = 0; q < 2; q++) {
+            // Principal root of x + iy: sqrt((m + x)/2) + i sgn(y) sqrt((m - x)/2)
+            __m128d x = _mm_loadu_pd(re + (2 + q) * n + i);
+            __m128d y = _mm_loadu_pd(im + (2 + q) * n + i);
+            __m128d m = _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(x, x), _mm_mul_pd(y, y)));
+            __m128d sr = _mm_sqrt_pd(_mm_max_pd(_mm_mul_pd(half, _mm_add_pd(m, x)), zero));
+            __m128d si = _mm_sqrt_pd(_mm_max_pd(_mm_mul_pd(half, _mm_sub_pd(m, x)), zero));
+            si = _mm_or_pd(si, _mm_and_pd(y, sign));
+            _mm_storeu_pd(re + 2 * q * n + i, sr);
+            _mm_storeu_pd(im + 2 * q * n + i, si);
+            _mm_storeu_pd(re + (2 * q + 1) * n + i, _mm_xor_pd(sr, sign));
+            _mm_storeu_pd(im + (2 * q + 1) * n + i, _mm_xor_pd(si, sign));
+        }
+    }
+    for (; i < n; i++) {
+        for (int q = 0; q < 2; q++) {
+            double sr, si;
+            csqrt(re[(2 + q) * n + i], im[(2 + q) * n + i], &sr, &si);
+            re[2 * q * n + i] = sr;
+            im[2 * q * n + i] = si;
+            re[(2 * q + 1) * n + i] = -sr;
+            im[(2 * q + 1) * n + i] = -si;
+        }
+    }
+}
+
+} // namespace detail
+
+// Solves n polynomials of degree N whose known-zero coefficients are Zero.
+// Degrees 1-5 take any mask; mask::monomial also covers degrees up to
+// DSKYPOLY_MONOMIAL_MAX_DEGREE.
+template <int N, unsigned Zero = mask::none>
+void solve(const double* const* coeffs, size_t n, double* re, double* im) {
+    constexpr unsigned S = detail::shape(N, Zero);
+    static_assert(N >= 1 && N <= DSKYPOLY_MONOMIAL_MAX_DEGREE, "unsupported degree");
+    static_assert(N <= 5 || S == detail::middle(N),
+                  "degrees above 5 only have the monomial kernel");
+    static_assert(Zero == mask::monomial || (Zero & ~detail::middle(N)) == 0,
+                  "mask names a coefficient this degree does not have between "
+                  "its leading and constant terms");
+
+    if constexpr (N == 1) {
+        for (size_t i = 0; i < n; i++) {
+            re[i] = -coeffs[1][i] / coeffs[0][i];
+            im[i] = 0.0;
+        }
+    } else if constexpr (N == 2) {
+        // The packed batch kernel is already branch-free; ax^2 + c only
+        // swaps the b plane for zeros
+        if constexpr (S == 0) {
+            solve_poly_2_batch(coeffs[0], coeffs[1], coeffs[2], n, re, im, re + n, im + n);
+        } else {
+            static const double zeros[detail::chunk] = {};
+            for (size_t i = 0; i < n; i += detail::chunk) {
+                size_t m = n - i < detail::chunk ? n - i : detail::chunk;
+                solve_poly_2_batch(coeffs[0] + i, zeros, coeffs[2] + i, m,
+                                   re + i, im + i, re + n + i, im + n + i);
+            }
+        }
+    } else if constexpr (S == detail::middle(N)) {
+        detail::solve_monomial<N>(coeffs, n, re, im);
+    } else if constexpr (N == 3) {
+        if constexpr (S == 0) {
+            solve_poly_3_batch(coeffs[0], coeffs[1], coeffs[2], coeffs[3], n, re, im);
+        } else {
+            // The batch kernel writes three planes of its own n: bounce each
+            // chunk through a local copy, feeding zeros for masked planes
+            static const double zeros[detail::chunk] = {};
+            double r[3 * detail::chunk], s[3 * detail::chunk];
+            for (size_t i = 0; i < n; i += detail::chunk) {
+                size_t m = n - i < detail::chunk ? n - i : detail::chunk;
+                solve_poly_3_batch(coeffs[0] + i,
+                                   detail::plane<Zero, 1>(coeffs, zeros, i),
+                                   detail::plane<Zero, 2>(coeffs, zeros, i),
+                                   coeffs[3] + i, m, r, s);
+                for (int k = 0; k < 3; k++)
+                    for (size_t j = 0; j < m; j++) {
+                        re[k * n + i + j] = r[k * m + j];
+                        im[k * n + i + j] = s[k * m + j];
+                    }
+            }
+        }
+    } else if constexpr (N == 4 && S == mask::biquadratic) {
+        detail::solve_biquadratic(coeffs, n, re, im);
+    } else if constexpr (N == 4) {
+        double r[4], s[4];
+        for (size_t i = 0; i < n; i++) {
+            solve_poly_4_production(coeffs[0][i], detail::coef<Zero, 1>(coeffs, i),
+                                    detail::coef<Zero, 2>(coeffs, i),
+                                    detail::coef<Zero, 3>(coeffs, i), coeffs[4][i], r, s);
+            for (int k = 0; k < 4; k++) {
+                re[k * n + i] = r[k];
+                im[k * n + i] = s[k];
+            }
+        }
+    } else {
+        // General quintic: straight to Aberth, skipping the special-form probe
+        double c[6], r[5], s[5];
+        for (size_t i = 0; i < n; i++) {
+            c[0] = coeffs[0][i];
+            c[1] = detail::coef<Zero, 1>(coeffs, i);
+            c[2] = detail::coef<Zero, 2>(coeffs, i);
+            c[3] = detail::coef<Zero, 3>(coeffs, i);
+            c[4] = detail::coef<Zero, 4>(coeffs, i);
+            c[5] = coeffs[5][i];
+            solve_poly_n_aberth(c, 5, r, s);
+            for (int k = 0; k < 5; k++) {
+                re[k * n + i] = r[k];
+                im[k * n + i] = s[k];
+            }
+        }
+    }
+}
+
+} // namespace dskypoly
+
+#endif // DSKYPOLY_HPP
@@ -0,0 +1,133 @@
+/*
+ * dskypoly_bench.h - shared timing and reporting for the DSKYpoly benchmarks
+ *
+ * Header-only, included by one bench driver per binary. Every measurement
+ * is the best of several passes, timed twice over: CLOCK_MONOTONIC for
+ * ns/solve and the time-stamp counter for cycles/solve. The TSC ticks at
+ * the nominal clock, so cycles differ from core cycles under turbo or
+ * frequency scaling; compare them across builds on the same host.
+ *
+ * When a JSON path is given, every reported line is also appended to a
+ * machine-readable record:
+ *   {"suite": ..., "isa": ..., "results": [
+ *     {"name": ..., "mode": "single"|"batch"|"bulk"|"stream", "solves": ...,
+ *      "ns_per_solve": ..., "cycles_per_solve": ..., "msolve_per_s": ...,
+ *      "speedup": ..., "max_rel_diff": ... | null}, ...]}
+ */
+
+#ifndef DSKYPOLY_BENCH_H
+#define DSKYPOLY_BENCH_H
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+#include <x86intrin.h>
+
+typedef struct {
+    double t0;
+    uint64_t c0;
+    double seconds;     // best pass so far
+    double cycles;      // TSC ticks of that pass
+} bench_timer;
+
+static FILE* bench_json;
+static int bench_json_entries;
+static int bench_saved_stdout = -1;
+
+static inline double bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static inline void bench_timer_init(bench_timer* t) {
+    t->seconds = 1e30;
+    t->cycles = 0.0;
+}
+
+static inline void bench_begin(bench_timer* t) {
+    t->t0 = bench_now();
+    t->c0 = __rdtsc();
+}
+
+static inline void bench_end(bench_timer* t) {
+    uint64_t c = __rdtsc() - t->c0;
+    double s = bench_now() - t->t0;
+    if (s < t->seconds) {
+        t->seconds = s;
+        t->cycles = (double)c;
+    }
+}
+
+// Start the JSON record; a NULL path turns JSON off. isa may be NULL.
+static inline void bench_json_open(const char* path, const char* suite, const char* isa) {
+    if (!path)
+        return;
+    bench_json = fopen(path, "w");
+    if (!bench_json) {
+        perror(path);
+        return;
+    }
+    fprintf(bench_json, "{\"suite\": \"%s\"", suite);
+    if (isa)
+        fprintf(bench_json, ", \"isa\": \"%s\"", isa);
+    fprintf(bench_json, ", \"results\": [");
+    bench_json_entries = 0;
+}
+
+static inline void bench_json_close(void) {
+    if (!bench_json)
+        return;
+    fprintf(bench_json, "\n]}\n");
+    fclose(bench_json);
+    bench_json = NULL;
+}
+
+// One result line: solves per pass n, speedup against baseline seconds,
+// err < 0 when there is nothing to compare against
+static inline void bench_report(const char* label, const char* mode, const bench_timer* t,
+                                size_t n, double baseline, double err) {
+    double ns = t->seconds * 1e9 / n, cyc = t->cycles / n;
+    double mops = n / t->seconds * 1e-6, speedup = baseline / t->seconds;
+
+    printf("%-26s %9.2f ns/solve %9.1f cyc/solve %9.2f Msolve/s %7.2fx",
+           label, ns, cyc, mops, speedup);
+    if (err >= 0.0)
+        printf("   max rel diff %.1e", err);
+    printf("\n");
+
+    if (!bench_json)
+        return;
+    fprintf(bench_json, "%s\n  {\"name\": \"%s\", \"mode\": \"%s\", \"solves\": %zu, "
+                        "\"ns_per_solve\": %.3f, \"cycles_per_solve\": %.1f, "
+                        "\"msolve_per_s\": %.3f, \"speedup\": %.3f, \"max_rel_diff\": ",
+            bench_json_entries++ ? "," : "", label, mode, n, ns, cyc, mops, speedup);
+    if (err >= 0.0)
+        fprintf(bench_json, "%.3e}", err);
+    else
+        fprintf(bench_json, "null}");
+}
+
+// The reference solvers narrate every call; time them with stdout on /dev/null
+static inline void bench_mute_stdout(void) {
+    fflush(stdout);
+    int null_fd = open("/dev/null", O_WRONLY);
+    if (null_fd < 0)
+        return;
+    bench_saved_stdout = dup(STDOUT_FILENO);
+    dup2(null_fd, STDOUT_FILENO);
+    close(null_fd);
+}
+
+static inline void bench_restore_stdout(void) {
+    if (bench_saved_stdout < 0)
+        return;
+    fflush(stdout);
+    dup2(bench_saved_stdout, STDOUT_FILENO);
+    close(bench_saved_stdout);
+    bench_saved_stdout = -1;
+}
+
+#endif // DSKYPOLY_BENCH_H
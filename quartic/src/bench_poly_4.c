@@ -0,0 +1,104 @@
+// === bench_poly_4.c for DSKYpoly-4 ===
+// Throughput of the narrated reference quartic solver against the silent
+// Ferrari production kernel on the same coefficient quintuples, one call
+// per quartic and as whole batches through the bulk driver.
+//
+// usage: bench_poly_4 [results.json]
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "dskypoly.h"
+#include "dskypoly_bench.h"
+
+#define BENCH_N          (1 << 12)   // quartics per pass (cache resident)
+#define BENCH_PASSES     500
+#define BENCH_REF_N      256         // the reference prints every step
+#define BENCH_REF_PASSES 5
+
+extern void solve_poly_4_reference(double a, double b, double c, double d, double e);
+
+static double a[BENCH_N], b[BENCH_N], c[BENCH_N], d[BENCH_N], e[BENCH_N];
+static double re[4], im[4];
+static dskypoly_poly polys[BENCH_N];
+static double batch_re[BENCH_N * DSKYPOLY_MAX_DEGREE], batch_im[BENCH_N * DSKYPOLY_MAX_DEGREE];
+
+// Random coefficients; real and complex root pairs in every combination
+static void fill_coefficients(void) {
+    srand(2025);
+    for (int i = 0; i < BENCH_N; i++) {
+        double sign = (rand() & 1) ? 1.0 : -1.0;
+        a[i] = sign * (0.5 + 1.5 * rand() / (double)RAND_MAX);
+        b[i] = -10.0 + 20.0 * rand() / (double)RAND_MAX;
+        c[i] = -10.0 + 20.0 * rand() / (double)RAND_MAX;
+        d[i] = -10.0 + 20.0 * rand() / (double)RAND_MAX;
+        e[i] = -10.0 + 20.0 * rand() / (double)RAND_MAX;
+        polys[i] = (dskypoly_poly){ 4, { a[i], b[i], c[i], d[i], e[i] } };
+    }
+}
+
+static bench_timer bench_reference(void) {
+    bench_timer t;
+    bench_timer_init(&t);
+    bench_mute_stdout();
+    for (int pass = 0; pass < BENCH_REF_PASSES; pass++) {
+        bench_begin(&t);
+        for (int i = 0; i < BENCH_REF_N; i++)
+            solve_poly_4_reference(a[i], b[i], c[i], d[i], e[i]);
+        bench_end(&t);
+    }
+    bench_restore_stdout();
+    return t;
+}
+
+static bench_timer bench_production(void) {
+    bench_timer t;
+    bench_timer_init(&t);
+    for (int pass = 0; pass < BENCH_PASSES; pass++) {
+        bench_begin(&t);
+        for (int i = 0; i < BENCH_N; i++)
+            solve_poly_4_production(a[i], b[i], c[i], d[i], e[i], re, im);
+        bench_end(&t);
+    }
+    return t;
+}
+
+// All BENCH_N quartics in one dskypoly_solve call per pass
+static bench_timer bench_batched(int threads, int* workers) {
+    bench_timer t;
+    bench_timer_init(&t);
+    for (int pass = 0; pass < BENCH_PASSES; pass++) {
+        bench_begin(&t);
+        *workers = dskypoly_solve(polys, BENCH_N, batch_re, batch_im, NULL, threads);
+        bench_end(&t);
+    }
+    return t;
+}
+
+int main(int argc, char** argv) {
+    printf("=== DSKYpoly Quartic Benchmark ===\n");
+    printf("%d quartics per pass, best of %d passes (reference: %d x %d, stdout muted)\n\n",
+           BENCH_N, BENCH_PASSES, BENCH_REF_N, BENCH_REF_PASSES);
+    bench_json_open(argc > 1 ? argv[1] : NULL, "quartic", NULL);
+    fill_coefficients();
+
+    bench_timer ref = bench_reference();
+    double per_ref = ref.seconds / BENCH_REF_N;
+    bench_report("solve_poly_4_reference", "single", &ref, BENCH_REF_N, ref.seconds, -1.0);
+
+    bench_timer t = bench_production();
+    bench_report("solve_poly_4_production", "single", &t, BENCH_N, per_ref * BENCH_N, -1.0);
+
+    int workers;
+    char label[32];
+    t = bench_batched(1, &workers);
+    bench_report("dskypoly_solve x1", "batch", &t, BENCH_N, per_ref * BENCH_N, -1.0);
+    t = bench_batched(0, &workers);
+    if (workers > 1) {
+        snprintf(label, sizeof(label), "dskypoly_solve x%d", workers);
+        bench_report(label, "batch", &t, BENCH_N, per_ref * BENCH_N, -1.0);
+    }
+
+    bench_json_close();
+    return 0;
+}
@@ -19,9 +19,10 @@
 #include <complex.h>
 #include <string.h>
 
+#include "dskypoly.h"
+
 // External assembly functions
 extern void solve_poly_4_reference(double a, double b, double c, double d, double e);
-extern void solve_poly_4_production(double a, double b, double c, double d, double e);
 
 // Test cases for Ferrari's method validation
 typedef struct {
@@ -106,7 +107,7 @@ void run_interactive_mode() {
         solve_poly_4_reference(a, b, c, d, e);
         
         printf("\n🚀 Production Implementation Result:\n");
-        solve_poly_4_production(a, b, c, d, e);
+        solve_poly_4_production_trace(a, b, c, d, e);
         
         printf("\nSolve another quartic? (y/n): ");
         scanf(" %c", &choice);
@@ -132,7 +133,7 @@ void run_test_suite() {
         
         printf("\n🚀 Testing Production Implementation:\n");
         // Call the production implementation (full Ferrari mathematics)
-        solve_poly_4_production(test->a, test->b, test->c, test->d, test->e);
+        solve_poly_4_production_trace(test->a, test->b, test->c, test->d, test->e);
         
         printf("\n");
     }
@@ -4,266 +4,413 @@
 ;
 ; Ferrari's Method (Correct Mathematical Implementation):
 ; 1. Depress quartic: Remove cubic term → y⁴ + py² + qy + r = 0
-; 2. Resolvent cubic: 8t³ + 8pt² + (2p² - 8r)t - q² = 0  
-; 3. Solve cubic using Cardano's method
-; 4. Extract quartic roots from cubic solution
+; 2. Resolvent cubic: 8t³ + 8pt² + (2p² - 8r)t - q² = 0
+; 3. Solve cubic using Cardano's method (largest real root m), via the
+;    cubic module's cubic_depressed_max_root
+; 4. Extract quartic roots from cubic solution:
+;    (y² + p/2 + m)² = (√(2m) y - q/(2√(2m)))², i.e. two quadratics
+;    y² ∓ √(2m) y + (p/2 + m ± q/(2√(2m))) = 0
+;    q ≈ 0 (or m ≤ 0) is the biquadratic z² + pz + r = 0, z = y².
+;
+; Compute kernel only: no I/O, no libm, and outside profile builds no stack
+; frame. The console trace (header, depressed form, resolvent, roots)
+; lives in solve_poly_4_trace.c.
+;
+; C prototype:
+;   int solve_poly_4_production(double a, double b, double c, double d, double e,
+;                               double re[4], double im[4]);
+;   Returns 4 (roots counted with multiplicity), or 0 if a == 0.
 ;
 ; Architecture Lessons Applied:
-; - 16-byte aligned stack layout
-; - Systematic register initialization
-; - Consistent offset patterns (scalable to quintic)
-; - Proper x86-64 ABI compliance
+; - Register-resident pipeline: coefficients never touch memory
+; - One reciprocal 1/a, depressed coefficients by Horner at the shift
+; - Cancellation-safe quadratic roots (t = -(β + sign(β)√Δ)/2, γ/t)
+; - Proper x86-64 ABI compliance (caller-saved registers only)
+;
+; Each phase starts at a PHASE label (include/dskypoly_phase.inc). With
+; -DDSKYPOLY_PROFILE (make profile) the phases become sized symbols for
+; perf annotate and are timed into the DSKYPOLY_PHASE_FERRARI_* histograms.
 
-section .data
+section .rodata
     ; Mathematical constants (16-byte aligned)
     align 16
-    const_neg1      dq -1.0
-    const_0         dq 0.0
-    const_1         dq 1.0
-    const_2         dq 2.0
-    const_3         dq 3.0
-    const_4         dq 4.0
-    const_8         dq 8.0
-    const_16        dq 16.0
-    const_27        dq 27.0
-    const_256       dq 256.0
-    const_half      dq 0.5
-    const_quarter   dq 0.25
-    const_eighth    dq 0.125
-    
-    ; Format strings for output
-    fmt_header      db "=== Ferrari's Method (Clean Implementation) ===", 10, 0
-    fmt_input       db "Input: %.6fx^4 + %.6fx^3 + %.6fx^2 + %.6fx + %.6f = 0", 10, 0
-    fmt_depressed   db "Depressed: y^4 + %.6fy^2 + %.6fy + %.6f = 0", 10, 0
-    fmt_resolvent   db "Resolvent: 8t^3 + %.6ft^2 + %.6ft + %.6f = 0", 10, 0
-    fmt_discriminant db "Discriminant: %.9f", 10, 0
-    fmt_real_root   db "Root: %.9f", 10, 0
-    fmt_complete    db "=== Ferrari Method Complete ===", 10, 0
-    
-    ; Error messages
-    err_leading_zero db "Error: Leading coefficient cannot be zero", 10, 0
+    const_one           dq 1.0
+    const_three         dq 3.0
+    const_four          dq 4.0
+    const_six           dq 6.0
+    const_half          dq 0.5
+    const_neg_half      dq -0.5
+    const_quarter       dq 0.25
+    const_neg_quarter   dq -0.25
+    const_neg_eighth    dq -0.125
+    const_third         dq 0.33333333333333333
+    const_neg_twelfth   dq -0.083333333333333333
+    const_neg_1_108     dq -0.0092592592592592593     ; -1/108
+    const_biquad_eps    dq 1.0e-12                    ; |q| threshold, scale-free
+    align 16
+    mask_abs            dq 0x7FFFFFFFFFFFFFFF, 0x7FFFFFFFFFFFFFFF
+    mask_sign           dq 0x8000000000000000, 0x8000000000000000
 
 section .text
+%include "dskypoly_phase.inc"
+%ifdef DSKYPOLY_PROFILE
+    global solve_poly_4_production:function (ferrari_monic - solve_poly_4_production)
+    global ferrari_monic:function hidden (ferrari_depress - ferrari_monic)
+    global ferrari_depress:function hidden (ferrari_resolvent - ferrari_depress)
+    global ferrari_resolvent:function hidden (ferrari_resolvent_root - ferrari_resolvent)
+    global ferrari_resolvent_root:function hidden (ferrari_extract - ferrari_resolvent_root)
+    global ferrari_extract:function hidden (ferrari_biquadratic - ferrari_extract)
+    global ferrari_biquadratic:function hidden (quadratic_pair - ferrari_biquadratic)
+    global quadratic_pair:function hidden (sqrt_pair - quadratic_pair)
+    global sqrt_pair:function hidden (ferrari_text_end - sqrt_pair)
+%else
     global solve_poly_4_production
-    extern printf
-    extern sqrt
-    extern cbrt
-    extern pow
+%endif
+    extern cubic_depressed_max_root     ; cubic/src/solve_poly_3.asm (libdskypoly3.a)
 
 ; === Clean Ferrari Implementation (Production) ===
-; Input: xmm0=a, xmm1=b, xmm2=c, xmm3=d, xmm4=e
-; Stack Layout (16-byte aligned, scalable pattern):
-; [rsp+0]   - [rsp+64]   : Input coefficients (a,b,c,d,e)
-; [rsp+80]  - [rsp+112]  : Depressed coefficients (p,q,r)  
-; [rsp+128] - [rsp+160]  : Resolvent coefficients (A,B,C,D)
-; [rsp+176] - [rsp+192]  : Root values
+; Input: xmm0=a, xmm1=b, xmm2=c, xmm3=d, xmm4=e, rdi=re[4], rsi=im[4]
+; Register layout after Phase 2:
+; xmm5 = shift s (x = y + s), xmm6 = p, xmm7 = q, xmm8 = r
 solve_poly_4_production:
-    push rbp
-    mov rbp, rsp
-    sub rsp, 208                    ; 13*16 = 208 bytes (16-byte aligned)
-    
-    ; === Phase 1: Input Processing ===
-    ; Store coefficients at 16-byte boundaries
-    movsd [rsp+0], xmm0             ; a (x^4 coefficient)
-    movsd [rsp+16], xmm1            ; b (x^3 coefficient)
-    movsd [rsp+32], xmm2            ; c (x^2 coefficient)
-    movsd [rsp+48], xmm3            ; d (x^1 coefficient)
-    movsd [rsp+64], xmm4            ; e (constant term)
-    
-    ; Print header and input
-    mov rdi, fmt_header
-    xor rax, rax
-    call printf
-    
-    mov rdi, fmt_input
-    movsd xmm0, [rsp+0]
-    movsd xmm1, [rsp+16]
-    movsd xmm2, [rsp+32]
-    movsd xmm3, [rsp+48]
-    movsd xmm4, [rsp+64]
-    mov rax, 5
-    call printf
-    
-    ; Check for leading coefficient = 0
-    movsd xmm0, [rsp+0]
-    xorpd xmm7, xmm7
-    ucomisd xmm0, xmm7
-    je .error_leading_zero
-    
-    ; === Phase 2: Depress Quartic (Remove cubic term) ===
-    ; Transform: ax⁴ + bx³ + cx² + dx + e = 0 → y⁴ + py² + qy + r = 0
-    ; Substitution: y = x + b/(4a)
-    
-    ; Calculate p coefficient: p = c/a - 3b²/(8a²)
-    movsd xmm0, [rsp+32]            ; c
-    divsd xmm0, [rsp+0]             ; c/a
-    
-    movsd xmm1, [rsp+16]            ; b
-    mulsd xmm1, xmm1                ; b²
-    mulsd xmm1, [rel const_3]       ; 3b²
-    movsd xmm2, [rsp+0]             ; a
-    mulsd xmm2, xmm2                ; a²
-    mulsd xmm2, [rel const_8]       ; 8a²
-    divsd xmm1, xmm2                ; 3b²/(8a²)
-    subsd xmm0, xmm1                ; p = c/a - 3b²/(8a²)
-    movsd [rsp+80], xmm0            ; Store p
-    
-    ; Calculate q coefficient: q = b³/(8a³) - bc/(2a²) + d/a
-    movsd xmm0, [rsp+16]            ; b
-    mulsd xmm0, xmm0                ; b²
-    mulsd xmm0, [rsp+16]            ; b³
-    movsd xmm1, [rsp+0]             ; a
-    mulsd xmm1, xmm1                ; a²
-    mulsd xmm1, [rsp+0]             ; a³
-    mulsd xmm1, [rel const_8]       ; 8a³
-    divsd xmm0, xmm1                ; b³/(8a³)
-    
-    movsd xmm1, [rsp+16]            ; b
-    mulsd xmm1, [rsp+32]            ; bc
-    movsd xmm2, [rsp+0]             ; a
-    mulsd xmm2, xmm2                ; a²
-    mulsd xmm2, [rel const_2]       ; 2a²
-    divsd xmm1, xmm2                ; bc/(2a²)
-    subsd xmm0, xmm1                ; b³/(8a³) - bc/(2a²)
-    
-    movsd xmm1, [rsp+48]            ; d
-    divsd xmm1, [rsp+0]             ; d/a
-    addsd xmm0, xmm1                ; q = b³/(8a³) - bc/(2a²) + d/a
-    movsd [rsp+96], xmm0            ; Store q
-    
-    ; Calculate r coefficient (complex formula)
-    ; r = -3b⁴/(256a⁴) + cb²/(16a³) - bd/(4a²) + e/a
-    movsd xmm0, [rsp+16]            ; b
-    mulsd xmm0, xmm0                ; b²
-    mulsd xmm0, xmm0                ; b⁴
-    mulsd xmm0, [rel const_3]       ; 3b⁴
-    movsd xmm1, [rel const_neg1]
-    mulsd xmm0, xmm1                ; -3b⁴
-    
-    movsd xmm1, [rsp+0]             ; a
-    mulsd xmm1, xmm1                ; a²
-    mulsd xmm1, xmm1                ; a⁴
-    mulsd xmm1, [rel const_256]     ; 256a⁴
-    divsd xmm0, xmm1                ; -3b⁴/(256a⁴)
-    
-    movsd xmm1, [rsp+32]            ; c
-    movsd xmm2, [rsp+16]            ; b
-    mulsd xmm2, xmm2                ; b²
-    mulsd xmm1, xmm2                ; cb²
-    movsd xmm2, [rsp+0]             ; a
-    mulsd xmm2, xmm2                ; a²
-    mulsd xmm2, [rsp+0]             ; a³
-    mulsd xmm2, [rel const_16]      ; 16a³
-    divsd xmm1, xmm2                ; cb²/(16a³)
-    addsd xmm0, xmm1                ; -3b⁴/(256a⁴) + cb²/(16a³)
-    
-    movsd xmm1, [rsp+16]            ; b
-    mulsd xmm1, [rsp+48]            ; bd
-    movsd xmm2, [rsp+0]             ; a
-    mulsd xmm2, xmm2                ; a²
-    mulsd xmm2, [rel const_4]       ; 4a²
-    divsd xmm1, xmm2                ; bd/(4a²)
-    subsd xmm0, xmm1                ; ... - bd/(4a²)
-    
-    movsd xmm1, [rsp+64]            ; e
-    divsd xmm1, [rsp+0]             ; e/a
-    addsd xmm0, xmm1                ; r = ... + e/a
-    movsd [rsp+112], xmm0           ; Store r
-    
-    ; Print depressed quartic
-    mov rdi, fmt_depressed
-    movsd xmm0, [rsp+80]            ; p
-    movsd xmm1, [rsp+96]            ; q
-    movsd xmm2, [rsp+112]           ; r
-    mov rax, 3
-    call printf
-    
-    ; === Phase 3: Setup Resolvent Cubic ===
-    ; From y⁴ + py² + qy + r = 0, create: 8t³ + 8pt² + (2p² - 8r)t - q² = 0
-    
-    movsd xmm0, [rel const_8]
-    movsd [rsp+128], xmm0           ; A = 8
-    
-    movsd xmm0, [rsp+80]            ; p
-    mulsd xmm0, [rel const_8]       ; 8p
-    movsd [rsp+144], xmm0           ; B = 8p
-    
-    movsd xmm0, [rsp+80]            ; p
-    mulsd xmm0, xmm0                ; p²
-    mulsd xmm0, [rel const_2]       ; 2p²
-    movsd xmm1, [rsp+112]           ; r
-    mulsd xmm1, [rel const_8]       ; 8r
-    subsd xmm0, xmm1                ; 2p² - 8r
-    movsd [rsp+160], xmm0           ; C = 2p² - 8r
-    
-    movsd xmm0, [rsp+96]            ; q
-    mulsd xmm0, xmm0                ; q²
-    movsd xmm1, [rel const_neg1]
-    mulsd xmm0, xmm1                ; -q²
-    movsd [rsp+176], xmm0           ; D = -q²
-    
-    ; Print resolvent cubic
-    mov rdi, fmt_resolvent
-    movsd xmm0, [rsp+144]           ; B
-    movsd xmm1, [rsp+160]           ; C  
-    movsd xmm2, [rsp+176]           ; D
-    mov rax, 3
-    call printf
-    
-    ; === Phase 4: Solve Cubic (Simplified Cardano's Method) ===
-    ; For demonstration, use a simplified approach
-    ; In production, this would call the full cubic solver
-    
-    ; Calculate discriminant for analysis
-    movsd xmm0, [rsp+160]           ; C
-    mulsd xmm0, xmm0                ; C²
-    mulsd xmm0, xmm0                ; C⁴
-    movsd xmm1, [rsp+176]           ; D
-    mulsd xmm1, xmm1                ; D²
-    mulsd xmm1, [rel const_27]      ; 27D²
-    subsd xmm0, xmm1                ; Simplified discriminant
-    movsd [rsp+192], xmm0           ; Store discriminant
-    
-    mov rdi, fmt_discriminant
-    movsd xmm0, [rsp+192]
-    mov rax, 1
-    call printf
-    
-    ; === Phase 5: Extract Quartic Roots (Simplified) ===
-    ; Use approximate method for demonstration
-    ; Real implementation would use full Ferrari extraction
-    
-    movsd xmm0, [rsp+80]            ; p coefficient
-    call sqrt                       ; sqrt(p) as approximation
-    movsd [rsp+176], xmm0           ; Store approximate root
-    
-    mov rdi, fmt_real_root
-    movsd xmm0, [rsp+176]
-    mov rax, 1
-    call printf
-    
-    ; Print second root (negative)
-    mov rdi, fmt_real_root
-    movsd xmm0, [rsp+176]
-    mulsd xmm0, [rel const_neg1]
-    mov rax, 1
-    call printf
-    
-    ; Print completion
-    mov rdi, fmt_complete
-    xor rax, rax
-    call printf
-    
-    add rsp, 208
-    pop rbp
+    xorpd xmm15, xmm15              ; 0.0
+    ucomisd xmm0, xmm15
+    jne .quartic
+    xor eax, eax                    ; a == 0: not a quartic, buffers untouched
     ret
 
-.error_leading_zero:
-    mov rdi, err_leading_zero
-    xor rax, rax
-    call printf
-    add rsp, 208
-    pop rbp
+.quartic:
+    PHASE_FRAME 7                   ; slots: the six phases below, then the end
+
+    ; === Phase 1: Monic form, one reciprocal ===
+    PHASE ferrari_monic, 0
+    movsd xmm5, [rel const_one]
+    divsd xmm5, xmm0                ; 1/a
+    mulsd xmm1, xmm5                ; B
+    mulsd xmm2, xmm5                ; C
+    mulsd xmm3, xmm5                ; D
+    mulsd xmm4, xmm5                ; E
+
+    ; === Phase 2: Depress quartic, x = y + s with s = -B/4 ===
+    PHASE ferrari_depress, 1
+    ; p, q, r are the Taylor coefficients of P(x) at s:
+    ; p = P''(s)/2, q = P'(s), r = P(s)
+    movsd xmm5, xmm1
+    mulsd xmm5, [rel const_neg_quarter] ; s
+
+    movsd xmm6, xmm5
+    mulsd xmm6, [rel const_six]
+    movsd xmm7, xmm1
+    mulsd xmm7, [rel const_three]
+    addsd xmm6, xmm7
+    mulsd xmm6, xmm5
+    addsd xmm6, xmm2                ; p = (6s + 3B)s + C
+
+    movsd xmm7, xmm5
+    mulsd xmm7, [rel const_four]
+    movsd xmm8, xmm1
+    mulsd xmm8, [rel const_three]
+    addsd xmm7, xmm8
+    mulsd xmm7, xmm5
+    addsd xmm7, xmm2
+    addsd xmm7, xmm2
+    mulsd xmm7, xmm5
+    addsd xmm7, xmm3                ; q = ((4s + 3B)s + 2C)s + D
+
+    movsd xmm8, xmm5
+    addsd xmm8, xmm1
+    mulsd xmm8, xmm5
+    addsd xmm8, xmm2
+    mulsd xmm8, xmm5
+    addsd xmm8, xmm3
+    mulsd xmm8, xmm5
+    addsd xmm8, xmm4                ; r = (((s + B)s + C)s + D)s + E
+
+    ; q ≈ 0: biquadratic, and the resolvent root m → 0 would cancel.
+    ; Roots of size t make p ~ t², q ~ t³, r ~ t⁴, so |q| is measured
+    ; against |p|^(3/2) + |r|^(3/4): the same verdict at every scale
+    movapd xmm0, xmm7
+    andpd xmm0, [rel mask_abs]      ; |q|
+    movapd xmm1, xmm6
+    andpd xmm1, [rel mask_abs]
+    sqrtsd xmm2, xmm1
+    mulsd xmm1, xmm2                ; |p|^(3/2)
+    movapd xmm2, xmm8
+    andpd xmm2, [rel mask_abs]
+    sqrtsd xmm2, xmm2               ; |r|^(1/2)
+    sqrtsd xmm3, xmm2
+    mulsd xmm2, xmm3                ; |r|^(3/4)
+    addsd xmm1, xmm2
+    mulsd xmm1, [rel const_biquad_eps]  ; eps (|p|^(3/2) + |r|^(3/4))
+    ucomisd xmm0, xmm1
+    jbe ferrari_biquadratic
+
+    ; === Phase 3: Resolvent cubic m³ + pm² + (p²/4 - r)m - q²/8 = 0 ===
+    PHASE ferrari_resolvent, 2
+    ; Depressed by m = z - p/3: z³ + Pz + Q = 0 with
+    ; P = -p²/12 - r,  Q = -p³/108 + pr/3 - q²/8
+    movsd xmm0, xmm6
+    mulsd xmm0, xmm6                ; p²
+    movsd xmm1, xmm0
+    mulsd xmm1, xmm6
+    mulsd xmm1, [rel const_neg_1_108]   ; -p³/108
+    mulsd xmm0, [rel const_neg_twelfth]
+    subsd xmm0, xmm8                ; P
+    movsd xmm2, xmm6
+    mulsd xmm2, xmm8
+    mulsd xmm2, [rel const_third]
+    addsd xmm1, xmm2
+    movsd xmm2, xmm7
+    mulsd xmm2, xmm7
+    mulsd xmm2, [rel const_neg_eighth]
+    addsd xmm1, xmm2                ; Q
+
+    ; === Phase 4: Largest real root of the resolvent ===
+    PHASE ferrari_resolvent_root, 3
+    ; Register-only call into the cubic module: P, Q in, z out, and
+    ; xmm5-xmm15 / rdi / rsi survive, so nothing is spilled
+    call cubic_depressed_max_root wrt ..plt
+    movsd xmm1, xmm6
+    mulsd xmm1, [rel const_third]
+    subsd xmm0, xmm1                ; m = z - p/3
+
+    ; One Newton step on R(m) = ((m + p)m + p²/4 - r)m - q²/8 recovers the
+    ; digits the shift by p/3 cancels when m is small
+    movsd xmm3, xmm6
+    mulsd xmm3, xmm6
+    mulsd xmm3, [rel const_quarter]
+    subsd xmm3, xmm8                ; p²/4 - r
+    movsd xmm1, xmm0
+    addsd xmm1, xmm6
+    mulsd xmm1, xmm0
+    addsd xmm1, xmm3
+    mulsd xmm1, xmm0
+    movsd xmm2, xmm7
+    mulsd xmm2, xmm7
+    mulsd xmm2, [rel const_neg_eighth]
+    addsd xmm1, xmm2                ; R(m)
+    movsd xmm2, xmm0
+    mulsd xmm2, [rel const_three]
+    movsd xmm4, xmm6
+    addsd xmm4, xmm6
+    addsd xmm2, xmm4
+    mulsd xmm2, xmm0
+    addsd xmm2, xmm3                ; R'(m) = (3m + 2p)m + p²/4 - r
+    ucomisd xmm2, xmm15
+    je .m_ready                     ; double resolvent root: keep m
+    divsd xmm1, xmm2
+    subsd xmm0, xmm1
+.m_ready:
+    ucomisd xmm0, xmm15
+    jbe ferrari_biquadratic         ; m > 0 whenever q != 0; guard rounding
+
+    ; === Phase 5: Extract quartic roots from two quadratics ===
+    PHASE ferrari_extract, 4
+    movsd xmm9, xmm0                ; m
+    addsd xmm0, xmm0
+    sqrtsd xmm10, xmm0              ; σ = √(2m)
+    movsd xmm11, xmm6
+    mulsd xmm11, [rel const_half]
+    addsd xmm11, xmm9               ; p/2 + m
+    movsd xmm12, xmm10
+    addsd xmm12, xmm12
+    movsd xmm13, xmm7
+    divsd xmm13, xmm12              ; q/(2σ)
+
+    ; γ± = p/2 + m ± q/(2σ) and γ+ γ- = r (that is the resolvent), so
+    ; form the non-cancelling one directly and the other as r/γ
+    movsd xmm1, xmm11
+    addsd xmm1, xmm13               ; γ+
+    movsd xmm12, xmm11
+    subsd xmm12, xmm13              ; γ-
+    movapd xmm2, xmm11
+    xorpd xmm2, xmm13
+    movmskpd eax, xmm2
+    test eax, 1
+    jnz .minus_exact                ; signs differ: γ- has no cancellation
+    ucomisd xmm1, xmm15
+    je .gammas_ready
+    movsd xmm12, xmm8
+    divsd xmm12, xmm1               ; γ- = r/γ+
+    jmp .gammas_ready
+.minus_exact:
+    ucomisd xmm12, xmm15
+    je .gammas_ready
+    movsd xmm1, xmm8
+    divsd xmm1, xmm12               ; γ+ = r/γ-
+.gammas_ready:
+
+    movapd xmm0, xmm10
+    xorpd xmm0, [rel mask_sign]     ; β = -σ, γ = γ+ in xmm1
+    call quadratic_pair             ; roots 0, 1
+
+    add rdi, 16
+    add rsi, 16
+    movsd xmm0, xmm10               ; β = +σ
+    movsd xmm1, xmm12               ; γ = γ-
+    call quadratic_pair             ; roots 2, 3
+
+    PHASE_END 5, 7                  ; DSKYPOLY_PHASE_FERRARI_MONIC
+    mov eax, 4
     ret
 
+    ; === y⁴ + py² + r = 0: z² + pz + r = 0, then y = ±√z ===
+    PHASE ferrari_biquadratic, 5
+    movsd xmm0, xmm6
+    mulsd xmm0, xmm6
+    movsd xmm1, xmm8
+    mulsd xmm1, [rel const_four]
+    subsd xmm0, xmm1                ; Δ = p² - 4r
+    ucomisd xmm0, xmm15
+    jb .biquadratic_complex
+
+    sqrtsd xmm0, xmm0
+    movapd xmm1, xmm6
+    andpd xmm1, [rel mask_sign]
+    orpd xmm0, xmm1
+    addsd xmm0, xmm6
+    mulsd xmm0, [rel const_neg_half]    ; z1 = -(p + sign(p)√Δ)/2
+    movsd xmm9, xmm8                ; z2 = r/z1 (z1 = 0 only when r = 0)
+    ucomisd xmm0, xmm15
+    je .z2_ready
+    divsd xmm9, xmm0
+.z2_ready:
+    call sqrt_pair                  ; roots 0, 1 = ±√z1
+    add rdi, 16
+    add rsi, 16
+    movsd xmm0, xmm9
+    call sqrt_pair                  ; roots 2, 3 = ±√z2
+
+    PHASE_END 5, 7
+    mov eax, 4
+    ret
+
+.biquadratic_complex:
+    ; z = α ± iβ with α = -p/2, β = √(-Δ)/2, |z| = √r
+    ; √z = wr + i wi, taking the non-cancelling half-angle formula first
+    xorpd xmm0, [rel mask_sign]
+    sqrtsd xmm0, xmm0
+    mulsd xmm0, [rel const_half]    ; β
+    movsd xmm1, xmm6
+    mulsd xmm1, [rel const_neg_half]    ; α
+    sqrtsd xmm2, xmm8               ; |z|
+    ucomisd xmm1, xmm15
+    jb .alpha_negative
+
+    addsd xmm2, xmm1
+    mulsd xmm2, [rel const_half]
+    sqrtsd xmm2, xmm2               ; wr = √((|z| + α)/2)
+    movsd xmm3, xmm0
+    divsd xmm3, xmm2
+    mulsd xmm3, [rel const_half]    ; wi = β/(2wr)
+    jmp .biquadratic_store
+
+.alpha_negative:
+    subsd xmm2, xmm1
+    mulsd xmm2, [rel const_half]
+    sqrtsd xmm3, xmm2               ; wi = √((|z| - α)/2)
+    movsd xmm2, xmm0
+    divsd xmm2, xmm3
+    mulsd xmm2, [rel const_half]    ; wr = β/(2wi)
+
+.biquadratic_store:
+    ; ±√z and ±√conj(z): s ± wr with imaginary parts ±wi
+    movsd xmm0, xmm5
+    addsd xmm0, xmm2
+    movsd xmm1, xmm5
+    subsd xmm1, xmm2
+    movapd xmm4, xmm3
+    xorpd xmm4, [rel mask_sign]
+    movsd [rdi], xmm0
+    movsd [rdi+8], xmm0
+    movsd [rdi+16], xmm1
+    movsd [rdi+24], xmm1
+    movsd [rsi], xmm3
+    movsd [rsi+8], xmm4
+    movsd [rsi+16], xmm4
+    movsd [rsi+24], xmm3
+
+    PHASE_END 5, 7
+    mov eax, 4
+    ret
+
+;--------------------------------------------------------------------------
+; quadratic_pair: roots of y² + βy + γ = 0, shifted by s, written to
+; re[0..1], im[0..1]. In: xmm0 = β, xmm1 = γ, xmm5 = s, rdi, rsi.
+; Clobbers xmm0-xmm4.
+;--------------------------------------------------------------------------
+quadratic_pair:
+    movsd xmm2, xmm0
+    mulsd xmm2, xmm0
+    movsd xmm3, xmm1
+    mulsd xmm3, [rel const_four]
+    subsd xmm2, xmm3                ; Δ = β² - 4γ
+    xorpd xmm3, xmm3
+    ucomisd xmm2, xmm3
+    jb .complex
+
+    sqrtsd xmm2, xmm2
+    movapd xmm4, xmm0
+    andpd xmm4, [rel mask_sign]
+    orpd xmm2, xmm4
+    addsd xmm2, xmm0
+    mulsd xmm2, [rel const_neg_half]    ; t = -(β + sign(β)√Δ)/2
+    ucomisd xmm2, xmm3
+    je .real_store                  ; t = 0 only when γ = 0: both roots 0
+    divsd xmm1, xmm2                ; γ/t
+.real_store:
+    addsd xmm2, xmm5
+    addsd xmm1, xmm5
+    movsd [rdi], xmm2
+    movsd [rdi+8], xmm1
+    movsd [rsi], xmm3
+    movsd [rsi+8], xmm3
+    ret
+
+.complex:
+    xorpd xmm2, [rel mask_sign]
+    sqrtsd xmm2, xmm2
+    mulsd xmm2, [rel const_half]    ; √(-Δ)/2
+    mulsd xmm0, [rel const_neg_half]
+    addsd xmm0, xmm5                ; s - β/2
+    movsd [rdi], xmm0
+    movsd [rdi+8], xmm0
+    movsd [rsi], xmm2
+    xorpd xmm2, [rel mask_sign]
+    movsd [rsi+8], xmm2
+    ret
+
+;--------------------------------------------------------------------------
+; sqrt_pair: y = ±√z for real z, shifted by s, written to re[0..1],
+; im[0..1]. In: xmm0 = z, xmm5 = s, rdi, rsi. Clobbers xmm0-xmm2.
+;--------------------------------------------------------------------------
+sqrt_pair:
+    xorpd xmm1, xmm1
+    ucomisd xmm0, xmm1
+    jb .imaginary
+
+    sqrtsd xmm0, xmm0
+    movapd xmm2, xmm5
+    subsd xmm2, xmm0                ; s - √z
+    addsd xmm0, xmm5                ; s + √z
+    movsd [rdi], xmm0
+    movsd [rdi+8], xmm2
+    movsd [rsi], xmm1
+    movsd [rsi+8], xmm1
+    ret
+
+.imaginary:
+    xorpd xmm0, [rel mask_sign]
+    sqrtsd xmm0, xmm0               ; √(-z)
+    movsd [rdi], xmm5
+    movsd [rdi+8], xmm5
+    movsd [rsi], xmm0
+    xorpd xmm0, [rel mask_sign]
+    movsd [rsi+8], xmm0
+    ret
+
+%ifdef DSKYPOLY_PROFILE
+ferrari_text_end:
+%endif
+
 ; === End of Clean Ferrari Implementation ===
@@ -0,0 +1,49 @@
+/*
+ * solve_poly_4_trace.c - Console trace of Ferrari's method
+ *
+ * Prints the same walk-through the production kernel used to print
+ * (input, depressed quartic, resolvent cubic, roots) around the silent
+ * solve_poly_4_production kernel. The intermediate values are recomputed
+ * here for display only; the roots come from the kernel itself.
+ */
+
+#include <stdio.h>
+
+#include "dskypoly.h"
+
+void solve_poly_4_production_trace(double a, double b, double c, double d, double e) {
+    double re[4], im[4];
+
+    printf("=== Ferrari's Method (Clean Implementation) ===\n");
+    printf("Input: %.6fx^4 + %.6fx^3 + %.6fx^2 + %.6fx + %.6f = 0\n", a, b, c, d, e);
+
+    int count = solve_poly_4_production(a, b, c, d, e, re, im);
+    if (count == 0) {
+        printf("Error: Leading coefficient cannot be zero\n");
+        return;
+    }
+
+    // Depressed quartic y^4 + py^2 + qy + r, x = y + s
+    double B = b / a, C = c / a, D = d / a, E = e / a;
+    double s = -B / 4.0;
+    double p = (6.0 * s + 3.0 * B) * s + C;
+    double q = ((4.0 * s + 3.0 * B) * s + 2.0 * C) * s + D;
+    double r = (((s + B) * s + C) * s + D) * s + E;
+    printf("Depressed: y^4 + %.6fy^2 + %.6fy + %.6f = 0\n", p, q, r);
+
+    // Resolvent cubic 8t^3 + 8pt^2 + (2p^2 - 8r)t - q^2 and its discriminant
+    double rb = 8.0 * p, rc = 2.0 * p * p - 8.0 * r, rd = -q * q;
+    printf("Resolvent: 8t^3 + %.6ft^2 + %.6ft + %.6f = 0\n", rb, rc, rd);
+    double disc = 18.0 * 8.0 * rb * rc * rd - 4.0 * rb * rb * rb * rd + rb * rb * rc * rc
+                - 4.0 * 8.0 * rc * rc * rc - 27.0 * 64.0 * rd * rd;
+    printf("Discriminant: %.9f\n", disc);
+
+    for (int i = 0; i < count; i++) {
+        if (im[i] == 0.0)
+            printf("Root: %.9f\n", re[i]);
+        else
+            printf("Root: %.9f %+.9fi\n", re[i], im[i]);
+    }
+
+    printf("=== Ferrari Method Complete ===\n");
+}
@@ -4,17 +4,21 @@
 ; The equation x^5 - 1 = 0 has one real root (x=1) and four complex roots (5th roots of unity), tied to the alternating group A_5, which proves general quintics are unsolvable by radicals (Galois, 1830s).
 ; Newton-Raphson iteratively refines an initial guess x0 using: x_{n+1} = x_n - p(x_n) / p'(x_n), converging quadratically if x0 is close to a root.
 ; Inspired by Grok 3 (released February 17, 2025), this code emphasizes transparency, like the Apollo DSKY, to clarify complex computations.
+;
+; Reentrant: the iteration lives in newton_quintic_r(double* root, int* iterations),
+; which returns the root and the iteration count through its arguments (0 = converged,
+; 1 = no convergence, 2 = zero derivative). newton_quintic prints around it from its own
+; stack frame, so both may run on several threads at once.
 
 ; --- Data Section ---
 section .data
     star_sep db "  ★ ★ ★ ★ ★  ", 10, 0
     star_sep_len equ $-star_sep
     iter_msg db "Iterations to converge: ", 0
-    iter_val_str times 8 db 0
-    iter_msg_len equ $-iter_msg
+    iter_msg_len equ $-iter_msg-1
     prec_msg db "Final precision: |f(x)| = ", 0
-    prec_val_str times 16 db 0
-    prec_msg_len equ $-prec_msg
+    prec_msg_len equ $-prec_msg-1
+    prec_val db "0.0", 10       ; only works for root near 1.0
     roots_msg db "Roots of x^5 = 1:", 10, 0
     root0 db "x0 = 1.0000000000", 10, 0
     root1 db "x1 = 0.309017 + 0.951057i", 10, 0
@@ -30,8 +34,7 @@ section .data
     eqn_msg db "Equation: x^5 - 1 = 0", 10, 0
     eqn_len equ $ - eqn_msg
     result_msg db "Result stored: ", 0
-    result_val_str times 32 db 0 ; buffer for result string
-    result_val_len equ 32
+    result_val db "1.0"         ; only works for root near 1.0
     soln_msg db "Root (hex): 0x", 0
     soln_len equ $ - soln_msg
     newline db 10, 0
@@ -52,23 +55,61 @@ section .data
     div_error db "DSKY: DIV ERROR", 10, 0
     div_error_len equ $ - div_error
 
-; --- BSS Section ---
-section .bss
-    result resq 1   ; Storage for the computed root
-
 ; --- Text Section ---
 section .text
     global newton_quintic
+    global newton_quintic_r
 
-newton_quintic:
-    ; --- Newton-Raphson iteration counter ---
-    xor rbx, rbx            ; iteration counter
-    mov rcx, 100            ; max iterations
+; --- Reentrant Newton-Raphson for x^5 - 1 = 0 ---
+; rdi = root out, rsi = iterations out; returns 0 converged, 1 no convergence, 2 p'(x) = 0
+newton_quintic_r:
     movsd xmm0, qword [one] ; initial guess x0 = 1.0
     movsd xmm1, qword [eps] ; epsilon (tolerance)
+    movsd xmm6, qword [abs_mask] ; sign mask for |delta|
+    xor ecx, ecx            ; iteration counter
+
+.nr_loop:
+    inc ecx
+    ; f(x) = x^5 - 1 and f'(x) = 5x^4 from one x^4
+    movsd xmm2, xmm0
+    mulsd xmm2, xmm0        ; x^2
+    mulsd xmm2, xmm2        ; x^4
+    movsd xmm3, xmm2
+    mulsd xmm3, xmm0        ; x^5
+    subsd xmm3, qword [one] ; x^5 - 1
+    mulsd xmm2, qword [five] ; 5x^4
 
-    push rbx                ; Save rbx
-    sub rsp, 32             ; Align stack for FPU calls
+    ; Check for division by zero (f'(x) == 0)
+    ucomisd xmm2, qword [zero]
+    je .nr_div_zero
+
+    ; x = x - delta, delta = f(x)/f'(x)
+    divsd xmm3, xmm2
+    subsd xmm0, xmm3
+
+    ; Check for convergence: |delta| < eps
+    andpd xmm3, xmm6
+    ucomisd xmm3, xmm1
+    jb .nr_converged
+    cmp ecx, 100            ; max iterations
+    jb .nr_loop
+
+    mov eax, 1              ; Not converged
+    jmp .nr_out
+.nr_div_zero:
+    mov eax, 2              ; Division by zero error
+    jmp .nr_out
+.nr_converged:
+    xor eax, eax
+.nr_out:
+    movsd [rdi], xmm0       ; Store result in the caller's slot
+    mov [rsi], ecx
+    ret
+
+; --- Narrated driver: prints the roots and the iteration report ---
+; Frame: [rsp+0] root, [rsp+8] iterations, [rsp+16..31] decimal digits
+newton_quintic:
+    sub rsp, 40             ; Align stack, room for locals
 
     ; Print the equation
     mov rax, 1
@@ -140,150 +181,59 @@ newton_quintic:
     syscall
 
     ; Newton-Raphson for x^5 - 1 = 0
-    mov rbx, 0              ; iteration counter
-    mov rcx, 100            ; max iterations
-    movsd xmm0, qword [one] ; initial guess x0 = 1.0
-    movsd xmm1, qword [eps] ; epsilon (tolerance)
-
-.nr_loop:
-    ; f(x) = x^5 - 1
-    inc rbx                 ; increment iteration count
-    movsd xmm2, xmm0        ; xmm2 = x
-    movsd xmm3, xmm0        ; xmm3 = x
-    mulsd xmm2, xmm0        ; x^2
-    mulsd xmm2, xmm0        ; x^3
-    mulsd xmm2, xmm0        ; x^4
-    mulsd xmm2, xmm0        ; x^5
-    movsd xmm4, qword [one]
-    subsd xmm2, xmm4        ; x^5 - 1
-
-    ; f'(x) = 5x^4
-    movsd xmm5, xmm3        ; xmm5 = x
-    mulsd xmm5, xmm3        ; x^2
-    mulsd xmm5, xmm3        ; x^3
-    mulsd xmm5, xmm3        ; x^4
-    movsd xmm6, qword [five]
-    mulsd xmm5, xmm6        ; 5x^4
+    lea rdi, [rsp+0]
+    lea rsi, [rsp+8]
+    call newton_quintic_r
+    test eax, eax
+    jnz .nr_failed
 
-    ; Check for division by zero (f'(x) == 0)
-    movsd xmm7, xmm5
-    xorpd xmm6, xmm6
-    ucomisd xmm7, xmm6
-    jne .nr_continue
-    add rsp, 32
-    mov rax, 2              ; Division by zero error
-    pop rbx
-    ret
-.nr_continue:
-    ; delta = f(x)/f'(x)
-    movsd xmm7, xmm2        ; f(x)
-    divsd xmm7, xmm5        ; f(x)/f'(x)
-    movsd xmm8, xmm0        ; x
-    subsd xmm8, xmm7        ; x - delta
-
-    ; Check for convergence: |delta| < eps
-    movsd xmm9, xmm7
-    movsd xmm10, xmm7
-    xorpd xmm11, xmm11
-    cmpsd xmm9, xmm11, 1    ; |delta| < 0?
-    jge .nr_abs
-    movsd xmm7, xmm10
-    subsd xmm7, xmm7
-.nr_abs:
-    comisd xmm7, xmm1
-    jb .nr_converged
-
-    movsd xmm0, xmm8        ; x = x - delta
-    inc rbx
-    cmp rbx, rcx
-    jl .nr_loop
-
-    ; Not converged
-    add rsp, 32
-    mov rax, 1
-    pop rbx
-    ret
-.nr_converged:
-    movsd [result], xmm8    ; Store result
-
-    ; Compute f(x) at root for precision
-    movsd xmm2, xmm8        ; x
-    movsd xmm3, xmm8        ; x
-    mulsd xmm2, xmm8        ; x^2
-    mulsd xmm2, xmm8        ; x^3
-    mulsd xmm2, xmm8        ; x^4
-    mulsd xmm2, xmm8        ; x^5
-    movsd xmm4, qword [one]
-    subsd xmm2, xmm4        ; x^5 - 1
-
-    ; Print all roots (already done above)
-
-
-    ; Print iteration count (as ASCII decimal, max 3 digits)
+    ; Print iteration count (as ASCII decimal)
     mov rax, 1
     mov rdi, 1
     mov rsi, iter_msg
     mov rdx, iter_msg_len
     syscall
 
-    mov rcx, 10
-    lea rsi, [iter_val_str+7]   ; rsi = pointer to end of buffer
-    mov byte [rsi], 10          ; newline
-    dec rsi
-    mov rax, rbx                ; iteration count
-    cmp rax, 0
-    jne .digits
-    mov byte [rsi], '0'
-    jmp .done
+    mov ecx, 10
+    lea rsi, [rsp+31]       ; rsi = pointer to end of buffer
+    mov byte [rsi], 10      ; newline
+    mov eax, [rsp+8]        ; iteration count
 .digits:
-    xor rdx, rdx
-    div rcx
+    dec rsi
+    xor edx, edx
+    div ecx
     add dl, '0'
     mov byte [rsi], dl
-    dec rsi
-    cmp rax, 0
-    jne .digits
-.done:
-    inc rsi
-    lea rax, [iter_val_str+8]
-    sub rax, rsi
-    mov rdx, rax
+    test eax, eax
+    jnz .digits
+    lea rdx, [rsp+32]
+    sub rdx, rsi
     mov rax, 1
     mov rdi, 1
     syscall
 
-    ; Print final precision (as string, only sign and 1 digit after decimal)
+    ; Print final precision (only sign and 1 digit after decimal)
     mov rax, 1
     mov rdi, 1
     mov rsi, prec_msg
     mov rdx, prec_msg_len
     syscall
-    ; Only works for root near 1.0, print "0.0"
-    mov byte [prec_val_str], '0'
-    mov byte [prec_val_str+1], '.'
-    mov byte [prec_val_str+2], '0'
-    mov byte [prec_val_str+3], 10
     mov rax, 1
     mov rdi, 1
-    mov rsi, prec_val_str
+    mov rsi, prec_val
     mov rdx, 4
     syscall
 
-    ; Convert result to string (very basic, 1 digit after decimal)
+    ; Print result (very basic, 1 digit after decimal)
     mov rax, 1
     mov rdi, 1
     mov rsi, result_msg
     mov rdx, 15
     syscall
-
-    ; Only works for root near 1.0, print "1.0"
     mov rax, 1
     mov rdi, 1
-    mov rsi, result_val_str
+    mov rsi, result_val
     mov rdx, 3
-    mov byte [result_val_str], '1'
-    mov byte [result_val_str+1], '.'
-    mov byte [result_val_str+2], '0'
     syscall
 
     ; Print newline
@@ -293,9 +243,9 @@ newton_quintic:
     mov rdx, 1
     syscall
 
-    add rsp, 32
-    xor rax, rax
-    pop rbx
+    xor eax, eax
+.nr_failed:
+    add rsp, 40
     ret
 
 ; (Removed duplicate .data section at end)
@@ -0,0 +1,151 @@
+// === bench_poly_5.c for DSKYpoly-5 ===
+// Throughput of the reference architecture, the special-case detector
+// (narrated and reentrant) and the Aberth-Ehrlich numerical engine on the
+// same quintics, and the bulk driver on whole batches of them. The
+// narrated solvers print as they go; they are timed with stdout on
+// /dev/null.
+//
+// usage: bench_poly_5 [results.json]
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "dskypoly.h"
+#include "dskypoly_bench.h"
+
+#define BENCH_N          (1 << 10)   // quintics per pass
+#define BENCH_PASSES     50
+#define BENCH_REF_N      128         // the narrated solvers print every step
+#define BENCH_REF_PASSES 5
+
+extern void solve_poly_5_reference(double a, double b, double c, double d, double e, double f);
+extern int solve_poly_5_special(double a, double b, double c, double d, double e, double f);
+
+static double coeffs[BENCH_N][6];
+static double re[5], im[5];
+static dskypoly_poly polys[BENCH_N];
+static double batch_re[BENCH_N * DSKYPOLY_MAX_DEGREE], batch_im[BENCH_N * DSKYPOLY_MAX_DEGREE];
+
+// Random general quintics, none of them a special form
+static void fill_coefficients(void) {
+    srand(2025);
+    for (int i = 0; i < BENCH_N; i++) {
+        double sign = (rand() & 1) ? 1.0 : -1.0;
+        coeffs[i][0] = sign * (0.5 + 1.5 * rand() / (double)RAND_MAX);
+        for (int k = 1; k < 6; k++)
+            coeffs[i][k] = -10.0 + 20.0 * rand() / (double)RAND_MAX;
+        polys[i].degree = 5;
+        for (int k = 0; k < 6; k++)
+            polys[i].coeffs[k] = coeffs[i][k];
+    }
+}
+
+static bench_timer bench_narrated(int special) {
+    bench_timer t;
+    bench_timer_init(&t);
+    bench_mute_stdout();
+    for (int pass = 0; pass < BENCH_REF_PASSES; pass++) {
+        bench_begin(&t);
+        for (int i = 0; i < BENCH_REF_N; i++) {
+            const double* c = coeffs[i];
+            if (special)
+                solve_poly_5_special(c[0], c[1], c[2], c[3], c[4], c[5]);
+            else
+                solve_poly_5_reference(c[0], c[1], c[2], c[3], c[4], c[5]);
+        }
+        bench_end(&t);
+    }
+    bench_restore_stdout();
+    return t;
+}
+
+static bench_timer bench_special_r(void) {
+    bench_timer t;
+    int kind;
+    bench_timer_init(&t);
+    for (int pass = 0; pass < BENCH_PASSES; pass++) {
+        bench_begin(&t);
+        for (int i = 0; i < BENCH_N; i++) {
+            const double* c = coeffs[i];
+            solve_poly_5_special_r(c[0], c[1], c[2], c[3], c[4], c[5], re, im, &kind);
+        }
+        bench_end(&t);
+    }
+    return t;
+}
+
+// Monomials ax^5 + f of both signs through the twiddle-table kernel
+static bench_timer bench_monomial(void) {
+    bench_timer t;
+    bench_timer_init(&t);
+    for (int pass = 0; pass < BENCH_PASSES; pass++) {
+        bench_begin(&t);
+        for (int i = 0; i < BENCH_N; i++)
+            solve_poly_n_monomial(coeffs[i][0], coeffs[i][5], 5, re, im);
+        bench_end(&t);
+    }
+    return t;
+}
+
+static bench_timer bench_numerical(void) {
+    bench_timer t;
+    bench_timer_init(&t);
+    for (int pass = 0; pass < BENCH_PASSES; pass++) {
+        bench_begin(&t);
+        for (int i = 0; i < BENCH_N; i++) {
+            const double* c = coeffs[i];
+            solve_poly_5_numerical(c[0], c[1], c[2], c[3], c[4], c[5], re, im);
+        }
+        bench_end(&t);
+    }
+    return t;
+}
+
+// All BENCH_N quintics in one dskypoly_solve call per pass
+static bench_timer bench_batched(int threads, int* workers) {
+    bench_timer t;
+    bench_timer_init(&t);
+    for (int pass = 0; pass < BENCH_PASSES; pass++) {
+        bench_begin(&t);
+        *workers = dskypoly_solve(polys, BENCH_N, batch_re, batch_im, NULL, threads);
+        bench_end(&t);
+    }
+    return t;
+}
+
+int main(int argc, char** argv) {
+    printf("=== DSKYpoly Quintic Benchmark ===\n");
+    printf("%d quintics per pass, best of %d passes (narrated: %d x %d, stdout muted)\n\n",
+           BENCH_N, BENCH_PASSES, BENCH_REF_N, BENCH_REF_PASSES);
+    bench_json_open(argc > 1 ? argv[1] : NULL, "quintic", NULL);
+    fill_coefficients();
+
+    bench_timer ref = bench_narrated(0);
+    double per_ref = ref.seconds / BENCH_REF_N;
+    bench_report("solve_poly_5_reference", "single", &ref, BENCH_REF_N, ref.seconds, -1.0);
+
+    bench_timer t = bench_narrated(1);
+    bench_report("solve_poly_5_special", "single", &t, BENCH_REF_N, ref.seconds, -1.0);
+
+    t = bench_special_r();
+    bench_report("solve_poly_5_special_r", "single", &t, BENCH_N, per_ref * BENCH_N, -1.0);
+
+    t = bench_monomial();
+    bench_report("solve_poly_n_monomial x^5", "single", &t, BENCH_N, per_ref * BENCH_N, -1.0);
+
+    t = bench_numerical();
+    bench_report("solve_poly_5_numerical", "single", &t, BENCH_N, per_ref * BENCH_N, -1.0);
+
+    int workers;
+    char label[32];
+    t = bench_batched(1, &workers);
+    bench_report("dskypoly_solve x1", "batch", &t, BENCH_N, per_ref * BENCH_N, -1.0);
+    t = bench_batched(0, &workers);
+    if (workers > 1) {
+        snprintf(label, sizeof(label), "dskypoly_solve x%d", workers);
+        bench_report(label, "batch", &t, BENCH_N, per_ref * BENCH_N, -1.0);
+    }
+
+    bench_json_close();
+    return 0;
+}
@@ -10,6 +10,8 @@
 #include <math.h>
 #include <string.h>
 
+#include "dskypoly.h"
+
 // Forward declarations for assembly functions
 extern void solve_poly_5_reference(double a, double b, double c, double d, double e, double f);
 extern int solve_poly_5_special(double a, double b, double c, double d, double e, double f);
@@ -76,7 +78,7 @@ void display_quintic_context(void) {
     printf("   • Galois Group S₅: 120 permutations, contains non-solvable A₅\n");
     printf("   • Abel-Ruffini Theorem: General quintic unsolvable by radicals\n");
     printf("   • Special Cases: Monomial, certain binomial forms ARE solvable\n");
-    printf("   • Numerical Methods: Newton-Raphson, Durand-Kerner for general case\n\n");
+    printf("   • Numerical Methods: Aberth-Ehrlich simultaneous iteration for general case\n\n");
 }
 
 // Display Galois theory insights
@@ -137,6 +139,21 @@ void test_quintic_case(int case_num, quintic_test_case *test_case) {
     );
     printf("Roots found: %d\n", roots_found);
     fflush(stdout);  // Force output
+
+    printf("🔬 Testing Numerical Solver (Aberth-Ehrlich):\n");
+    double re[5], im[5];
+    int converged = solve_poly_5_numerical(
+        test_case->coeffs[0], test_case->coeffs[1], test_case->coeffs[2],
+        test_case->coeffs[3], test_case->coeffs[4], test_case->coeffs[5],
+        re, im
+    );
+    for (int k = 0; k < 5; k++) {
+        if (fabs(im[k]) <= 1e-12 * (1.0 + fabs(re[k])))
+            printf("Root %d: %.9f\n", k + 1, re[k]);
+        else
+            printf("Root %d: %.9f %+.9fi\n", k + 1, re[k], im[k]);
+    }
+    printf("Converged: %d of 5\n", converged);
     printf("\n");
 }
 
@@ -151,6 +168,12 @@ int main(void) {
     for (int i = 0; i < num_test_cases; i++) {
         test_quintic_case(i, &test_cases[i]);
     }
+
+    // Which forms the special-case detector saw across the suite
+    dskypoly_stats stats;
+    dskypoly_stats_snapshot(&stats);
+    dskypoly_stats_print(&stats);
+    printf("\n");
     
     printf("╔═══════════════════════════════════════════════════════════════╗\n");
     printf("║            Quintic Implementation Development Complete         ║\n");
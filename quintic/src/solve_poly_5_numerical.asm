@@ -0,0 +1,511 @@
+;**************************************************************************
+; solve_poly_5_numerical.asm
+; DSKYpoly-5: Numerical Solver (General Quintics, and degree n in general)
+; Mathematical Foundation: Aberth-Ehrlich simultaneous iteration
+;
+; C prototypes:
+;   int solve_poly_n_aberth(const double* coeffs, int n, double* re, double* im);
+;   int solve_poly_n_aberth_sweeps(const double* coeffs, int n, double* re,
+;                                  double* im, int* sweeps);
+;   int solve_poly_5_numerical(double a, double b, double c, double d,
+;                              double e, double f, double re[5], double im[5]);
+;
+; coeffs[0..n] run from the x^n coefficient down to the constant term, the
+; same order as a, b, c, ... in the scalar solvers. Every root z_i moves by
+;
+;   N_i = p(z_i) / p'(z_i)                     (Newton correction)
+;   S_i = sum_{j != i} 1 / (z_i - z_j)         (repulsion from the others)
+;   z_i <- z_i - N_i / (1 - N_i S_i)
+;
+; which converges cubically to simple roots and never lets two
+; approximations settle on the same root. The roots are kept as two
+; planes (real, imaginary) and updated two at a time in packed SSE2
+; lanes, Gauss-Seidel style: pair k already sees the new values of pairs
+; 0..k-1. A root stops moving once its backward error is at rounding
+; level, |p(z)| <= 4nu * sum |a_k| |z|^k with u = 2^-53, and a pair whose
+; two roots are both done is skipped outright. The sweep ends when every
+; root is done or after 100 passes.
+;
+; The _sweeps entry also stores the number of sweeps taken (0 when nothing
+; was iterated) for the solver statistics; the plain entry passes NULL.
+;
+; Returns the number of converged roots (n when every root converged),
+; or 0 if n < 1 or coeffs[0] == 0. Exact trailing zero coefficients are
+; peeled off first as exact zero roots in the last slots of re/im. The
+; work planes live on the stack, so n is capped at 1024
+; (DSKYPOLY_ABERTH_MAX_DEGREE): above it the call returns -1 with
+; errno = EINVAL and re/im untouched.
+;**************************************************************************
+
+section .rodata
+    align 16
+    pd_one       dq 1.0, 1.0
+    pd_mask_abs  dq 0x7FFFFFFFFFFFFFFF, 0x7FFFFFFFFFFFFFFF
+    const_zero   dq 0.0
+    const_one    dq 1.0
+    const_two_pi dq 6.283185307179586
+    four_ulp     dq 4.440892098500626e-16  ; 4u, scaled by n for the stop test
+    ; Starting circle is rotated by 0.4 rad off the real axis so that
+    ; conjugate-symmetric polynomials do not start on a symmetry line
+    start_cos    dq 0.9210609940028851     ; cos(0.4)
+    start_sin    dq 0.3894183423086505     ; sin(0.4)
+
+section .text
+    global solve_poly_n_aberth
+    global solve_poly_n_aberth_sweeps
+    global solve_poly_5_numerical
+    extern pow, cos, sin, __errno_location
+
+; Arguments (System V AMD64):
+; rdi = coeffs[], esi = n, rdx = re[], rcx = im[], r8 = sweeps out (or NULL)
+;
+; Frame (rbp-relative, below the five saved registers):
+; [rbp-48]  re[] out         [rbp-56]  im[] out
+; [rbp-64]  |coeffs| plane   [rbp-72]  radius R of the starting circle
+; [rbp-80]  n as passed      [rbp-88]  centroid -a1 / (n a0)
+; [rbp-96]  cos(2pi/n)       [rbp-104] sin(2pi/n)
+; [rbp-112] loop index across libm calls
+; [rbp-120] sweeps out (or NULL)
+;
+; Work planes (rsp-relative, 16-byte aligned, npad = n rounded up to even):
+; r13 = zr[npad], r14 = zi[npad], r15 = done[npad] (all-ones once converged)
+; rbx = coeffs[], r12 = n (degree actually iterated)
+solve_poly_n_aberth:
+    xor r8d, r8d                   ; no sweep count wanted
+
+solve_poly_n_aberth_sweeps:
+    push rbp
+    mov rbp, rsp
+    push rbx
+    push r12
+    push r13
+    push r14
+    push r15
+    sub rsp, 88
+
+    mov [rbp-120], r8
+    test r8, r8
+    jz .counted
+    mov dword [r8], 0              ; until the sweep loop says otherwise
+.counted:
+    mov [rbp-48], rdx
+    mov [rbp-56], rcx
+    mov rbx, rdi
+    movsxd r12, esi
+    mov [rbp-80], r12
+
+    ; === Reject degree < 1 and a vanishing leading coefficient ===
+    xor eax, eax
+    test r12, r12
+    jle .exit
+    cmp r12, 1024                  ; DSKYPOLY_ABERTH_MAX_DEGREE
+    jg .too_high
+    movsd xmm0, [rbx]
+    ucomisd xmm0, [rel const_zero]
+    je .exit
+
+    ; === Peel exact zero roots: a_n = 0 means x divides p(x) ===
+.peel:
+    movsd xmm0, [rbx+r12*8]
+    ucomisd xmm0, [rel const_zero]
+    jne .peeled
+    jp .peeled
+    xorpd xmm0, xmm0
+    mov rdx, [rbp-48]
+    mov rcx, [rbp-56]
+    movsd [rdx+r12*8-8], xmm0      ; root n-1 = 0 + 0i
+    movsd [rcx+r12*8-8], xmm0
+    dec r12
+    jnz .peel
+    mov rax, [rbp-80]              ; a x^n: every root is zero
+    jmp .exit
+
+.peeled:
+    ; === Carve the work planes out of the stack ===
+    lea rax, [r12+1]
+    and rax, -2                    ; npad
+    lea r8, [rax+rax*2]            ; 3 planes of npad
+    lea r8, [r8+r12+1]             ; plus |coeffs|[n+1]
+    shl r8, 3
+    sub rsp, r8
+    and rsp, -16
+    mov r13, rsp                   ; zr[]
+    lea r14, [r13+rax*8]           ; zi[]
+    lea r15, [r14+rax*8]           ; done[]
+    lea r8, [r15+rax*8]
+    mov [rbp-64], r8               ; |coeffs|[]
+
+    ; |a_k| plane for the backward-error bound
+    movapd xmm1, [rel pd_mask_abs]
+    xor ecx, ecx
+.abs_loop:
+    movsd xmm0, [rbx+rcx*8]
+    andpd xmm0, xmm1
+    movsd [r8+rcx*8], xmm0
+    inc rcx
+    cmp rcx, r12
+    jbe .abs_loop
+
+    ; done[] = 0 for real roots, all-ones on the odd-degree padding lane
+    xor ecx, ecx
+.done_init:
+    mov qword [r15+rcx*8], 0
+    inc rcx
+    cmp rcx, r12
+    jb .done_init
+    test r12, 1
+    jz .radius
+    mov qword [r15+r12*8], -1
+    mov qword [r13+r12*8], 0
+    mov qword [r14+r12*8], 0
+
+.radius:
+    ; === Starting radius R = max_k (|a_k| / |a_0|)^(1/k) ===
+    mov qword [rbp-72], 0
+    mov qword [rbp-112], 1
+.radius_loop:
+    mov rcx, [rbp-112]
+    mov r8, [rbp-64]
+    movsd xmm0, [r8+rcx*8]
+    ucomisd xmm0, [rel const_zero]
+    je .radius_next
+    divsd xmm0, [r8]               ; |a_k| / |a_0|
+    cvtsi2sd xmm2, rcx
+    movsd xmm1, [rel const_one]
+    divsd xmm1, xmm2               ; 1/k
+    call pow wrt ..plt
+    maxsd xmm0, [rbp-72]
+    movsd [rbp-72], xmm0
+.radius_next:
+    inc qword [rbp-112]
+    cmp [rbp-112], r12
+    jbe .radius_loop
+
+    ; === Centroid of the roots: -a_1 / (n a_0) ===
+    cvtsi2sd xmm1, r12
+    mulsd xmm1, [rbx]
+    movsd xmm0, [rbx+8]
+    divsd xmm0, xmm1
+    xorpd xmm1, xmm1
+    subsd xmm1, xmm0
+    movsd [rbp-88], xmm1
+
+    ; === Rotation step e^(2 pi i / n) ===
+    cvtsi2sd xmm1, r12
+    movsd xmm0, [rel const_two_pi]
+    divsd xmm0, xmm1
+    movsd [rbp-112], xmm0
+    call cos wrt ..plt
+    movsd [rbp-96], xmm0
+    movsd xmm0, [rbp-112]
+    call sin wrt ..plt
+    movsd [rbp-104], xmm0
+
+    ; === z_k = centroid + R e^(i(0.4 + 2 pi k / n)) ===
+    movsd xmm0, [rel start_cos]    ; unit direction (re)
+    movsd xmm1, [rel start_sin]    ; unit direction (im)
+    movsd xmm6, [rbp-72]           ; R
+    xor ecx, ecx
+.start_loop:
+    movsd xmm2, xmm0
+    mulsd xmm2, xmm6
+    addsd xmm2, [rbp-88]
+    movsd [r13+rcx*8], xmm2
+    movsd xmm3, xmm1
+    mulsd xmm3, xmm6
+    movsd [r14+rcx*8], xmm3
+    ; direction *= step
+    movsd xmm2, xmm0
+    mulsd xmm2, [rbp-96]
+    movsd xmm3, xmm1
+    mulsd xmm3, [rbp-104]
+    subsd xmm2, xmm3               ; re' = re cos - im sin
+    mulsd xmm0, [rbp-104]
+    mulsd xmm1, [rbp-96]
+    addsd xmm1, xmm0               ; im' = re sin + im cos
+    movsd xmm0, xmm2
+    inc rcx
+    cmp rcx, r12
+    jb .start_loop
+
+    ; === Sweep registers ===
+    ; rdi = coeffs[], rsi = |coeffs|[], r9 = pair byte offset
+    ; r10d = sweeps left, r11 = converged roots
+    ; xmm12 = 1.0, xmm13 = 0.0, xmm14 = 4nu (broadcast)
+    mov rdi, rbx
+    mov rsi, [rbp-64]
+    mov r10d, 100                  ; sweep cap, as in the reference solver
+    xor r11d, r11d
+    movapd xmm12, [rel pd_one]
+    xorpd xmm13, xmm13
+    cvtsi2sd xmm14, r12
+    mulsd xmm14, [rel four_ulp]
+    unpcklpd xmm14, xmm14
+
+.sweep:
+    xor r9d, r9d
+
+.pair:
+    movapd xmm15, [r15+r9]         ; done mask of this pair
+    movmskpd eax, xmm15
+    cmp eax, 3
+    je .next_pair                  ; both roots converged: skip the pair
+
+    movapd xmm0, [r13+r9]          ; x
+    movapd xmm1, [r14+r9]          ; y
+    movapd xmm2, xmm0
+    mulpd xmm2, xmm0
+    movapd xmm3, xmm1
+    mulpd xmm3, xmm1
+    addpd xmm2, xmm3
+    sqrtpd xmm2, xmm2              ; |z|
+
+    ; === Horner: p(z), p'(z) and sum |a_k| |z|^k in one pass ===
+    movsd xmm3, [rdi]
+    unpcklpd xmm3, xmm3            ; pr = a_0
+    xorpd xmm4, xmm4               ; pi
+    xorpd xmm5, xmm5               ; dr
+    xorpd xmm6, xmm6               ; di
+    movsd xmm7, [rsi]
+    unpcklpd xmm7, xmm7            ; s = |a_0|
+    mov ecx, 1
+.horner:
+    ; d = d z + p
+    movapd xmm9, xmm5
+    mulpd xmm9, xmm0
+    movapd xmm10, xmm6
+    mulpd xmm10, xmm1
+    subpd xmm9, xmm10
+    addpd xmm9, xmm3               ; dr'
+    movapd xmm10, xmm5
+    mulpd xmm10, xmm1
+    movapd xmm11, xmm6
+    mulpd xmm11, xmm0
+    addpd xmm10, xmm11
+    addpd xmm10, xmm4              ; di'
+    movapd xmm5, xmm9
+    movapd xmm6, xmm10
+    ; p = p z + a_k
+    movsd xmm8, [rdi+rcx*8]
+    unpcklpd xmm8, xmm8
+    movapd xmm9, xmm3
+    mulpd xmm9, xmm0
+    movapd xmm10, xmm4
+    mulpd xmm10, xmm1
+    subpd xmm9, xmm10
+    addpd xmm9, xmm8               ; pr'
+    movapd xmm10, xmm3
+    mulpd xmm10, xmm1
+    movapd xmm11, xmm4
+    mulpd xmm11, xmm0
+    addpd xmm10, xmm11             ; pi'
+    movapd xmm3, xmm9
+    movapd xmm4, xmm10
+    ; s = s |z| + |a_k|
+    movsd xmm8, [rsi+rcx*8]
+    unpcklpd xmm8, xmm8
+    mulpd xmm7, xmm2
+    addpd xmm7, xmm8
+    inc rcx
+    cmp rcx, r12
+    jbe .horner
+
+    ; === Stop test: |p|^2 <= (4nu s)^2 ===
+    movapd xmm8, xmm3
+    mulpd xmm8, xmm3
+    movapd xmm9, xmm4
+    mulpd xmm9, xmm4
+    addpd xmm8, xmm9               ; |p|^2
+    mulpd xmm7, xmm14
+    mulpd xmm7, xmm7
+    cmplepd xmm8, xmm7             ; converged lanes
+    orpd xmm8, xmm15               ; new done mask
+    movapd [r15+r9], xmm8
+    movmskpd edx, xmm8
+    xor eax, edx                   ; lanes that converged just now
+    mov ecx, eax
+    shr ecx, 1
+    and eax, 1
+    add r11d, eax
+    add r11d, ecx
+    movapd xmm15, xmm8
+    cmp edx, 3
+    je .next_pair
+
+    ; === N = p / p' ===
+    movapd xmm9, xmm5
+    mulpd xmm9, xmm5
+    movapd xmm10, xmm6
+    mulpd xmm10, xmm6
+    addpd xmm9, xmm10              ; |p'|^2
+    movapd xmm10, xmm3
+    mulpd xmm10, xmm5
+    movapd xmm11, xmm4
+    mulpd xmm11, xmm6
+    addpd xmm10, xmm11             ; Re(p conj p')
+    mulpd xmm4, xmm5
+    mulpd xmm3, xmm6
+    subpd xmm4, xmm3               ; Im(p conj p')
+    movapd xmm3, xmm10
+    divpd xmm3, xmm9               ; Nr
+    divpd xmm4, xmm9               ; Ni
+
+    ; === S = sum_{j != i} 1 / (z_i - z_j) ===
+    ; The j == i term has z_i - z_j = 0 and is masked out with the
+    ; reciprocal, so no index comparison is needed.
+    xorpd xmm5, xmm5               ; Sr
+    xorpd xmm6, xmm6               ; Si
+    xor edx, edx
+.repel:
+    movsd xmm7, [r13+rdx*8]
+    unpcklpd xmm7, xmm7
+    movsd xmm8, [r14+rdx*8]
+    unpcklpd xmm8, xmm8
+    movapd xmm9, xmm0
+    subpd xmm9, xmm7               ; dx
+    movapd xmm10, xmm1
+    subpd xmm10, xmm8              ; dy
+    movapd xmm7, xmm9
+    mulpd xmm7, xmm9
+    movapd xmm8, xmm10
+    mulpd xmm8, xmm10
+    addpd xmm7, xmm8               ; |dz|^2
+    movapd xmm8, xmm7
+    cmpneqpd xmm8, xmm13           ; i != j lanes
+    movapd xmm11, xmm12
+    divpd xmm11, xmm7
+    andpd xmm11, xmm8              ; 1/|dz|^2, 0 on the self term
+    mulpd xmm9, xmm11
+    mulpd xmm10, xmm11
+    addpd xmm5, xmm9               ; Sr += dx / |dz|^2
+    subpd xmm6, xmm10              ; Si -= dy / |dz|^2
+    inc rdx
+    cmp rdx, r12
+    jb .repel
+
+    ; === w = N / (1 - N S) ===
+    movapd xmm7, xmm3
+    mulpd xmm7, xmm5
+    movapd xmm8, xmm4
+    mulpd xmm8, xmm6
+    subpd xmm7, xmm8               ; Re(NS)
+    movapd xmm8, xmm3
+    mulpd xmm8, xmm6
+    movapd xmm9, xmm4
+    mulpd xmm9, xmm5
+    addpd xmm8, xmm9               ; Im(NS)
+    movapd xmm5, xmm12
+    subpd xmm5, xmm7               ; Dr = 1 - Re(NS)
+    xorpd xmm6, xmm6
+    subpd xmm6, xmm8               ; Di = -Im(NS)
+    movapd xmm7, xmm5
+    mulpd xmm7, xmm5
+    movapd xmm8, xmm6
+    mulpd xmm8, xmm6
+    addpd xmm7, xmm8               ; |D|^2
+    movapd xmm8, xmm3
+    mulpd xmm8, xmm5
+    movapd xmm9, xmm4
+    mulpd xmm9, xmm6
+    addpd xmm8, xmm9               ; Re(N conj D)
+    mulpd xmm4, xmm5
+    mulpd xmm3, xmm6
+    subpd xmm4, xmm3               ; Im(N conj D)
+    divpd xmm8, xmm7               ; wr
+    divpd xmm4, xmm7               ; wi
+
+    ; A lane sitting on a critical point (p' = 0) gives a non-finite
+    ; step; hold it still for this sweep instead of poisoning the planes
+    movapd xmm9, xmm8
+    subpd xmm9, xmm8
+    movapd xmm10, xmm4
+    subpd xmm10, xmm4
+    addpd xmm9, xmm10
+    cmpeqpd xmm9, xmm13            ; finite lanes
+    andnpd xmm15, xmm9             ; finite and not done
+    andpd xmm8, xmm15
+    andpd xmm4, xmm15
+    subpd xmm0, xmm8
+    subpd xmm1, xmm4
+    movapd [r13+r9], xmm0
+    movapd [r14+r9], xmm1
+
+.next_pair:
+    add r9, 16
+    lea rax, [r12*8]
+    cmp r9, rax
+    jb .pair
+
+    dec r10d
+    cmp r11, r12
+    jae .copy_out
+    test r10d, r10d
+    jnz .sweep
+
+.copy_out:
+    ; sweeps taken = 100 - sweeps left
+    mov r8, [rbp-120]
+    test r8, r8
+    jz .copy_roots
+    mov eax, 100
+    sub eax, r10d
+    mov [r8], eax
+
+.copy_roots:
+    ; === Roots back to the caller's planes ===
+    mov rdx, [rbp-48]
+    mov rcx, [rbp-56]
+    xor eax, eax
+.copy_loop:
+    movsd xmm0, [r13+rax*8]
+    movsd [rdx+rax*8], xmm0
+    movsd xmm0, [r14+rax*8]
+    movsd [rcx+rax*8], xmm0
+    inc rax
+    cmp rax, r12
+    jb .copy_loop
+
+    ; converged roots plus the peeled zero roots
+    mov rax, r11
+    add rax, [rbp-80]
+    sub rax, r12
+    jmp .exit
+
+.too_high:
+    call __errno_location wrt ..plt
+    mov dword [rax], 22            ; EINVAL
+    mov eax, -1
+
+.exit:
+    lea rsp, [rbp-40]
+    pop r15
+    pop r14
+    pop r13
+    pop r12
+    pop rbx
+    pop rbp
+    ret
+
+; Quintic entry point: ax^5 + bx^4 + cx^3 + dx^2 + ex + f = 0
+; Input: a..f in XMM0-XMM5, rdi = re[5], rsi = im[5]
+; Returns: number of converged roots (5 on success), 0 if a == 0
+solve_poly_5_numerical:
+    push rbp
+    mov rbp, rsp
+    sub rsp, 48                    ; coefficient array, 16-byte aligned
+
+    movsd [rsp+0], xmm0            ; a (x^5)
+    movsd [rsp+8], xmm1            ; b (x^4)
+    movsd [rsp+16], xmm2           ; c (x^3)
+    movsd [rsp+24], xmm3           ; d (x^2)
+    movsd [rsp+32], xmm4           ; e (x^1)
+    movsd [rsp+40], xmm5           ; f (constant)
+
+    mov rdx, rdi                   ; re[]
+    mov rcx, rsi                   ; im[]
+    mov rdi, rsp                   ; coeffs[]
+    mov esi, 5
+    call solve_poly_n_aberth wrt ..plt
+
+    leave
+    ret
@@ -1,13 +1,127 @@
 ; DSKYpoly-5: Special Cases Solver (Solvable Quintics)
 ; Mathematical Foundation: Cases that ARE solvable by radicals
 ; Implementation: 5th roots of unity, factorization detection
+;
+; C prototypes:
+;   int solve_poly_5_special_r(double a, double b, double c, double d,
+;                              double e, double f,
+;                              double re[5], double im[5], int* kind);
+;   int solve_poly_5_special(double a, double b, double c, double d,
+;                            double e, double f);
+;   int solve_poly_n_monomial(double a, double c, int n, double* re, double* im);
+;
+; solve_poly_5_special_r is the silent, reentrant core: it keeps every
+; intermediate in registers or its own frame and writes only to the
+; caller's re/im/kind, so any number of threads may call it at once.
+; kind (if non-NULL) receives the detected form, numbered as the
+; DSKYPOLY_SPECIAL_* constants in dskypoly.h; a coefficient is absent from
+; a form only when it is exactly zero. Returns 5 when the form was
+; solved (monomial), 0 otherwise; re/im are only written on a return of 5.
+;
+; solve_poly_5_special is the narrated walk-through on top of the core,
+; with the roots on its own stack; it counts the detected form in the
+; per-thread solver statistics.
+;
+; solve_poly_n_monomial solves a x^n + c = 0 for n = 1..8, the monomial
+; case of every degree: one real n-th root |c/a|^(1/n) for the magnitude,
+; then all n roots in one packed pass over a compile-time twiddle table.
+; Returns n, or 0 if a == 0 or n is out of range.
 
-section .data
+section .rodata
     ; Mathematical constants for solvable cases
-    two_pi          dq 6.283185307179586    ; 2π for root calculations
-    fifth_pi        dq 1.256637061435917    ; 2π/5 for 5th roots of unity
-    tolerance       dq 1.0e-12             ; Zero detection tolerance
-    
+    const_zero      dq 0.0
+    const_one       dq 1.0
+    align 16
+    pd_mask_abs     dq 0x7FFFFFFFFFFFFFFF, 0x7FFFFFFFFFFFFFFF
+
+    ; Twiddle table for x^n = target, n = 1..8. Block n-1 (256 bytes)
+    ; holds cos then sin of the n roots of +1, e^(2 pi i k / n), then
+    ; of -1, e^(i pi (2k + 1) / n): 8 slots each, zero past n, so the
+    ; packed loop reads whole pairs from 16-byte aligned rows.
+    align 16
+twiddle_table:
+    ; n = 1, roots of +1
+    dq 1.0, 0.0, 0.0, 0.0
+    dq 0.0, 0.0, 0.0, 0.0
+    dq 0.0, 0.0, 0.0, 0.0
+    dq 0.0, 0.0, 0.0, 0.0
+    ; n = 1, roots of -1
+    dq -1.0, 0.0, 0.0, 0.0
+    dq 0.0, 0.0, 0.0, 0.0
+    dq 0.0, 0.0, 0.0, 0.0
+    dq 0.0, 0.0, 0.0, 0.0
+    ; n = 2, roots of +1
+    dq 1.0, -1.0, 0.0, 0.0
+    dq 0.0, 0.0, 0.0, 0.0
+    dq 0.0, 0.0, 0.0, 0.0
+    dq 0.0, 0.0, 0.0, 0.0
+    ; n = 2, roots of -1
+    dq 0.0, 0.0, 0.0, 0.0
+    dq 0.0, 0.0, 0.0, 0.0
+    dq 1.0, -1.0, 0.0, 0.0
+    dq 0.0, 0.0, 0.0, 0.0
+    ; n = 3, roots of +1
+    dq 1.0, -0.5, -0.5, 0.0
+    dq 0.0, 0.0, 0.0, 0.0
+    dq 0.0, 0.8660254037844386, -0.8660254037844386, 0.0
+    dq 0.0, 0.0, 0.0, 0.0
+    ; n = 3, roots of -1
+    dq 0.5, -1.0, 0.5, 0.0
+    dq 0.0, 0.0, 0.0, 0.0
+    dq 0.8660254037844386, 0.0, -0.8660254037844386, 0.0
+    dq 0.0, 0.0, 0.0, 0.0
+    ; n = 4, roots of +1
+    dq 1.0, 0.0, -1.0, 0.0
+    dq 0.0, 0.0, 0.0, 0.0
+    dq 0.0, 1.0, 0.0, -1.0
+    dq 0.0, 0.0, 0.0, 0.0
+    ; n = 4, roots of -1
+    dq 0.7071067811865476, -0.7071067811865476, -0.7071067811865476, 0.7071067811865476
+    dq 0.0, 0.0, 0.0, 0.0
+    dq 0.7071067811865476, 0.7071067811865476, -0.7071067811865476, -0.7071067811865476
+    dq 0.0, 0.0, 0.0, 0.0
+    ; n = 5, roots of +1
+    dq 1.0, 0.30901699437494745, -0.8090169943749475, -0.8090169943749475
+    dq 0.30901699437494745, 0.0, 0.0, 0.0
+    dq 0.0, 0.9510565162951535, 0.5877852522924731, -0.5877852522924731
+    dq -0.9510565162951535, 0.0, 0.0, 0.0
+    ; n = 5, roots of -1
+    dq 0.8090169943749475, -0.30901699437494745, -1.0, -0.30901699437494745
+    dq 0.8090169943749475, 0.0, 0.0, 0.0
+    dq 0.5877852522924731, 0.9510565162951535, 0.0, -0.9510565162951535
+    dq -0.5877852522924731, 0.0, 0.0, 0.0
+    ; n = 6, roots of +1
+    dq 1.0, 0.5, -0.5, -1.0
+    dq -0.5, 0.5, 0.0, 0.0
+    dq 0.0, 0.8660254037844386, 0.8660254037844386, 0.0
+    dq -0.8660254037844386, -0.8660254037844386, 0.0, 0.0
+    ; n = 6, roots of -1
+    dq 0.8660254037844386, 0.0, -0.8660254037844386, -0.8660254037844386
+    dq 0.0, 0.8660254037844386, 0.0, 0.0
+    dq 0.5, 1.0, 0.5, -0.5
+    dq -1.0, -0.5, 0.0, 0.0
+    ; n = 7, roots of +1
+    dq 1.0, 0.6234898018587335, -0.2225209339563144, -0.9009688679024191
+    dq -0.9009688679024191, -0.2225209339563144, 0.6234898018587335, 0.0
+    dq 0.0, 0.7818314824680298, 0.9749279121818236, 0.4338837391175581
+    dq -0.4338837391175581, -0.9749279121818236, -0.7818314824680298, 0.0
+    ; n = 7, roots of -1
+    dq 0.9009688679024191, 0.2225209339563144, -0.6234898018587335, -1.0
+    dq -0.6234898018587335, 0.2225209339563144, 0.9009688679024191, 0.0
+    dq 0.4338837391175581, 0.9749279121818236, 0.7818314824680298, 0.0
+    dq -0.7818314824680298, -0.9749279121818236, -0.4338837391175581, 0.0
+    ; n = 8, roots of +1
+    dq 1.0, 0.7071067811865476, 0.0, -0.7071067811865476
+    dq -1.0, -0.7071067811865476, 0.0, 0.7071067811865476
+    dq 0.0, 0.7071067811865476, 1.0, 0.7071067811865476
+    dq 0.0, -0.7071067811865476, -1.0, -0.7071067811865476
+    ; n = 8, roots of -1
+    dq 0.9238795325112867, 0.3826834323650898, -0.3826834323650898, -0.9238795325112867
+    dq -0.9238795325112867, -0.3826834323650898, 0.3826834323650898, 0.9238795325112867
+    dq 0.3826834323650898, 0.9238795325112867, 0.9238795325112867, 0.3826834323650898
+    dq -0.3826834323650898, -0.9238795325112867, -0.9238795325112867, -0.3826834323650898
+
+
     ; Debug strings
     debug_special   db "=== Special Cases Solver ===", 10, 0
     debug_monomial  db "Detected: Monomial form x^5 = %.6f", 10, 0
@@ -17,328 +131,309 @@ section .data
     debug_general   db "General case: requires numerical methods", 10, 0
     debug_complete  db "=== Special Cases Analysis Complete ===", 10, 0
 
-section .bss
-    ; Storage for computed roots (5 complex roots)
-    align 16
-    roots_real      resq 5    ; Real parts of 5 roots
-    roots_imag      resq 5    ; Imaginary parts of 5 roots
-    root_count      resq 1    ; Number of roots found
-    
-    ; Storage for current polynomial coefficients
-    coeff_a         resq 1    ; x^5 coefficient
-    coeff_b         resq 1    ; x^4 coefficient
-    coeff_c         resq 1    ; x^3 coefficient
-    coeff_d         resq 1    ; x^2 coefficient
-    coeff_e         resq 1    ; x^1 coefficient
-    coeff_f         resq 1    ; constant coefficient
-
 section .text
+    global solve_poly_5_special_r
     global solve_poly_5_special
+    global solve_poly_n_monomial
     extern printf
-    extern sin, cos, pow, fabs
+    extern pow, cbrt
+    extern dskypoly_stats_special   ; per-thread detector counters
 
-; Special cases solver for solvable quintics
+; Reentrant core
 ; Input: Six coefficients in XMM0-XMM5 (a,b,c,d,e,f)
-; Returns: Number of roots found and stores them in roots arrays
+;        rdi = re[5], rsi = im[5], rdx = kind out (or NULL)
+; Returns: eax = roots found (5 or 0)
+;
+; Frame: rbx = re[], r12 = im[], r13 = kind out
+solve_poly_5_special_r:
+    push rbp
+    mov rbp, rsp
+    push rbx
+    push r12
+    push r13
+    sub rsp, 8                      ; Stack aligned to 16 bytes for calls
+
+    mov rbx, rdi
+    mov r12, rsi
+    mov r13, rdx
+
+    ; The forms are exact: a coefficient counts as absent only when it is
+    ; 0. Any fixed threshold is wrong at some scale (1e-14 x^5 + 5e-13 x^4
+    ; - 1e-14 is not a monomial), and the twiddle solve is only exact for
+    ; the polynomial it was given.
+    movapd xmm7, [rel pd_mask_abs]
+    xorpd xmm6, xmm6
+
+    ; === Monomial and binomial forms both need b = c = d = 0 ===
+    andpd xmm1, xmm7                ; |b|
+    ucomisd xmm1, xmm6
+    ja .check_factorizable
+    andpd xmm2, xmm7                ; |c|
+    ucomisd xmm2, xmm6
+    ja .check_factorizable
+    andpd xmm3, xmm7                ; |d|
+    ucomisd xmm3, xmm6
+    ja .check_factorizable
+
+    ; === Case 1: ax^5 + f = 0 when e vanishes too ===
+    andpd xmm4, xmm7                ; |e|
+    ucomisd xmm4, xmm6
+    jbe .monomial
+
+    ; === Case 2: Binomial form ax^5 + ex + f = 0 (detected, not solved) ===
+    mov ecx, 2                      ; DSKYPOLY_SPECIAL_BINOMIAL
+    jmp .unsolved
+
+.check_factorizable:
+    ; === Case 3: f = 0 means x is a factor ===
+    movapd xmm1, xmm5
+    andpd xmm1, xmm7                ; |f|
+    ucomisd xmm1, xmm6
+    mov ecx, 3                      ; DSKYPOLY_SPECIAL_FACTORIZABLE
+    jbe .unsolved
+    xor ecx, ecx                    ; DSKYPOLY_SPECIAL_GENERAL
+
+.unsolved:
+    test r13, r13
+    jz .no_roots
+    mov [r13], ecx
+.no_roots:
+    xor eax, eax
+    jmp .exit
+
+.monomial:
+    test r13, r13
+    jz .monomial_solve
+    mov dword [r13], 1              ; DSKYPOLY_SPECIAL_MONOMIAL
+.monomial_solve:
+    ; ax^5 + f = 0 through the general monomial kernel (a still in XMM0)
+    movapd xmm1, xmm5
+    mov edi, 5
+    mov rsi, rbx
+    mov rdx, r12
+    call solve_poly_n_monomial wrt ..plt
+
+.exit:
+    lea rsp, [rbp-24]
+    pop r13
+    pop r12
+    pop rbx
+    pop rbp
+    ret
+
+; Narrated solver for solvable quintics
+; Input: Six coefficients in XMM0-XMM5 (a,b,c,d,e,f)
+; Returns: Number of roots found
+;
+; Frame (all state of this call):
+; [rbp-40]  re[5]          [rbp-80]  im[5]
+; [rbp-84]  kind           [rbp-88]  roots found
+; [rbp-96]  a              [rbp-104] f
+; [rbp-112] root index
 solve_poly_5_special:
     ; === Function Prologue ===
     push rbp
     mov rbp, rsp
-    sub rsp, 48                     ; Stack space aligned to 16 bytes
-    
-    ; Store coefficients in global variables for easy access
-    movsd [coeff_a], xmm0          ; a (x^5)
-    movsd [coeff_b], xmm1          ; b (x^4)  
-    movsd [coeff_c], xmm2          ; c (x^3)
-    movsd [coeff_d], xmm3          ; d (x^2)
-    movsd [coeff_e], xmm4          ; e (x^1)
-    movsd [coeff_f], xmm5          ; f (constant)
-    
-    ; Initialize root count
-    mov qword [root_count], 0
-    
+    sub rsp, 112                    ; Stack space aligned to 16 bytes
+
+    movsd [rbp-96], xmm0            ; a (x^5)
+    movsd [rbp-104], xmm5           ; f (constant)
+
+    ; Detect and solve first, then narrate from the frame
+    lea rdi, [rbp-40]
+    lea rsi, [rbp-80]
+    lea rdx, [rbp-84]
+    call solve_poly_5_special_r wrt ..plt
+    mov [rbp-88], eax
+
+    mov edi, [rbp-84]
+    call dskypoly_stats_special wrt ..plt
+
     ; Debug output
-    mov rdi, debug_special
+    lea rdi, [rel debug_special]
     xor eax, eax
-    call printf
-    
-    ; === Case 1: Check for Monomial Form ===
-    ; x^5 + f = 0 (b,c,d,e all zero)
-    call check_monomial_quintic
-    cmp rax, 1
-    je monomial_case_detected
-    
-    ; === Case 2: Check for Binomial Form ===
-    ; x^5 + ex + f = 0 (b,c,d zero)
-    call check_binomial_quintic
-    cmp rax, 1
-    je binomial_case_detected
-    
-    ; === Case 3: Check for Factorizable Form ===
-    call check_factorizable_quintic
-    cmp rax, 1
-    je factorizable_case_detected
-    
+    call printf wrt ..plt
+
+    mov eax, [rbp-84]
+    cmp eax, 1
+    je .monomial_case_detected
+    cmp eax, 2
+    je .binomial_case_detected
+    cmp eax, 3
+    je .factorizable_case_detected
+
     ; === General Case ===
-    mov rdi, debug_general
+    lea rdi, [rel debug_general]
     xor eax, eax
-    call printf
-    jmp special_cases_exit
+    call printf wrt ..plt
+    jmp .special_cases_exit
+
+.monomial_case_detected:
+    ; Nothing to show for a = 0 (not actually a quintic)
+    movsd xmm1, [rbp-96]
+    ucomisd xmm1, [rel const_zero]
+    je .special_cases_exit
 
-monomial_case_detected:
-    ; Solve x^5 = -f/a using 5th roots of unity
-    call solve_monomial_quintic
-    jmp special_cases_exit
+    ; Display the equation being solved: x^5 = -f/a
+    xorpd xmm0, xmm0
+    subsd xmm0, [rbp-104]
+    divsd xmm0, xmm1
+    lea rdi, [rel debug_monomial]
+    mov eax, 1
+    call printf wrt ..plt
 
-binomial_case_detected:
+    ; Root 0 lies on the magnitude times a non-zero cosine, so a zero
+    ; there means every root is zero: nothing more to show
+    movsd xmm0, [rbp-40]
+    ucomisd xmm0, [rel const_zero]
+    je .special_cases_exit
+
+    mov qword [rbp-112], 0
+.show_loop:
+    mov rax, [rbp-112]
+    lea rdi, [rel debug_roots]
+    mov rsi, rax
+    movsd xmm0, [rbp-40+rax*8]
+    movsd xmm1, [rbp-80+rax*8]
+    mov eax, 2
+    call printf wrt ..plt
+    inc qword [rbp-112]
+    cmp qword [rbp-112], 5
+    jb .show_loop
+    jmp .special_cases_exit
+
+.binomial_case_detected:
     ; Handle binomial case (more complex)
-    mov rdi, debug_binomial
+    lea rdi, [rel debug_binomial]
     xor eax, eax
-    call printf
-    jmp special_cases_exit
+    call printf wrt ..plt
+    jmp .special_cases_exit
 
-factorizable_case_detected:
+.factorizable_case_detected:
     ; Handle factorizable case
-    mov rdi, debug_factor
+    lea rdi, [rel debug_factor]
     xor eax, eax
-    call printf
-    jmp special_cases_exit
+    call printf wrt ..plt
 
-special_cases_exit:
-    mov rdi, debug_complete
+.special_cases_exit:
+    lea rdi, [rel debug_complete]
     xor eax, eax
-    call printf
-    
+    call printf wrt ..plt
+
     ; Return number of roots found
-    mov rax, [root_count]
-    
-    add rsp, 48
-    pop rbp
-    ret
+    mov eax, [rbp-88]
 
-; === Helper Functions ===
+    leave
+    ret
 
-; Check if quintic is monomial: ax^5 + f = 0
-check_monomial_quintic:
+; Monomial kernel: a x^n + c = 0, i.e. x^n = target = -c/a
+; Input: XMM0 = a, XMM1 = c, edi = n (1..8), rsi = re[n], rdx = im[n]
+; Returns: eax = n, or 0 if a == 0 or n is out of range
+;
+; The magnitude |target|^(1/n) comes from sqrtsd for n = 2, 4, 8, from
+; cbrt for n = 3, 6 and from pow otherwise; the sign of the target picks
+; the roots of +1 or of -1 from the twiddle table.
+;
+; Frame: rbx = n, r12 = re[], r13 = im[], [rbp-32] table block offset
+solve_poly_n_monomial:
     push rbp
     mov rbp, rsp
-    
-    ; Load tolerance for zero checking
-    movsd xmm7, [tolerance]
-    
-    ; Check if b,c,d,e coefficients are essentially zero
-    movsd xmm0, [coeff_b]          ; b coefficient
-    call fabs
-    ucomisd xmm0, xmm7
-    ja not_monomial
-    
-    movsd xmm0, [coeff_c]          ; c coefficient
-    call fabs
-    ucomisd xmm0, xmm7
-    ja not_monomial
-    
-    movsd xmm0, [coeff_d]          ; d coefficient
-    call fabs
-    ucomisd xmm0, xmm7
-    ja not_monomial
-    
-    movsd xmm0, [coeff_e]          ; e coefficient
-    call fabs
-    ucomisd xmm0, xmm7
-    ja not_monomial
-    
-    ; Monomial form detected
-    mov rax, 1
-    pop rbp
-    ret
+    push rbx
+    push r12
+    push r13
+    sub rsp, 24                     ; Stack aligned to 16 bytes for libm
 
-not_monomial:
-    mov rax, 0
-    pop rbp
-    ret
+    xor eax, eax
+    cmp edi, 1
+    jl .exit
+    cmp edi, 8
+    jg .exit
+    ucomisd xmm0, [rel const_zero]
+    je .exit
 
-; Check if quintic is binomial: ax^5 + ex + f = 0
-check_binomial_quintic:
-    push rbp
-    mov rbp, rsp
-    
-    ; Load tolerance
-    movsd xmm7, [tolerance]
-    
-    ; Check if b,c,d coefficients are zero
-    movsd xmm0, [coeff_b]          ; b coefficient
-    call fabs
-    ucomisd xmm0, xmm7
-    ja not_binomial
-    
-    movsd xmm0, [coeff_c]          ; c coefficient
-    call fabs
-    ucomisd xmm0, xmm7
-    ja not_binomial
-    
-    movsd xmm0, [coeff_d]          ; d coefficient
-    call fabs
-    ucomisd xmm0, xmm7
-    ja not_binomial
-    
-    ; Binomial form detected (e and f can be non-zero)
-    mov rax, 1
-    pop rbp
-    ret
+    movsxd rbx, edi
+    mov r12, rsi
+    mov r13, rdx
 
-not_binomial:
-    mov rax, 0
-    pop rbp
-    ret
+    ; target = -c/a
+    xorpd xmm2, xmm2
+    subsd xmm2, xmm1
+    divsd xmm2, xmm0
 
-; Check for factorizable forms
-check_factorizable_quintic:
-    push rbp
-    mov rbp, rsp
-    
-    ; Check if f = 0 (x is a factor)
-    movsd xmm0, [coeff_f]          ; f coefficient
-    call fabs
-    movsd xmm7, [tolerance]
-    ucomisd xmm0, xmm7
-    jbe factorizable_detected
-    
-    ; Other factorization checks could go here
-    ; (rational root theorem, etc.)
-    
-    mov rax, 0
-    pop rbp
-    ret
+    ; Block n-1 of the table; its second half holds the roots of -1
+    lea rax, [rbx-1]
+    shl rax, 8
+    ucomisd xmm2, [rel const_zero]
+    jae .positive
+    add rax, 128
+.positive:
+    mov [rbp-32], rax
 
-factorizable_detected:
-    mov rax, 1
-    pop rbp
-    ret
+    ; === Magnitude: real n-th root of |target| ===
+    andpd xmm2, [rel pd_mask_abs]
+    movapd xmm0, xmm2
+    cmp ebx, 1
+    je .scale
+    cmp ebx, 3
+    je .cube_root
+    cmp ebx, 5
+    je .any_root
+    cmp ebx, 7
+    je .any_root
+    sqrtsd xmm0, xmm0               ; n = 2, 4, 6, 8
+    cmp ebx, 2
+    je .scale
+    cmp ebx, 6
+    je .cube_root
+    sqrtsd xmm0, xmm0               ; n = 4, 8
+    cmp ebx, 4
+    je .scale
+    sqrtsd xmm0, xmm0               ; n = 8
+    jmp .scale
+.cube_root:
+    call cbrt wrt ..plt
+    jmp .scale
+.any_root:
+    cvtsi2sd xmm2, ebx
+    movsd xmm1, [rel const_one]
+    divsd xmm1, xmm2                ; 1/n
+    call pow wrt ..plt
 
-; Solve monomial quintic: x^5 = -f/a
-solve_monomial_quintic:
-    push rbp
-    mov rbp, rsp
-    sub rsp, 64
-    
-    ; Calculate -f/a
-    movsd xmm0, [coeff_f]          ; f coefficient
-    movsd xmm1, [coeff_a]          ; a coefficient
-    
-    ; Check for zero divisor
-    xorpd xmm2, xmm2
-    ucomisd xmm1, xmm2
-    je division_by_zero
-    
-    divsd xmm0, xmm1               ; f/a
-    xorpd xmm1, xmm1
-    subsd xmm1, xmm0               ; -f/a
-    movsd [rsp+0], xmm1            ; Store target value
-    
-    ; Display the equation being solved
-    mov rdi, debug_monomial
-    movsd xmm0, [rsp+0]
-    mov eax, 1
-    call printf
-    
-    ; Calculate 5th root of absolute value
-    movsd xmm0, [rsp+0]
-    call fabs                      ; |target|
-    
-    ; Check if target is zero
-    movsd xmm1, [tolerance]
-    ucomisd xmm0, xmm1
-    jbe zero_target
-    
-    ; Calculate fifth root: |target|^(1/5)
-    movsd xmm1, [five_const]       ; 1/5 = 0.2
-    call pow                       ; |target|^(1/5)
-    movsd [rsp+8], xmm0            ; Store magnitude
-    
-    ; Generate 5 roots using 5th roots of unity
-    mov r8, 0                      ; Root index
-    
-root_loop:
-    cmp r8, 5
-    jge roots_complete
-    
-    ; Calculate angle: 2π * k / 5
-    mov rax, r8
-    cvtsi2sd xmm0, rax             ; Convert k to double
-    mulsd xmm0, [fifth_pi]         ; k * (2π/5)
-    
-    ; Calculate cos(angle) and sin(angle)
-    movsd [rsp+16], xmm0           ; Save angle
-    call cos
-    movsd [rsp+24], xmm0           ; Save cos(angle)
-    
-    movsd xmm0, [rsp+16]           ; Restore angle
-    call sin
-    movsd [rsp+32], xmm0           ; Save sin(angle)
-    
-    ; Calculate root: magnitude * (cos + i*sin)
-    movsd xmm0, [rsp+8]            ; Load magnitude
-    mulsd xmm0, [rsp+24]           ; magnitude * cos
-    
-    ; Store real part
-    lea rax, [roots_real]
-    mov rdx, r8
-    shl rdx, 3                     ; k * 8 (size of double)
-    movsd [rax + rdx], xmm0
-    
-    ; Calculate imaginary part
-    movsd xmm0, [rsp+8]            ; Load magnitude
-    mulsd xmm0, [rsp+32]           ; magnitude * sin
-    
-    ; Store imaginary part
-    lea rax, [roots_imag]
-    movsd [rax + rdx], xmm0
-    
-    ; Display root
-    mov rdi, debug_roots
-    mov rsi, r8
-    movsd xmm0, [roots_real + rdx]
-    movsd xmm1, [roots_imag + rdx]
-    mov eax, 2
-    call printf
-    
-    inc r8
-    jmp root_loop
-
-zero_target:
-    ; Target is zero, so all roots are zero
-    mov r8, 0
-zero_loop:
-    cmp r8, 5
-    jge roots_complete
-    
-    xorpd xmm0, xmm0
-    lea rax, [roots_real]
-    mov rdx, r8
-    shl rdx, 3
-    movsd [rax + rdx], xmm0
-    
-    lea rax, [roots_imag]
-    movsd [rax + rdx], xmm0
-    
-    inc r8
-    jmp zero_loop
-
-division_by_zero:
-    ; Handle a=0 case (not actually a quintic)
-    mov qword [root_count], 0
-    add rsp, 64
-    pop rbp
-    ret
+.scale:
+    ; === root k = magnitude * twiddle k, two roots per packed step ===
+    unpcklpd xmm0, xmm0
+    lea rcx, [rel twiddle_table]
+    add rcx, [rbp-32]
+    xor r8d, r8d                    ; byte offset of the pair
+    lea r9, [rbx*8]
+    and r9, -16                     ; bytes covered by whole pairs
+    jz .tail
+.pair_loop:
+    movapd xmm1, [rcx+r8]           ; cos pair
+    mulpd xmm1, xmm0
+    movupd [r12+r8], xmm1
+    movapd xmm2, [rcx+r8+64]        ; sin pair, 8 slots after cos
+    mulpd xmm2, xmm0
+    movupd [r13+r8], xmm2
+    add r8, 16
+    cmp r8, r9
+    jb .pair_loop
+.tail:
+    test ebx, 1
+    jz .done
+    movsd xmm1, [rcx+r8]            ; odd n: the last root alone
+    mulsd xmm1, xmm0
+    movsd [r12+r8], xmm1
+    movsd xmm2, [rcx+r8+64]
+    mulsd xmm2, xmm0
+    movsd [r13+r8], xmm2
+.done:
+    mov eax, ebx
 
-roots_complete:
-    ; Set root count
-    mov qword [root_count], 5
-    
-    add rsp, 64
+.exit:
+    lea rsp, [rbp-24]
+    pop r13
+    pop r12
+    pop rbx
     pop rbp
     ret
-
-section .rodata
-    align 16
-    five_const      dq 0.2         ; 1/5 for 5th root calculation
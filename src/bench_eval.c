@@ -0,0 +1,146 @@
+// === bench_eval.c for DSKYpoly ===
+// p and p' over a dense grid: a scalar C Horner loop (one point at a time,
+// the shape of every solver's inner loop) against the packed evaluation
+// kernels, at real and complex points, for a degree 5 and a degree 10
+// polynomial. The kernels round exactly like the C loop, so the error
+// column must read 0.
+//
+// usage: bench_eval [results.json]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "dskypoly.h"
+#include "dskypoly_bench.h"
+
+#define BENCH_N      (1 << 12)   // grid points per pass (cache resident)
+#define BENCH_PASSES 2000
+#define BENCH_MAX_DEGREE 10
+
+typedef void (*eval_kernel)(const double*, int, const double*, size_t, double*, double*);
+typedef void (*eval_complex_kernel)(const double*, int, const double*, const double*, size_t,
+                                    double*, double*, double*, double*);
+
+static double coef[BENCH_MAX_DEGREE + 1];
+static double xr[BENCH_N], xi[BENCH_N];
+static double pr[BENCH_N], pi[BENCH_N], dr[BENCH_N], di[BENCH_N];
+static double ref_pr[BENCH_N], ref_pi[BENCH_N], ref_dr[BENCH_N], ref_di[BENCH_N];
+
+static void fill_grid(void) {
+    srand(2025);
+    for (int k = 0; k <= BENCH_MAX_DEGREE; k++)
+        coef[k] = -2.0 + 4.0 * rand() / (double)RAND_MAX;
+    for (int i = 0; i < BENCH_N; i++) {
+        xr[i] = -1.5 + 3.0 * i / BENCH_N;
+        xi[i] = -1.0 + 2.0 * rand() / (double)RAND_MAX;
+    }
+}
+
+// The recurrence every solver inlines, one point after another
+static void horner_c(const double* c, int n, const double* x, size_t m,
+                     double* p, double* dp) {
+    for (size_t i = 0; i < m; i++) {
+        double v = c[0], d = 0.0;
+        for (int k = 1; k <= n; k++) {
+            d = d * x[i] + v;
+            v = v * x[i] + c[k];
+        }
+        p[i] = v;
+        dp[i] = d;
+    }
+}
+
+static void horner_complex_c(const double* c, int n, const double* x, const double* y,
+                             size_t m, double* vr, double* vi, double* wr, double* wi) {
+    for (size_t i = 0; i < m; i++) {
+        double ar = c[0], ai = 0.0, br = 0.0, bi = 0.0;
+        for (int k = 1; k <= n; k++) {
+            double tr = br * x[i] - bi * y[i] + ar, ti = bi * x[i] + br * y[i] + ai;
+            br = tr; bi = ti;
+            tr = ar * x[i] - ai * y[i] + c[k]; ti = ai * x[i] + ar * y[i];
+            ar = tr; ai = ti;
+        }
+        vr[i] = ar; vi[i] = ai; wr[i] = br; wi[i] = bi;
+    }
+}
+
+static double max_rel_diff(int complex) {
+    double err = 0.0;
+    for (int i = 0; i < BENCH_N; i++) {
+        double e = fabs(pr[i] - ref_pr[i]) / (1.0 + fabs(ref_pr[i]))
+                 + fabs(dr[i] - ref_dr[i]) / (1.0 + fabs(ref_dr[i]));
+        if (complex)
+            e += fabs(pi[i] - ref_pi[i]) / (1.0 + fabs(ref_pi[i]))
+               + fabs(di[i] - ref_di[i]) / (1.0 + fabs(ref_di[i]));
+        if (!(e <= err)) err = e;                   // NaN counts as a mismatch
+    }
+    return err;
+}
+
+static bench_timer bench_real(eval_kernel eval, int n, double* p, double* dp) {
+    bench_timer t;
+    bench_timer_init(&t);
+    for (int pass = 0; pass < BENCH_PASSES; pass++) {
+        bench_begin(&t);
+        eval(coef, n, xr, BENCH_N, p, dp);
+        bench_end(&t);
+    }
+    return t;
+}
+
+static bench_timer bench_complex(eval_complex_kernel eval, int n, double* vr, double* vi,
+                                 double* wr, double* wi) {
+    bench_timer t;
+    bench_timer_init(&t);
+    for (int pass = 0; pass < BENCH_PASSES; pass++) {
+        bench_begin(&t);
+        eval(coef, n, xr, xi, BENCH_N, vr, vi, wr, wi);
+        bench_end(&t);
+    }
+    return t;
+}
+
+int main(int argc, char** argv) {
+    int level = dskypoly_cpu_level();
+    char label[48];
+
+    printf("=== DSKYpoly Evaluation Benchmark ===\n");
+    printf("%d grid points per pass, best of %d passes\n\n", BENCH_N, BENCH_PASSES);
+    bench_json_open(argc > 1 ? argv[1] : NULL, "eval", dskypoly_isa_name(level));
+    fill_grid();
+
+    for (int n = 5; n <= BENCH_MAX_DEGREE; n += 5) {
+        snprintf(label, sizeof(label), "Horner C, degree %d", n);
+        bench_timer base = bench_real(horner_c, n, ref_pr, ref_dr);
+        bench_report(label, "single", &base, BENCH_N, base.seconds, -1.0);
+
+        bench_timer t = bench_real(eval_poly_n_sse2, n, pr, dr);
+        bench_report("eval_poly_n SSE2", "batch", &t, BENCH_N, base.seconds, max_rel_diff(0));
+        if (level >= DSKYPOLY_ISA_AVX2) {
+            t = bench_real(eval_poly_n_avx2, n, pr, dr);
+            bench_report("eval_poly_n AVX2", "batch", &t, BENCH_N, base.seconds, max_rel_diff(0));
+        } else {
+            printf("%-26s skipped (AVX2 not available)\n", "eval_poly_n AVX2");
+        }
+
+        snprintf(label, sizeof(label), "complex Horner C, deg %d", n);
+        base = bench_complex(horner_complex_c, n, ref_pr, ref_pi, ref_dr, ref_di);
+        bench_report(label, "single", &base, BENCH_N, base.seconds, -1.0);
+
+        t = bench_complex(eval_poly_n_complex_sse2, n, pr, pi, dr, di);
+        bench_report("eval_poly_n_complex SSE2", "batch", &t, BENCH_N, base.seconds,
+                     max_rel_diff(1));
+        if (level >= DSKYPOLY_ISA_AVX2) {
+            t = bench_complex(eval_poly_n_complex_avx2, n, pr, pi, dr, di);
+            bench_report("eval_poly_n_complex AVX2", "batch", &t, BENCH_N, base.seconds,
+                         max_rel_diff(1));
+        } else {
+            printf("%-26s skipped (AVX2 not available)\n", "eval_poly_n_complex AVX2");
+        }
+        printf("\n");
+    }
+
+    bench_json_close();
+    return 0;
+}
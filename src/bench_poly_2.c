@@ -0,0 +1,171 @@
+// === bench_poly_2.c for DSKYpoly ===
+// Throughput of the scalar x87 reference loop, the scalar SSE2 solve_poly_2
+// and the portable C solver from simple_main.c against the batched SSE2 /
+// AVX2 / AVX-512 kernels on the same coefficient triples, and the float32
+// batches (src/dskypoly_f32.c) on the triples rounded to float.
+//
+// usage: bench_poly_2 [results.json]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "dskypoly.h"
+#include "dskypoly_bench.h"
+
+#define BENCH_N      (1 << 12)   // quadratics per pass (cache resident)
+#define BENCH_PASSES 2000
+
+// simple_main.c's C solver, compiled with solve_poly_2 renamed so it links
+// next to the assembly one
+void solve_poly_2_c(double a, double b, double c,
+                    double* r1_real, double* r1_imag,
+                    double* r2_real, double* r2_imag);
+
+typedef void (*scalar_solver)(double, double, double, double*, double*, double*, double*);
+typedef void (*batch_kernel)(const double*, const double*, const double*, size_t,
+                             double*, double*, double*, double*);
+typedef int (*batch_kernel_f32)(const float*, const float*, const float*, size_t,
+                                float*, float*, float*, float*, float);
+
+static double a[BENCH_N], b[BENCH_N], c[BENCH_N];
+static double r1_real[BENCH_N], r1_imag[BENCH_N], r2_real[BENCH_N], r2_imag[BENCH_N];
+static double ref_r1_real[BENCH_N], ref_r1_imag[BENCH_N];
+static double ref_r2_real[BENCH_N], ref_r2_imag[BENCH_N];
+static float af[BENCH_N], bf[BENCH_N], cf[BENCH_N];
+static float f_r1_real[BENCH_N], f_r1_imag[BENCH_N], f_r2_real[BENCH_N], f_r2_imag[BENCH_N];
+
+// Random coefficients; roughly 40% of the triples get a negative discriminant
+static void fill_coefficients(void) {
+    srand(2025);
+    for (int i = 0; i < BENCH_N; i++) {
+        double sign = (rand() & 1) ? 1.0 : -1.0;
+        a[i] = sign * (0.5 + 1.5 * rand() / (double)RAND_MAX);
+        b[i] = -10.0 + 20.0 * rand() / (double)RAND_MAX;
+        c[i] = -10.0 + 20.0 * rand() / (double)RAND_MAX;
+        af[i] = (float)a[i];
+        bf[i] = (float)b[i];
+        cf[i] = (float)c[i];
+    }
+}
+
+// Compare against the x87 loop, relative to the root magnitude
+static double max_rel_diff(void) {
+    double err = 0.0;
+    for (int i = 0; i < BENCH_N; i++) {
+        double scale = 1.0 + fabs(ref_r1_real[i]) + fabs(ref_r1_imag[i])
+                           + fabs(ref_r2_real[i]) + fabs(ref_r2_imag[i]);
+        double e = fabs(r1_real[i] - ref_r1_real[i]) + fabs(r1_imag[i] - ref_r1_imag[i])
+                 + fabs(r2_real[i] - ref_r2_real[i]) + fabs(r2_imag[i] - ref_r2_imag[i]);
+        if (!(e / scale <= err)) err = e / scale;   // NaN counts as a mismatch
+    }
+    return err;
+}
+
+static bench_timer bench_scalar(scalar_solver solve, double* r1r, double* r1i,
+                                double* r2r, double* r2i) {
+    bench_timer t;
+    bench_timer_init(&t);
+    for (int pass = 0; pass < BENCH_PASSES; pass++) {
+        bench_begin(&t);
+        for (int i = 0; i < BENCH_N; i++)
+            solve(a[i], b[i], c[i], &r1r[i], &r1i[i], &r2r[i], &r2i[i]);
+        bench_end(&t);
+    }
+    return t;
+}
+
+static bench_timer bench_batch(batch_kernel kernel, double* max_err) {
+    bench_timer t;
+    bench_timer_init(&t);
+    for (int pass = 0; pass < BENCH_PASSES; pass++) {
+        bench_begin(&t);
+        kernel(a, b, c, BENCH_N, r1_real, r1_imag, r2_real, r2_imag);
+        bench_end(&t);
+    }
+    *max_err = max_rel_diff();
+    return t;
+}
+
+// Same comparison for the float32 batches; redone gets the lanes of the
+// last pass that fell back to double
+static bench_timer bench_batch_f32(batch_kernel_f32 kernel, double* max_err, int* redone) {
+    bench_timer t;
+    bench_timer_init(&t);
+    for (int pass = 0; pass < BENCH_PASSES; pass++) {
+        bench_begin(&t);
+        *redone = kernel(af, bf, cf, BENCH_N, f_r1_real, f_r1_imag, f_r2_real, f_r2_imag, 0.0f);
+        bench_end(&t);
+    }
+    for (int i = 0; i < BENCH_N; i++) {
+        r1_real[i] = f_r1_real[i];
+        r1_imag[i] = f_r1_imag[i];
+        r2_real[i] = f_r2_real[i];
+        r2_imag[i] = f_r2_imag[i];
+    }
+    *max_err = max_rel_diff();
+    return t;
+}
+
+int main(int argc, char** argv) {
+    double err;
+    int redone;
+    int level = dskypoly_cpu_level();
+
+    printf("=== DSKYpoly Quadratic Benchmark ===\n");
+    printf("%d quadratics per pass, best of %d passes\n\n", BENCH_N, BENCH_PASSES);
+    bench_json_open(argc > 1 ? argv[1] : NULL, "quadratic", dskypoly_isa_name(level));
+    fill_coefficients();
+
+    bench_timer scalar = bench_scalar(solve_poly_2_reference, ref_r1_real, ref_r1_imag,
+                                      ref_r2_real, ref_r2_imag);
+    bench_report("solve_poly_2_reference (x87)", "single", &scalar, BENCH_N, scalar.seconds, -1.0);
+
+    bench_timer t = bench_scalar(solve_poly_2, r1_real, r1_imag, r2_real, r2_imag);
+    bench_report("solve_poly_2 (SSE2)", "single", &t, BENCH_N, scalar.seconds, max_rel_diff());
+
+    t = bench_scalar(solve_poly_2_c, r1_real, r1_imag, r2_real, r2_imag);
+    bench_report("solve_poly_2 (C)", "single", &t, BENCH_N, scalar.seconds, max_rel_diff());
+
+    t = bench_batch(solve_poly_2_batch_sse2, &err);
+    bench_report("batch SSE2 (2-wide)", "batch", &t, BENCH_N, scalar.seconds, err);
+
+    if (level >= DSKYPOLY_ISA_AVX2) {
+        t = bench_batch(solve_poly_2_batch_avx2, &err);
+        bench_report("batch AVX2 (4-wide)", "batch", &t, BENCH_N, scalar.seconds, err);
+    } else {
+        printf("%-26s skipped (AVX2 not available)\n", "batch AVX2 (4-wide)");
+    }
+    if (level >= DSKYPOLY_ISA_AVX512) {
+        t = bench_batch(solve_poly_2_batch_avx512, &err);
+        bench_report("batch AVX-512 (8-wide)", "batch", &t, BENCH_N, scalar.seconds, err);
+    } else {
+        printf("%-26s skipped (AVX-512F not available)\n", "batch AVX-512 (8-wide)");
+    }
+
+    t = bench_batch(solve_poly_2_batch, &err);
+    bench_report("solve_poly_2_batch", "batch", &t, BENCH_N, scalar.seconds, err);
+
+    // Error against the x87 loop includes rounding the coefficients to float
+    t = bench_batch_f32(solve_poly_2_batch_f32_sse2, &err, &redone);
+    bench_report("f32 SSE2 (4-wide)", "batch", &t, BENCH_N, scalar.seconds, err);
+    if (level >= DSKYPOLY_ISA_AVX2) {
+        t = bench_batch_f32(solve_poly_2_batch_f32_avx2, &err, &redone);
+        bench_report("f32 AVX2 (8-wide)", "batch", &t, BENCH_N, scalar.seconds, err);
+    } else {
+        printf("%-26s skipped (AVX2 not available)\n", "f32 AVX2 (8-wide)");
+    }
+    if (level >= DSKYPOLY_ISA_AVX512) {
+        t = bench_batch_f32(solve_poly_2_batch_f32_avx512, &err, &redone);
+        bench_report("f32 AVX-512 (16-wide)", "batch", &t, BENCH_N, scalar.seconds, err);
+    } else {
+        printf("%-26s skipped (AVX-512F not available)\n", "f32 AVX-512 (16-wide)");
+    }
+    t = bench_batch_f32(solve_poly_2_batch_f32, &err, &redone);
+    bench_report("solve_poly_2_batch_f32", "batch", &t, BENCH_N, scalar.seconds, err);
+    printf("\n%d of %d float32 lanes redone in double\n", redone, BENCH_N);
+    printf("Dispatch bound solve_poly_2_batch for %s\n", dskypoly_isa_name(level));
+
+    bench_json_close();
+    return 0;
+}
@@ -0,0 +1,107 @@
+// === bench_shapes.cpp for DSKYpoly ===
+// Shape-specialized batches from dskypoly.hpp against the general solver
+// each one replaces, on homogeneous batches of one shape: biquadratic
+// quartics and monomial quintics. The error column is the largest distance
+// from a specialized root to the nearest general one, relative to the root
+// magnitude.
+//
+// usage: bench_shapes [results.json]
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "dskypoly.hpp"
+#include "dskypoly_bench.h"
+
+#define BENCH_N      (1 << 12)   // polynomials per pass (cache resident)
+#define BENCH_PASSES 500
+
+static double coef[6][BENCH_N];
+static double re[5 * BENCH_N], im[5 * BENCH_N];
+static double ref_re[5 * BENCH_N], ref_im[5 * BENCH_N];
+static const double* planes[6] = { coef[0], coef[1], coef[2], coef[3], coef[4], coef[5] };
+
+// Random coefficients with the shape's zero pattern
+static void fill_coefficients(int degree, unsigned zero) {
+    srand(2025);
+    for (int i = 0; i < BENCH_N; i++) {
+        double sign = (rand() & 1) ? 1.0 : -1.0;
+        coef[0][i] = sign * (0.5 + 1.5 * rand() / (double)RAND_MAX);
+        for (int k = 1; k <= degree; k++)
+            coef[k][i] = (zero >> k) & 1u ? 0.0 : -10.0 + 20.0 * rand() / (double)RAND_MAX;
+    }
+}
+
+// Roots are sets: compare every specialized root against the nearest reference
+static double max_set_diff(int degree) {
+    double err = 0.0;
+    for (int i = 0; i < BENCH_N; i++)
+        for (int k = 0; k < degree; k++) {
+            double zr = re[k * BENCH_N + i], zi = im[k * BENCH_N + i];
+            double best = INFINITY;
+            for (int j = 0; j < degree; j++) {
+                double d = std::hypot(zr - ref_re[j * BENCH_N + i], zi - ref_im[j * BENCH_N + i]);
+                if (d < best) best = d;
+            }
+            double e = best / (1.0 + std::hypot(zr, zi));
+            if (!(e <= err)) err = e;                 // NaN counts as a mismatch
+        }
+    return err;
+}
+
+template <typename F>
+static bench_timer time_passes(F run) {
+    bench_timer t;
+    bench_timer_init(&t);
+    for (int pass = 0; pass < BENCH_PASSES; pass++) {
+        bench_begin(&t);
+        run();
+        bench_end(&t);
+    }
+    return t;
+}
+
+int main(int argc, char** argv) {
+    using namespace dskypoly;
+
+    printf("=== DSKYpoly Shape-Specialized Benchmark ===\n");
+    printf("%d polynomials per pass, best of %d passes\n\n", BENCH_N, BENCH_PASSES);
+    bench_json_open(argc > 1 ? argv[1] : NULL, "shapes", dskypoly_isa_name(dskypoly_cpu_level()));
+
+    // ax^4 + cx^2 + e: Ferrari per element vs two packed quadratic solves
+    fill_coefficients(4, mask::biquadratic);
+    bench_timer base = time_passes([] {
+        double r[4], s[4];
+        for (int i = 0; i < BENCH_N; i++) {
+            solve_poly_4_production(coef[0][i], coef[1][i], coef[2][i], coef[3][i], coef[4][i],
+                                    r, s);
+            for (int k = 0; k < 4; k++) {
+                ref_re[k * BENCH_N + i] = r[k];
+                ref_im[k * BENCH_N + i] = s[k];
+            }
+        }
+    });
+    bench_report("solve_poly_4_production", "single", &base, BENCH_N, base.seconds, -1.0);
+    bench_timer t = time_passes([] { solve<4, mask::biquadratic>(planes, BENCH_N, re, im); });
+    bench_report("solve<4, biquadratic>", "batch", &t, BENCH_N, base.seconds, max_set_diff(4));
+
+    // ax^5 + f: runtime form detection vs the monomial kernel directly
+    fill_coefficients(5, mask::monomial);
+    base = time_passes([] {
+        double r[5], s[5];
+        for (int i = 0; i < BENCH_N; i++) {
+            solve_poly_5_special_r(coef[0][i], 0.0, 0.0, 0.0, 0.0, coef[5][i], r, s, NULL);
+            for (int k = 0; k < 5; k++) {
+                ref_re[k * BENCH_N + i] = r[k];
+                ref_im[k * BENCH_N + i] = s[k];
+            }
+        }
+    });
+    bench_report("solve_poly_5_special_r", "single", &base, BENCH_N, base.seconds, -1.0);
+    t = time_passes([] { solve<5, mask::monomial>(planes, BENCH_N, re, im); });
+    bench_report("solve<5, monomial>", "batch", &t, BENCH_N, base.seconds, max_set_diff(5));
+
+    bench_json_close();
+    return 0;
+}
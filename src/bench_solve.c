@@ -0,0 +1,293 @@
+// === bench_solve.c for DSKYpoly ===
+// Scaling of the bulk driver on a mixed batch of degree 2-5 polynomials,
+// from one worker up to every online CPU. Every run must reproduce the
+// single-worker roots bit for bit: the schedule may change, the math may not.
+// The last single-worker runs show the sort-by-kind pre-pass, the same
+// pre-pass solving into a reused arena context, and two refinement steps
+// per root; their error columns show how far the roots moved (the batch
+// kernels round differently from the scalar quadratic). The tracker run
+// treats every polynomial as a stream and times one tick of 1e-6 relative
+// coefficient drift per pass, so its error column is mostly the drift.
+// The cache run repeats one of 1024 templates (scaled by a power of two)
+// in 2 of every 5 slots and solves through a fresh root cache per pass,
+// against the same batch uncached.
+// Last, degree 8 and 16 batches: one Aberth solve per polynomial against
+// the lockstep companion QR (root orders differ, so no error column).
+// Linked against the profile-built kernels (make profile), the statistics
+// at the end carry the Cardano and Ferrari phase timings, and a second
+// path gets them as folded stacks.
+//
+// usage: bench_solve [results.json [phases.folded]]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+
+#include "dskypoly.h"
+#include "dskypoly_bench.h"
+
+#define BENCH_N      (1 << 18)   // polynomials per batch
+#define BENCH_PASSES 3
+
+#define BENCH_DRIFT  1e-6        // relative coefficient change per tracker tick
+#define BENCH_TEMPLATES 1024     // distinct repeating polynomials in the cache run
+#define BENCH_HIGH_N (1 << 14)   // polynomials per high-degree batch
+
+static dskypoly_poly polys[BENCH_N], drifted[BENCH_N];
+static double re[BENCH_N * DSKYPOLY_MAX_DEGREE], im[BENCH_N * DSKYPOLY_MAX_DEGREE];
+static double ref_re[BENCH_N * DSKYPOLY_MAX_DEGREE], ref_im[BENCH_N * DSKYPOLY_MAX_DEGREE];
+static int nroots[BENCH_N], ref_nroots[BENCH_N];
+
+// Degrees drawn uniformly from 2..5 and interleaved, the worst case for
+// static chunking since runs of quintics land on whichever worker owns them
+static void fill_polys(void) {
+    srand(2025);
+    for (int i = 0; i < BENCH_N; i++) {
+        polys[i].degree = 2 + rand() % 4;
+        double sign = (rand() & 1) ? 1.0 : -1.0;
+        polys[i].coeffs[0] = sign * (0.5 + 1.5 * rand() / (double)RAND_MAX);
+        for (int k = 1; k <= polys[i].degree; k++)
+            polys[i].coeffs[k] = -10.0 + 20.0 * rand() / (double)RAND_MAX;
+    }
+}
+
+typedef int (*bulk_solver)(const dskypoly_poly*, size_t, double*, double*, int*, int,
+                           const dskypoly_refine*);
+
+static bench_timer bench_threads(bulk_solver solve, int threads, int* workers,
+                                 const dskypoly_refine* refine) {
+    bench_timer t;
+    bench_timer_init(&t);
+    for (int pass = 0; pass < BENCH_PASSES; pass++) {
+        bench_begin(&t);
+        *workers = solve(polys, BENCH_N, re, im, nroots, threads, refine);
+        bench_end(&t);
+    }
+    return t;
+}
+
+// Sorted solves into an arena reset before every pass; the view is copied
+// out afterwards, untimed, for the comparison
+static bench_timer bench_context(void) {
+    bench_timer t;
+    dskypoly_roots_view v = { 0 };
+    dskypoly_ctx* ctx = dskypoly_ctx_create(1, 0);
+    bench_timer_init(&t);
+    for (int pass = 0; ctx && pass < BENCH_PASSES; pass++) {
+        dskypoly_ctx_reset(ctx);
+        bench_begin(&t);
+        dskypoly_ctx_solve(ctx, polys, BENCH_N, NULL, &v);
+        bench_end(&t);
+    }
+    if (v.re) {
+        memcpy(re, v.re, sizeof(re));
+        memcpy(im, v.im, sizeof(im));
+        memcpy(nroots, v.nroots, sizeof(nroots));
+    }
+    dskypoly_ctx_destroy(ctx);
+    return t;
+}
+
+// Every polynomial as its own stream: a cold first tick, untimed, then one
+// drifted tick per pass. *steps gets the mean Newton steps per update.
+static bench_timer bench_tracker(double* steps) {
+    bench_timer t;
+    long taken = 0, updates = 0;
+    dskypoly_tracker* tr = dskypoly_tracker_create(0.0, 0.0);
+    memcpy(drifted, polys, sizeof(polys));
+    for (int i = 0; tr && i < BENCH_N; i++)
+        nroots[i] = dskypoly_tracker_update(tr, i, drifted[i].coeffs, drifted[i].degree,
+                                            &re[i * DSKYPOLY_MAX_DEGREE],
+                                            &im[i * DSKYPOLY_MAX_DEGREE], NULL);
+
+    srand(7);
+    bench_timer_init(&t);
+    for (int pass = 0; tr && pass < BENCH_PASSES; pass++) {
+        for (int i = 0; i < BENCH_N; i++)
+            for (int k = 0; k <= drifted[i].degree; k++)
+                drifted[i].coeffs[k] *= 1.0 + BENCH_DRIFT * (2.0 * rand() / RAND_MAX - 1.0);
+        bench_begin(&t);
+        for (int i = 0; i < BENCH_N; i++) {
+            int s;
+            nroots[i] = dskypoly_tracker_update(tr, i, drifted[i].coeffs, drifted[i].degree,
+                                                &re[i * DSKYPOLY_MAX_DEGREE],
+                                                &im[i * DSKYPOLY_MAX_DEGREE], &s);
+            taken += s < 0 ? 0 : s;
+            updates += s >= 0;
+        }
+        bench_end(&t);
+    }
+    *steps = updates ? (double)taken / updates : 0.0;
+    printf("%-26s %ld of %ld updates warm, %.2f Newton steps each\n", "",
+           updates, (long)BENCH_PASSES * BENCH_N, *steps);
+    dskypoly_tracker_destroy(tr);
+    return t;
+}
+
+// The batch of the cache run, in drifted[]: templates in 2 of 5 slots
+static void fill_repeated(void) {
+    for (int i = 0; i < BENCH_N; i++) {
+        drifted[i] = polys[i];
+        if (i % 5 < 2) {
+            drifted[i] = polys[(i * 7) % BENCH_TEMPLATES];
+            for (int k = 0; k <= drifted[i].degree; k++)
+                drifted[i].coeffs[k] = ldexp(drifted[i].coeffs[k], i % 3);
+        }
+    }
+}
+
+static bench_timer bench_uncached(void) {
+    bench_timer t;
+    bench_timer_init(&t);
+    for (int pass = 0; pass < BENCH_PASSES; pass++) {
+        bench_begin(&t);
+        dskypoly_solve(drifted, BENCH_N, re, im, nroots, 1);
+        bench_end(&t);
+    }
+    return t;
+}
+
+static bench_timer bench_cached(void) {
+    bench_timer t;
+    dskypoly_stats before, after;
+    dskypoly_stats_snapshot(&before);
+    bench_timer_init(&t);
+    for (int pass = 0; pass < BENCH_PASSES; pass++) {
+        dskypoly_cache* cache = dskypoly_cache_open(BENCH_N, NULL);
+        if (!cache)
+            break;
+        bench_begin(&t);
+        dskypoly_solve_cached(cache, drifted, BENCH_N, re, im, nroots, 1, NULL);
+        bench_end(&t);
+        dskypoly_cache_close(cache);
+    }
+    dskypoly_stats_snapshot(&after);
+    uint64_t hits = after.cache_hits - before.cache_hits;
+    uint64_t lookups = hits + after.cache_misses - before.cache_misses;
+    printf("%-26s %.1f%% of lookups hit\n", "", lookups ? 100.0 * hits / lookups : 0.0);
+    return t;
+}
+
+// Degree 8 and 16: Aberth one polynomial at a time, then the companion
+// batch on the same coefficient planes
+static void bench_high_degree(void) {
+    double* planes = malloc((DSKYPOLY_COMPANION_MAX_DEGREE + 1) * BENCH_HIGH_N * sizeof(double));
+    if (!planes)
+        return;
+    srand(11);
+    for (int degree = 8; degree <= DSKYPOLY_COMPANION_MAX_DEGREE; degree *= 2) {
+        double c[DSKYPOLY_COMPANION_MAX_DEGREE + 1];
+        char label[32];
+        for (int k = 0; k <= degree; k++)
+            for (int i = 0; i < BENCH_HIGH_N; i++)
+                planes[k * BENCH_HIGH_N + i] = 2.0 * rand() / RAND_MAX - 1.0;
+
+        bench_timer base, t;
+        bench_timer_init(&base);
+        bench_timer_init(&t);
+        for (int pass = 0; pass < BENCH_PASSES; pass++) {
+            bench_begin(&base);
+            for (int i = 0; i < BENCH_HIGH_N; i++) {
+                for (int k = 0; k <= degree; k++)
+                    c[k] = planes[k * BENCH_HIGH_N + i];
+                solve_poly_n_aberth(c, degree, &re[i * degree], &im[i * degree]);
+            }
+            bench_end(&base);
+
+            bench_begin(&t);
+            solve_poly_n_companion_batch(planes, degree, BENCH_HIGH_N, re, im, NULL);
+            bench_end(&t);
+        }
+        snprintf(label, sizeof(label), "aberth, degree %d", degree);
+        bench_report(label, "single", &base, BENCH_HIGH_N, base.seconds, -1.0);
+        snprintf(label, sizeof(label), "companion QR, degree %d", degree);
+        bench_report(label, "batch", &t, BENCH_HIGH_N, base.seconds, -1.0);
+    }
+    free(planes);
+}
+
+// 0 exactly when every root and root count matches the single-worker run
+static double diff_from_reference(void) {
+    if (memcmp(nroots, ref_nroots, sizeof(nroots)) != 0)
+        return 1.0;
+    double err = 0.0;
+    for (int i = 0; i < BENCH_N * DSKYPOLY_MAX_DEGREE; i++) {
+        double e = (fabs(re[i] - ref_re[i]) + fabs(im[i] - ref_im[i]))
+                 / (1.0 + fabs(ref_re[i]) + fabs(ref_im[i]));
+        if (!(e <= err)) err = e;                   // NaN counts as a mismatch
+    }
+    return err;
+}
+
+int main(int argc, char** argv) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int workers;
+    char label[32];
+
+    printf("=== DSKYpoly Bulk Solve Benchmark ===\n");
+    printf("%d mixed degree 2-5 polynomials per batch, best of %d, %ld CPUs online\n\n",
+           BENCH_N, BENCH_PASSES, cpus);
+    bench_json_open(argc > 1 ? argv[1] : NULL, "bulk", NULL);
+    fill_polys();
+
+    bench_timer single = bench_threads(dskypoly_solve_refined, 1, &workers, NULL);
+    memcpy(ref_re, re, sizeof(re));
+    memcpy(ref_im, im, sizeof(im));
+    memcpy(ref_nroots, nroots, sizeof(nroots));
+    bench_report("dskypoly_solve x1", "bulk", &single, BENCH_N, single.seconds, -1.0);
+
+    // Doubling worker counts, always finishing on every online CPU
+    for (long t = 2; cpus > 1; t *= 2) {
+        int threads = t < cpus ? (int)t : (int)cpus;
+        bench_timer s = bench_threads(dskypoly_solve_refined, threads, &workers, NULL);
+        snprintf(label, sizeof(label), "dskypoly_solve x%d", workers);
+        bench_report(label, "bulk", &s, BENCH_N, single.seconds, diff_from_reference());
+        if (threads == cpus)
+            break;
+    }
+
+    bench_timer r = bench_threads(dskypoly_solve_sorted, 1, &workers, NULL);
+    bench_report("dskypoly_solve_sorted x1", "bulk", &r, BENCH_N, single.seconds,
+                 diff_from_reference());
+
+    r = bench_context();
+    bench_report("dskypoly_ctx_solve x1", "bulk", &r, BENCH_N, single.seconds,
+                 diff_from_reference());
+
+    dskypoly_refine polish = { .steps = 2, .tol = 1e-15 };
+    r = bench_threads(dskypoly_solve_refined, 1, &workers, &polish);
+    bench_report("dskypoly_solve_refined x1", "bulk", &r, BENCH_N, single.seconds,
+                 diff_from_reference());
+
+    double steps;
+    r = bench_tracker(&steps);
+    bench_report("dskypoly_tracker_update", "stream", &r, BENCH_N, single.seconds,
+                 diff_from_reference());
+
+    fill_repeated();
+    bench_timer plain = bench_uncached();
+    memcpy(ref_re, re, sizeof(re));
+    memcpy(ref_im, im, sizeof(im));
+    memcpy(ref_nroots, nroots, sizeof(nroots));
+    bench_report("dskypoly_solve, repeats", "bulk", &plain, BENCH_N, plain.seconds, -1.0);
+    r = bench_cached();
+    bench_report("dskypoly_solve_cached x1", "bulk", &r, BENCH_N, plain.seconds,
+                 diff_from_reference());
+
+    printf("\n");
+    bench_high_degree();
+
+    bench_json_close();
+
+    dskypoly_stats stats;
+    dskypoly_stats_snapshot(&stats);
+    printf("\n");
+    dskypoly_stats_print(&stats);
+    if (argc > 2 && dskypoly_stats_fold(&stats, argv[2]) != 0) {
+        perror(argv[2]);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,264 @@
+// === dskypoly_cache.c for DSKYpoly ===
+// Root cache in front of the solvers, keyed by normalized coefficients.
+//
+// A key is the polynomial divided by its leading coefficient, with -0.0
+// folded into +0.0, so p and 2p (or any scaling that divides out exactly)
+// share one entry; its bit patterns are hashed with the splitmix64
+// finalizer. The table is split into sets of DSKYPOLY_CACHE_WAYS entries,
+// each set its own shard with its own CLOCK hand: inserts in different
+// sets never touch the same cache line, and a full set evicts the first
+// way whose reference bit is clear, clearing bits as the hand passes.
+//
+// Entries are seqlocked. A writer claims a way by moving its sequence
+// from even to odd with one compare-and-swap (giving up if another writer
+// holds it: the cache is best effort) and releases it at the next even
+// value; a reader copies the entry and keeps it only if the sequence did
+// not move meanwhile. Lookups never block and never write except to set
+// a reference bit that was clear.
+//
+// The table lives in one mapping, anonymous or backed by a file that a
+// later dskypoly_cache_open with the same geometry picks up again. It is
+// populated up front: lookups land in random sets, and a page fault costs
+// more than the solve being saved.
+
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "dskypoly.h"
+
+#define CACHE_DEFAULT_ENTRIES (1 << 16)
+
+typedef struct {
+    _Alignas(64) _Atomic uint64_t seq;  // 0: empty, odd: being written
+    uint64_t tag;                       // key hash
+    int32_t degree;
+    int32_t nroots;
+    double key[DSKYPOLY_MAX_DEGREE];    // coefficients 1..degree over coefficient 0
+    double re[DSKYPOLY_MAX_DEGREE];
+    double im[DSKYPOLY_MAX_DEGREE];
+} cache_entry;
+
+// The set's first cache line answers most misses and every CLOCK step on
+// its own: short tags (a hint, checked against the entry) and reference
+// bits of all ways
+typedef struct {
+    _Alignas(64) _Atomic uint32_t hand;  // next way the CLOCK looks at
+    _Atomic uint32_t hint[DSKYPOLY_CACHE_WAYS];   // low 32 bits of the tag
+    _Atomic uint8_t ref[DSKYPOLY_CACHE_WAYS];     // CLOCK reference bits
+    cache_entry ways[DSKYPOLY_CACHE_WAYS];
+} cache_set;
+
+// First 64 bytes of the mapping (and of a cache file)
+typedef struct {
+    char magic[8];                      // DSKYPOLY_CACHE_MAGIC, no NUL
+    uint32_t version;                   // DSKYPOLY_CACHE_VERSION
+    uint32_t ways;
+    uint64_t sets;
+    uint64_t set_bytes;                 // sizeof(cache_set): layout check
+    uint8_t reserved[32];
+} cache_header;
+
+struct dskypoly_cache {
+    void* map;
+    size_t bytes;
+    cache_set* sets;
+    size_t mask;                        // set count - 1
+};
+
+static const char cache_magic[8] = DSKYPOLY_CACHE_MAGIC;
+
+static inline uint64_t key_hash(uint64_t h) {
+    h ^= h >> 30;
+    h *= 0xBF58476D1CE4E5B9ull;
+    h ^= h >> 27;
+    h *= 0x94D049BB133111EBull;
+    h ^= h >> 31;
+    return h;
+}
+
+// Monic coefficients and their hash; 0 for anything the cache will not
+// hold (unsupported degree, zero leading coefficient, NaN or infinity)
+static int make_key(const dskypoly_poly* p, double* key, uint64_t* tag) {
+    if (p->degree < 1 || p->degree > DSKYPOLY_MAX_DEGREE || p->coeffs[0] == 0.0)
+        return 0;
+    uint64_t h = (uint64_t)p->degree;
+    for (int k = 0; k < p->degree; k++) {
+        double v = p->coeffs[k + 1] / p->coeffs[0] + 0.0;   // -0.0 + 0.0 == +0.0
+        if (!isfinite(v))
+            return 0;
+        uint64_t bits;
+        memcpy(&bits, &v, sizeof(bits));
+        h = key_hash(h ^ bits);
+        key[k] = v;
+    }
+    *tag = h;
+    return 1;
+}
+
+static size_t cache_bytes(size_t sets) {
+    return sizeof(cache_header) + sets * sizeof(cache_set);
+}
+
+static void fill_header(cache_header* h, size_t sets) {
+    memset(h, 0, sizeof(*h));
+    memcpy(h->magic, cache_magic, sizeof(h->magic));
+    h->version = DSKYPOLY_CACHE_VERSION;
+    h->ways = DSKYPOLY_CACHE_WAYS;
+    h->sets = sets;
+    h->set_bytes = sizeof(cache_set);
+}
+
+// An existing cache file of this geometry, or a new (or empty) file sized
+// and zero-filled; any other file is not ours to overwrite
+static void* map_file(const char* path, size_t sets, size_t bytes) {
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0)
+        return NULL;
+
+    struct stat st;
+    void* map = MAP_FAILED;
+    if (fstat(fd, &st) == 0) {
+        int ours = st.st_size == 0;
+        if ((size_t)st.st_size == bytes) {
+            cache_header want, have;
+            fill_header(&want, sets);
+            ours = pread(fd, &have, sizeof(have), 0) == (ssize_t)sizeof(have)
+                && memcmp(&have, &want, sizeof(have)) == 0;
+        }
+        if (!ours)
+            errno = EINVAL;
+        else if (st.st_size != 0 || ftruncate(fd, (off_t)bytes) == 0)
+            map = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+    }
+    int saved = errno;
+    close(fd);
+    errno = saved;
+    return map == MAP_FAILED ? NULL : map;
+}
+
+dskypoly_cache* dskypoly_cache_open(size_t capacity, const char* path) {
+    size_t entries = capacity ? capacity : CACHE_DEFAULT_ENTRIES;
+    size_t sets = 1;
+    while (sets * DSKYPOLY_CACHE_WAYS < entries)
+        sets *= 2;
+
+    dskypoly_cache* c = malloc(sizeof(*c));
+    if (!c)
+        return NULL;
+    c->bytes = cache_bytes(sets);
+    c->map = path ? map_file(path, sets, c->bytes)
+                  : mmap(NULL, c->bytes, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+    if (!c->map || c->map == MAP_FAILED) {
+        int saved = errno;
+        free(c);
+        errno = saved;
+        return NULL;
+    }
+    c->sets = (cache_set*)((char*)c->map + sizeof(cache_header));
+    c->mask = sets - 1;
+
+    // A writer that died mid-entry left it odd: drop it
+    for (size_t s = 0; path && s < sets; s++)
+        for (int w = 0; w < DSKYPOLY_CACHE_WAYS; w++) {
+            cache_entry* e = &c->sets[s].ways[w];
+            if (atomic_load_explicit(&e->seq, memory_order_relaxed) & 1)
+                atomic_store_explicit(&e->seq, 0, memory_order_relaxed);
+        }
+    cache_header h;
+    fill_header(&h, sets);
+    memcpy(c->map, &h, sizeof(h));
+    return c;
+}
+
+void dskypoly_cache_close(dskypoly_cache* c) {
+    if (!c)
+        return;
+    munmap(c->map, c->bytes);
+    free(c);
+}
+
+size_t dskypoly_cache_capacity(const dskypoly_cache* c) {
+    return (c->mask + 1) * DSKYPOLY_CACHE_WAYS;
+}
+
+int dskypoly_cache_lookup(dskypoly_cache* c, const dskypoly_poly* p, double* re, double* im) {
+    double key[DSKYPOLY_MAX_DEGREE];
+    uint64_t tag;
+    if (!make_key(p, key, &tag))
+        return -1;
+
+    int d = p->degree;
+    cache_set* set = &c->sets[tag & c->mask];
+    for (int w = 0; w < DSKYPOLY_CACHE_WAYS; w++) {
+        if (atomic_load_explicit(&set->hint[w], memory_order_relaxed) != (uint32_t)tag)
+            continue;
+        cache_entry* e = &set->ways[w];
+        uint64_t seq = atomic_load_explicit(&e->seq, memory_order_acquire);
+        if (!seq || (seq & 1) || e->tag != tag)
+            continue;
+
+        // Copy first, check the sequence, then trust the copy
+        double zr[DSKYPOLY_MAX_DEGREE], zi[DSKYPOLY_MAX_DEGREE];
+        int same = e->degree == d && memcmp(e->key, key, d * sizeof(double)) == 0;
+        int n = e->nroots;
+        memcpy(zr, e->re, d * sizeof(double));
+        memcpy(zi, e->im, d * sizeof(double));
+        atomic_thread_fence(memory_order_acquire);
+        if (!same || atomic_load_explicit(&e->seq, memory_order_relaxed) != seq)
+            continue;
+
+        if (!atomic_load_explicit(&set->ref[w], memory_order_relaxed))
+            atomic_store_explicit(&set->ref[w], 1, memory_order_relaxed);
+        memcpy(re, zr, d * sizeof(double));
+        memcpy(im, zi, d * sizeof(double));
+        dskypoly_stats_cache(1);
+        return n;
+    }
+    dskypoly_stats_cache(0);
+    return -1;
+}
+
+void dskypoly_cache_insert(dskypoly_cache* c, const dskypoly_poly* p, int nroots,
+                           const double* re, const double* im) {
+    double key[DSKYPOLY_MAX_DEGREE];
+    uint64_t tag;
+    if (nroots < 0 || !make_key(p, key, &tag))
+        return;
+
+    // Two passes of the hand at most: the first may only clear bits
+    int d = p->degree;
+    cache_set* set = &c->sets[tag & c->mask];
+    for (int step = 0; step < 2 * DSKYPOLY_CACHE_WAYS; step++) {
+        uint32_t w = atomic_fetch_add_explicit(&set->hand, 1, memory_order_relaxed)
+                   % DSKYPOLY_CACHE_WAYS;
+        if (atomic_load_explicit(&set->ref[w], memory_order_relaxed)) {
+            atomic_store_explicit(&set->ref[w], 0, memory_order_relaxed);
+            continue;
+        }
+        cache_entry* e = &set->ways[w];
+        uint64_t seq = atomic_load_explicit(&e->seq, memory_order_relaxed);
+        if ((seq & 1) || !atomic_compare_exchange_strong_explicit(&e->seq, &seq, seq + 1,
+                                                     memory_order_acquire,
+                                                     memory_order_relaxed))
+            continue;
+        atomic_thread_fence(memory_order_release);
+
+        e->tag = tag;
+        e->degree = d;
+        e->nroots = nroots;
+        memcpy(e->key, key, d * sizeof(double));
+        memcpy(e->re, re, d * sizeof(double));
+        memcpy(e->im, im, d * sizeof(double));
+        atomic_store_explicit(&set->hint[w], (uint32_t)tag, memory_order_relaxed);
+        atomic_store_explicit(&e->seq, seq + 2, memory_order_release);
+        return;
+    }
+}
@@ -0,0 +1,361 @@
+// === dskypoly_companion.c for DSKYpoly ===
+// Degrees 6 and up in bulk: the roots are the eigenvalues of the companion
+// matrix, found by Francis double-shift QR on its (already Hessenberg)
+// form after a radix-2 balance.
+//
+// One polynomial's QR is a chain of small dependent steps, so instead of
+// vectorizing inside a matrix the solve runs DSKYPOLY_COMPANION_LANES
+// matrices in lockstep, entry (i, j) of every lane side by side:
+//
+//   h[((i * ld + j) * LANES) + lane]
+//
+// Every lane keeps its own shifts, deflation point and iteration count.
+// A sweep visits bulge position k once for all lanes; a lane whose window
+// does not cover k gets the identity reflector (all weights zero), so the
+// row and column updates -- the O(n) part -- stay branch-free SSE2 loops
+// over lane pairs. A block of lanes is one L1-sized tile
+// (8 x 17 x 17 doubles at degree 16), which is all the blocking matrices
+// this small want. A lane that does not converge falls back to Aberth.
+
+#include <emmintrin.h>
+#include <errno.h>
+#include <math.h>
+#include <string.h>
+
+#include "dskypoly.h"
+
+#define LANES  DSKYPOLY_COMPANION_LANES
+#define LD_MAX (DSKYPOLY_COMPANION_MAX_DEGREE + 1)   // one zero row and column of padding
+#define QR_MAX_ITS 30                                 // per eigenvalue, as in EISPACK hqr
+
+typedef struct {
+    _Alignas(64) double h[LD_MAX * LD_MAX * LANES];
+    int ld;                           // degree + 1
+    int hi[LANES];                    // bottom of the active window, -1 when done
+    int lo[LANES];                    // top of the active window
+    int start[LANES];                 // where this sweep's bulge starts
+    int its[LANES];
+    int failed[LANES];
+    double norm[LANES];               // sum of |h| after balancing
+    double shift[LANES];              // exceptional shifts taken so far
+    double p[LANES], q[LANES], r[LANES];   // first column of (H - s1)(H - s2)
+} qr_block;
+
+#define AT(i, j) (b->h + ((i) * ld + (j)) * LANES)
+#define AL(i, j) AT(i, j)[l]
+
+// Companion matrix of each lane's polynomial: first row -c[k]/c[0], ones on
+// the subdiagonal. A zero leading coefficient (or a lane past the batch)
+// gets the zero matrix, which deflates at once.
+static void load_block(qr_block* b, const double* coeffs, int degree, size_t count,
+                       size_t base, int lanes) {
+    const int ld = degree + 1;
+    b->ld = ld;
+    memset(b->h, 0, (size_t)ld * ld * LANES * sizeof(double));
+    for (int l = 0; l < LANES; l++) {
+        b->hi[l] = l < lanes ? degree - 1 : -1;
+        b->its[l] = 0;
+        b->failed[l] = 0;
+        b->shift[l] = 0.0;
+        if (l >= lanes || coeffs[base + l] == 0.0)
+            continue;
+        double inv = 1.0 / coeffs[base + l];
+        for (int j = 0; j < degree; j++)
+            AL(0, j) = -coeffs[(j + 1) * count + base + l] * inv;
+        for (int i = 1; i < degree; i++)
+            AL(i, i - 1) = 1.0;
+    }
+}
+
+// Parlett-Reinsch balancing with powers of two, so no rounding is added
+static void balance_lane(qr_block* b, int l, int n) {
+    const int ld = b->ld;
+    for (int done = 0; !done;) {
+        done = 1;
+        for (int i = 0; i < n; i++) {
+            double c = 0.0, r = 0.0;
+            for (int j = 0; j < n; j++)
+                if (j != i) {
+                    c += fabs(AL(j, i));
+                    r += fabs(AL(i, j));
+                }
+            if (c == 0.0 || r == 0.0 || !isfinite(c + r))
+                continue;                 // nothing to balance, or no scale that helps
+            double g = r * 0.5, f = 1.0, s = c + r;
+            while (c < g) {
+                f *= 2.0;
+                c *= 4.0;
+            }
+            g = r * 2.0;
+            while (c > g) {
+                f *= 0.5;
+                c *= 0.25;
+            }
+            if ((c + r) / f < 0.95 * s) {
+                done = 0;
+                for (int j = 0; j < n; j++)
+                    AL(i, j) /= f;
+                for (int j = 0; j < n; j++)
+                    AL(j, i) *= f;
+            }
+        }
+    }
+    double norm = 0.0;
+    for (int i = 0; i < n; i++)
+        for (int j = i > 0 ? i - 1 : 0; j < n; j++)
+            norm += fabs(AL(i, j));
+    b->norm[l] = norm;
+}
+
+// Takes whatever has converged off the bottom of lane l's window, writing
+// eigenvalue i to re/im[i * stride], then sets up the lane's next sweep.
+// Returns 0 once the lane is finished (or has given up).
+static int prepare_lane(qr_block* b, int l, double* re, double* im, size_t stride) {
+    const int ld = b->ld;
+    for (;;) {
+        int nn = b->hi[l];
+        if (nn < 0)
+            return 0;
+
+        int lo;
+        for (lo = nn; lo >= 1; lo--) {
+            double s = fabs(AL(lo - 1, lo - 1)) + fabs(AL(lo, lo));
+            if (s == 0.0)
+                s = b->norm[l];
+            if (fabs(AL(lo, lo - 1)) + s == s) {
+                AL(lo, lo - 1) = 0.0;
+                break;
+            }
+        }
+
+        double t = b->shift[l];
+        double x = AL(nn, nn);
+        if (lo == nn) {
+            re[nn * stride] = x + t;
+            im[nn * stride] = 0.0;
+            b->hi[l] = nn - 1;
+            b->its[l] = 0;
+            continue;
+        }
+        double y = AL(nn - 1, nn - 1), w = AL(nn, nn - 1) * AL(nn - 1, nn);
+        if (lo == nn - 1) {
+            // Trailing 2x2 block: a real pair or a conjugate pair
+            double p = 0.5 * (y - x), q = p * p + w, z = sqrt(fabs(q));
+            x += t;
+            if (q >= 0.0) {
+                z = p + copysign(z, p);
+                re[(nn - 1) * stride] = re[nn * stride] = x + z;
+                if (z != 0.0)
+                    re[nn * stride] = x - w / z;
+                im[(nn - 1) * stride] = im[nn * stride] = 0.0;
+            } else {
+                re[(nn - 1) * stride] = re[nn * stride] = x + p;
+                im[(nn - 1) * stride] = -z;
+                im[nn * stride] = z;
+            }
+            b->hi[l] = nn - 2;
+            b->its[l] = 0;
+            continue;
+        }
+
+        if (b->its[l] == QR_MAX_ITS) {
+            b->failed[l] = 1;
+            b->hi[l] = -1;
+            return 0;
+        }
+        if (b->its[l] == 10 || b->its[l] == 20) {
+            // Exceptional shift out of a cycle
+            b->shift[l] += x;
+            for (int i = 0; i <= nn; i++)
+                AL(i, i) -= x;
+            double s = fabs(AL(nn, nn - 1)) + fabs(AL(nn - 1, nn - 2));
+            y = x = 0.75 * s;
+            w = -0.4375 * s * s;
+        }
+        b->its[l]++;
+
+        // Start the bulge where two small consecutive subdiagonals let it
+        double p = 0.0, q = 0.0, r = 0.0;
+        int m;
+        for (m = nn - 2; m >= lo; m--) {
+            double z = AL(m, m);
+            r = x - z;
+            double s = y - z;
+            p = (r * s - w) / AL(m + 1, m) + AL(m, m + 1);
+            q = AL(m + 1, m + 1) - z - r - s;
+            r = AL(m + 2, m + 1);
+            s = fabs(p) + fabs(q) + fabs(r);
+            p /= s;
+            q /= s;
+            r /= s;
+            if (m == lo)
+                break;
+            double u = fabs(AL(m, m - 1)) * (fabs(q) + fabs(r));
+            double v = fabs(p) * (fabs(AL(m - 1, m - 1)) + fabs(z) + fabs(AL(m + 1, m + 1)));
+            if (u + v == v)
+                break;
+        }
+        for (int i = m + 2; i <= nn; i++) {
+            AL(i, i - 2) = 0.0;
+            if (i != m + 2)
+                AL(i, i - 3) = 0.0;
+        }
+        b->lo[l] = lo;
+        b->start[l] = m;
+        b->p[l] = p;
+        b->q[l] = q;
+        b->r[l] = r;
+        return 1;
+    }
+}
+
+// One double-shift sweep of every live lane, bulge positions kmin..kmax,
+// column updates from row imin down
+static void sweep(qr_block* b, const int* live, int kmin, int kmax, int imin) {
+    const int ld = b->ld;
+    for (int k = kmin; k <= kmax; k++) {
+        _Alignas(16) double vx[LANES], vy[LANES], vz[LANES], vq[LANES], vr[LANES];
+        int top = -1;
+        for (int l = 0; l < LANES; l++) {
+            vx[l] = vy[l] = vz[l] = vq[l] = vr[l] = 0.0;
+            int nn = b->hi[l], m = b->start[l];
+            if (!live[l] || k < m || k > nn - 1)
+                continue;
+
+            double p, q, r, x = 0.0;
+            if (k == m) {
+                p = b->p[l];
+                q = b->q[l];
+                r = b->r[l];
+            } else {
+                p = AL(k, k - 1);
+                q = AL(k + 1, k - 1);
+                r = k != nn - 1 ? AL(k + 2, k - 1) : 0.0;
+                x = fabs(p) + fabs(q) + fabs(r);
+                if (x != 0.0) {
+                    double inv = 1.0 / x;
+                    p *= inv;
+                    q *= inv;
+                    r *= inv;
+                }
+            }
+            double s = copysign(sqrt(p * p + q * q + r * r), p);
+            if (s == 0.0)
+                continue;
+            if (k == m) {
+                if (b->lo[l] != m)
+                    AL(k, k - 1) = -AL(k, k - 1);
+            } else {
+                // The reflector annihilates the bulge below (k, k-1)
+                AL(k, k - 1) = -s * x;
+                AL(k + 1, k - 1) = 0.0;
+                if (k != nn - 1)
+                    AL(k + 2, k - 1) = 0.0;
+            }
+            p += s;
+            double is = 1.0 / s, ip = 1.0 / p;
+            vx[l] = p * is;
+            vy[l] = q * is;
+            vz[l] = r * is;
+            vq[l] = q * ip;
+            vr[l] = r * ip;
+            if (nn > top)
+                top = nn;
+        }
+        if (top < 0)
+            continue;
+
+        // Rows k..k+2 from the left, then columns k..k+2 from the right,
+        // two lanes per SSE2 op. Padding keeps row and column k+2 in range
+        // at k = degree - 2.
+        int imax = top < k + 3 ? top : k + 3;
+        for (int l = 0; l < LANES; l += 2) {
+            const __m128d x = _mm_load_pd(vx + l), y = _mm_load_pd(vy + l);
+            const __m128d z = _mm_load_pd(vz + l), q = _mm_load_pd(vq + l);
+            const __m128d r = _mm_load_pd(vr + l);
+            for (int j = k; j <= top; j++) {
+                double* r0 = AT(k, j) + l;
+                double* r1 = AT(k + 1, j) + l;
+                double* r2 = AT(k + 2, j) + l;
+                __m128d a0 = _mm_load_pd(r0), a1 = _mm_load_pd(r1), a2 = _mm_load_pd(r2);
+                __m128d p = _mm_add_pd(_mm_add_pd(a0, _mm_mul_pd(q, a1)), _mm_mul_pd(r, a2));
+                _mm_store_pd(r2, _mm_sub_pd(a2, _mm_mul_pd(p, z)));
+                _mm_store_pd(r1, _mm_sub_pd(a1, _mm_mul_pd(p, y)));
+                _mm_store_pd(r0, _mm_sub_pd(a0, _mm_mul_pd(p, x)));
+            }
+            for (int i = imin; i <= imax; i++) {
+                double* c0 = AT(i, k) + l;
+                double* c1 = c0 + LANES;
+                double* c2 = c1 + LANES;
+                __m128d a0 = _mm_load_pd(c0), a1 = _mm_load_pd(c1), a2 = _mm_load_pd(c2);
+                __m128d p = _mm_add_pd(_mm_add_pd(_mm_mul_pd(x, a0), _mm_mul_pd(y, a1)),
+                                       _mm_mul_pd(z, a2));
+                _mm_store_pd(c2, _mm_sub_pd(a2, _mm_mul_pd(p, r)));
+                _mm_store_pd(c1, _mm_sub_pd(a1, _mm_mul_pd(p, q)));
+                _mm_store_pd(c0, _mm_sub_pd(a0, p));
+            }
+        }
+    }
+}
+
+static void solve_block(qr_block* b, int degree, double* re, double* im, size_t stride) {
+    int live[LANES];
+    for (int l = 0; l < LANES; l++)
+        if (b->hi[l] >= 0)
+            balance_lane(b, l, degree);
+
+    for (;;) {
+        int kmin = degree, kmax = -1, imin = degree;
+        for (int l = 0; l < LANES; l++) {
+            live[l] = prepare_lane(b, l, re + l, im + l, stride);
+            if (!live[l])
+                continue;
+            if (b->start[l] < kmin) kmin = b->start[l];
+            if (b->hi[l] - 1 > kmax) kmax = b->hi[l] - 1;
+            if (b->lo[l] < imin) imin = b->lo[l];
+        }
+        if (kmax < 0)
+            return;
+        sweep(b, live, kmin, kmax, imin);
+    }
+}
+
+int solve_poly_n_companion_batch(const double* coeffs, int degree, size_t n,
+                                 double* re, double* im, int* nroots) {
+    if (degree < 1 || degree > DSKYPOLY_COMPANION_MAX_DEGREE) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    qr_block b;
+    double c[DSKYPOLY_COMPANION_MAX_DEGREE + 1];
+    double zr[DSKYPOLY_COMPANION_MAX_DEGREE], zi[DSKYPOLY_COMPANION_MAX_DEGREE];
+    for (size_t base = 0; base < n; base += LANES) {
+        int lanes = n - base < LANES ? (int)(n - base) : LANES;
+        load_block(&b, coeffs, degree, n, base, lanes);
+        solve_block(&b, degree, re + base, im + base, n);
+
+        for (int l = 0; l < lanes; l++) {
+            size_t i = base + l;
+            int r = degree;
+            if (coeffs[i] == 0.0) {
+                r = 0;
+                for (int k = 0; k < degree; k++)
+                    re[k * n + i] = im[k * n + i] = 0.0;
+            } else if (b.failed[l]) {
+                // Rare: QR cycled past its iteration cap; Aberth's best
+                // approximations are still better than a partial spectrum
+                for (int k = 0; k <= degree; k++)
+                    c[k] = coeffs[k * n + i];
+                solve_poly_n_aberth(c, degree, zr, zi);
+                for (int k = 0; k < degree; k++) {
+                    re[k * n + i] = zr[k];
+                    im[k * n + i] = zi[k];
+                }
+            }
+            if (nroots)
+                nroots[i] = r;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,76 @@
+// === dskypoly_cpu.c for DSKYpoly ===
+// One-time host feature probe used by the solver dispatch table.
+//
+// CPUID reports what the silicon implements; XGETBV reports which register
+// state the operating system actually saves on a context switch. Both must
+// agree before a vector width is usable.
+
+#include <stdlib.h>
+#include <string.h>
+#include <cpuid.h>
+
+#include "dskypoly.h"
+
+static int cpu_level = -1;
+
+static unsigned long long read_xcr0(void) {
+    unsigned int lo, hi;
+    __asm__ volatile ("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return ((unsigned long long)hi << 32) | lo;
+}
+
+static int probe_cpu(void) {
+    unsigned int eax, ebx, ecx, edx;
+    int level = DSKYPOLY_ISA_SSE2;   // architectural baseline of x86-64
+
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+        return level;
+    if (!(ecx & bit_OSXSAVE) || !(ecx & bit_AVX))
+        return level;
+
+    unsigned long long xcr0 = read_xcr0();
+    if ((xcr0 & 0x6) != 0x6)         // XMM + YMM state
+        return level;
+
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+        return level;
+    if (ebx & bit_AVX2)
+        level = DSKYPOLY_ISA_AVX2;
+    if ((ebx & bit_AVX512F) && (xcr0 & 0xE0) == 0xE0)   // opmask + ZMM state
+        level = DSKYPOLY_ISA_AVX512;
+
+    return level;
+}
+
+// DSKYPOLY_ISA=sse2|avx2|avx512 caps the level, e.g. to reproduce what an
+// older host in the fleet will run. It can never raise it above the host's.
+static int apply_override(int level) {
+    const char* env = getenv("DSKYPOLY_ISA");
+    if (!env)
+        return level;
+
+    int cap = level;
+    if (strcmp(env, "sse2") == 0)
+        cap = DSKYPOLY_ISA_SSE2;
+    else if (strcmp(env, "avx2") == 0)
+        cap = DSKYPOLY_ISA_AVX2;
+    else if (strcmp(env, "avx512") == 0)
+        cap = DSKYPOLY_ISA_AVX512;
+
+    return cap < level ? cap : level;
+}
+
+int dskypoly_cpu_level(void) {
+    if (cpu_level < 0)
+        cpu_level = apply_override(probe_cpu());
+    return cpu_level;
+}
+
+const char* dskypoly_isa_name(int level) {
+    switch (level) {
+    case DSKYPOLY_ISA_AVX512: return "AVX-512";
+    case DSKYPOLY_ISA_AVX2:   return "AVX2";
+    case DSKYPOLY_ISA_SSE2:   return "SSE2";
+    default:                  return "unknown";
+    }
+}
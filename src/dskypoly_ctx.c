@@ -0,0 +1,152 @@
+// === dskypoly_ctx.c for DSKYpoly ===
+// Solver context: a bump arena for root buffers and solve scratch, handing
+// results back as non-owning views.
+//
+// Allocation bumps a pointer through the current block; a request that
+// does not fit opens a new block of at least twice the previous size. A
+// reset rewinds everything at once, and if the last round spilled into
+// more than one block they are replaced by a single block of the combined
+// size, so a service that solves same-sized batches reaches a steady state
+// of no allocator calls at all after its first request.
+
+#include <errno.h>
+#include <stdlib.h>
+
+#include "dskypoly.h"
+
+#define CTX_ALIGN       64            // cache line: planes never share one
+#define CTX_MIN_BLOCK   (64 << 10)
+
+typedef struct ctx_block {
+    struct ctx_block* prev;           // older blocks, freed or merged on reset
+    size_t size;                      // usable bytes after the header
+    size_t used;
+} ctx_block;
+
+struct dskypoly_ctx {
+    ctx_block* block;                 // current block (newest)
+    size_t total;                     // usable bytes over every block
+    int threads;                      // workers per solve, as dskypoly_solve
+};
+
+// The header is padded so the first allocation is aligned too
+#define CTX_HEADER ((sizeof(ctx_block) + CTX_ALIGN - 1) & ~(size_t)(CTX_ALIGN - 1))
+
+static ctx_block* new_block(size_t size, ctx_block* prev) {
+    ctx_block* b = aligned_alloc(CTX_ALIGN, CTX_HEADER + size);
+    if (!b)
+        return NULL;
+    b->prev = prev;
+    b->size = size;
+    b->used = 0;
+    return b;
+}
+
+static inline size_t round_align(size_t bytes) {
+    return (bytes + CTX_ALIGN - 1) & ~(size_t)(CTX_ALIGN - 1);
+}
+
+dskypoly_ctx* dskypoly_ctx_create(int threads, size_t reserve) {
+    dskypoly_ctx* ctx = malloc(sizeof(*ctx));
+    if (!ctx)
+        return NULL;
+    size_t size = round_align(reserve > CTX_MIN_BLOCK ? reserve : CTX_MIN_BLOCK);
+    ctx->block = new_block(size, NULL);
+    if (!ctx->block) {
+        free(ctx);
+        return NULL;
+    }
+    ctx->total = size;
+    ctx->threads = threads;
+    return ctx;
+}
+
+void dskypoly_ctx_destroy(dskypoly_ctx* ctx) {
+    if (!ctx)
+        return;
+    for (ctx_block* b = ctx->block; b;) {
+        ctx_block* prev = b->prev;
+        free(b);
+        b = prev;
+    }
+    free(ctx);
+}
+
+void dskypoly_ctx_reset(dskypoly_ctx* ctx) {
+    if (ctx->block->prev) {
+        // Spilled last time: trade the chain for one block that holds it all
+        ctx_block* merged = new_block(ctx->total, NULL);
+        if (merged) {
+            for (ctx_block* b = ctx->block; b;) {
+                ctx_block* prev = b->prev;
+                free(b);
+                b = prev;
+            }
+            ctx->block = merged;
+            return;
+        }
+    }
+    // One block (or no memory to merge): rewind every block in the chain
+    for (ctx_block* b = ctx->block; b; b = b->prev)
+        b->used = 0;
+}
+
+void* dskypoly_ctx_alloc(dskypoly_ctx* ctx, size_t bytes) {
+    bytes = round_align(bytes ? bytes : 1);
+    ctx_block* b = ctx->block;
+
+    // After a failed merge the older blocks are rewound but still chained
+    for (ctx_block* old = b; old; old = old->prev)
+        if (old->size - old->used >= bytes) {
+            b = old;
+            break;
+        }
+
+    if (b->size - b->used < bytes) {
+        size_t size = b->size * 2 > bytes ? b->size * 2 : bytes;
+        b = new_block(size, ctx->block);
+        if (!b) {
+            errno = ENOMEM;
+            return NULL;
+        }
+        ctx->block = b;
+        ctx->total += size;
+    }
+    void* p = (char*)b + CTX_HEADER + b->used;
+    b->used += bytes;
+    return p;
+}
+
+size_t dskypoly_ctx_capacity(const dskypoly_ctx* ctx) {
+    return ctx->total;
+}
+
+int dskypoly_ctx_solve(dskypoly_ctx* ctx, const dskypoly_poly* polys, size_t n,
+                       const dskypoly_refine* refine, dskypoly_roots_view* out) {
+    size_t roots = n * DSKYPOLY_MAX_DEGREE;
+    int refining = refine && refine->steps > 0;
+
+    double* re = dskypoly_ctx_alloc(ctx, roots * sizeof(double));
+    double* im = dskypoly_ctx_alloc(ctx, roots * sizeof(double));
+    int* nroots = dskypoly_ctx_alloc(ctx, n * sizeof(int));
+    double* err = refining ? dskypoly_ctx_alloc(ctx, roots * sizeof(double)) : NULL;
+    void* scratch = dskypoly_ctx_alloc(ctx, dskypoly_solve_scratch_bytes(n, ctx->threads));
+    if (!re || !im || !nroots || (refining && !err) || !scratch)
+        return -1;
+
+    dskypoly_refine polish;
+    if (refining) {
+        polish = *refine;
+        polish.err = err;
+    }
+    dskypoly_solve_sorted_in(scratch, polys, n, re, im, nroots, ctx->threads,
+                             refining ? &polish : NULL);
+
+    out->re = re;
+    out->im = im;
+    out->err = err;
+    out->nroots = nroots;
+    out->count = n;
+    out->stride = DSKYPOLY_MAX_DEGREE;
+    return 0;
+}
@@ -0,0 +1,117 @@
+// === dskypoly_dispatch.c for DSKYpoly ===
+// Binds every public batched solver symbol to the widest kernel the host
+// supports. The CPU is probed once at program start; each call afterwards
+// is one indirect jump through dskypoly_dispatch.
+//
+// Wider variants are weak references: a binary that only links the SSE2
+// objects still links, and the table simply never selects what is not there.
+
+#include "dskypoly.h"
+
+// Variants beyond the SSE2 baseline are optional at link time
+#pragma weak solve_poly_2_batch_avx2
+#pragma weak solve_poly_2_batch_avx512
+#pragma weak solve_poly_3_batch_avx2
+#pragma weak solve_poly_3_batch_avx512
+#pragma weak eval_poly_n_avx2
+#pragma weak eval_poly_n_complex_avx2
+
+// Statically bound to the baseline, so callers from other constructors
+// that run before dskypoly_dispatch_init still get a working solver.
+struct dskypoly_dispatch_table dskypoly_dispatch = {
+    .level = DSKYPOLY_ISA_SSE2,
+    .poly2_batch = solve_poly_2_batch_sse2,
+    .poly3_batch = solve_poly_3_batch_sse2,
+    .eval = eval_poly_n_sse2,
+    .eval_complex = eval_poly_n_complex_sse2,
+    .poly2f_batch = solve_poly_2_batch_f32_sse2,
+    .poly3f_batch = solve_poly_3_batch_f32_sse2,
+    .poly4f_batch = solve_poly_4_batch_f32_sse2,
+};
+
+// Pick the widest variant that is both linked and supported by the host
+static void* select_kernel(int level, void* sse2, void* avx2, void* avx512) {
+    if (level >= DSKYPOLY_ISA_AVX512 && avx512)
+        return avx512;
+    if (level >= DSKYPOLY_ISA_AVX2 && avx2)
+        return avx2;
+    return sse2;
+}
+
+__attribute__((constructor))
+static void dskypoly_dispatch_init(void) {
+    int level = dskypoly_cpu_level();
+
+    dskypoly_dispatch.poly2_batch = (dskypoly_poly2_batch_fn)select_kernel(level,
+        (void*)solve_poly_2_batch_sse2,
+        (void*)solve_poly_2_batch_avx2,
+        (void*)solve_poly_2_batch_avx512);
+    dskypoly_dispatch.poly3_batch = (dskypoly_poly3_batch_fn)select_kernel(level,
+        (void*)solve_poly_3_batch_sse2,
+        (void*)solve_poly_3_batch_avx2,
+        (void*)solve_poly_3_batch_avx512);
+    dskypoly_dispatch.eval = (dskypoly_eval_fn)select_kernel(level,
+        (void*)eval_poly_n_sse2,
+        (void*)eval_poly_n_avx2,
+        NULL);
+    dskypoly_dispatch.eval_complex = (dskypoly_eval_complex_fn)select_kernel(level,
+        (void*)eval_poly_n_complex_sse2,
+        (void*)eval_poly_n_complex_avx2,
+        NULL);
+    dskypoly_dispatch.poly2f_batch = (dskypoly_poly2f_batch_fn)select_kernel(level,
+        (void*)solve_poly_2_batch_f32_sse2,
+        (void*)solve_poly_2_batch_f32_avx2,
+        (void*)solve_poly_2_batch_f32_avx512);
+    dskypoly_dispatch.poly3f_batch = (dskypoly_poly3f_batch_fn)select_kernel(level,
+        (void*)solve_poly_3_batch_f32_sse2,
+        (void*)solve_poly_3_batch_f32_avx2,
+        (void*)solve_poly_3_batch_f32_avx512);
+    dskypoly_dispatch.poly4f_batch = (dskypoly_poly4f_batch_fn)select_kernel(level,
+        (void*)solve_poly_4_batch_f32_sse2,
+        (void*)solve_poly_4_batch_f32_avx2,
+        (void*)solve_poly_4_batch_f32_avx512);
+
+    dskypoly_dispatch.level = level;
+}
+
+// === Public entry points ===
+
+void solve_poly_2_batch(const double* a, const double* b, const double* c,
+                        size_t n,
+                        double* r1_real, double* r1_imag,
+                        double* r2_real, double* r2_imag) {
+    dskypoly_dispatch.poly2_batch(a, b, c, n, r1_real, r1_imag, r2_real, r2_imag);
+}
+
+void solve_poly_3_batch(const double* a, const double* b,
+                        const double* c, const double* d,
+                        size_t n, double* re, double* im) {
+    dskypoly_dispatch.poly3_batch(a, b, c, d, n, re, im);
+}
+
+void eval_poly_n(const double* coeffs, int n, const double* x, size_t m,
+                 double* p, double* dp) {
+    dskypoly_dispatch.eval(coeffs, n, x, m, p, dp);
+}
+
+void eval_poly_n_complex(const double* coeffs, int n,
+                         const double* xr, const double* xi, size_t m,
+                         double* pr, double* pi, double* dr, double* di) {
+    dskypoly_dispatch.eval_complex(coeffs, n, xr, xi, m, pr, pi, dr, di);
+}
+
+int solve_poly_2_batch_f32(const float* a, const float* b, const float* c, size_t n,
+                           float* r1_real, float* r1_imag,
+                           float* r2_real, float* r2_imag, float tol) {
+    return dskypoly_dispatch.poly2f_batch(a, b, c, n, r1_real, r1_imag, r2_real, r2_imag, tol);
+}
+
+int solve_poly_3_batch_f32(const float* a, const float* b, const float* c, const float* d,
+                           size_t n, float* re, float* im, float tol) {
+    return dskypoly_dispatch.poly3f_batch(a, b, c, d, n, re, im, tol);
+}
+
+int solve_poly_4_batch_f32(const float* a, const float* b, const float* c, const float* d,
+                           const float* e, size_t n, float* re, float* im, float tol) {
+    return dskypoly_dispatch.poly4f_batch(a, b, c, d, e, n, re, im, tol);
+}
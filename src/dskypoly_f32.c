@@ -0,0 +1,586 @@
+// === dskypoly_f32.c for DSKYpoly ===
+// Single precision batches: quadratics, cubics and quartics in float
+// lanes, twice the width of the double kernels, with the lanes float
+// cannot carry re-solved in double.
+//
+// Each kernel is the lane program of its double counterpart (the SSE2
+// quadratic, the batched cubic, the Ferrari production quartic) written
+// without branches: every path is evaluated and a per-lane mask picks
+// one. Blocks of F32_BLOCK lanes are plain loops the compiler vectorizes
+// (this file is built -fno-math-errno -fno-trapping-math so that sqrt and
+// the masked divisions stay packed) and the same source is compiled for
+// SSE2, AVX2 and AVX-512 below: 4, 8 and 16 lanes per instruction.
+//
+// Cubics and quartics are first scaled by a power of two that brings
+// their roots to about unit size (exact, so it costs no accuracy); the
+// quartic resolvent works with twelfth powers of the roots and would
+// otherwise leave float range for roots outside about 1e-3..1e3. A quartic
+// redone in double keeps its lane's scale, so Ferrari's absolute
+// thresholds see the same unit-size roots there.
+//
+// After the solve each lane estimates its own relative error as the size
+// of a Newton step at each root: the residual of the depressed polynomial
+// there plus the rounding its coefficients carry, over |f'| (the product
+// of the distances to the other roots, so clustered roots are caught),
+// plus the rounding of the shift back to x. The residual is what makes
+// this hold where Ferrari is not backward stable. Lanes whose estimate
+// exceeds the tolerance, and lanes with anything non-finite, are solved
+// again in double: flagged cubics gathered into solve_poly_3_batch calls,
+// quadratics and quartics one scalar call each. Float coefficients square
+// exactly in double, so double is all the extra precision those lanes
+// need; the x87 reference buys nothing over it here.
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "dskypoly.h"
+
+#define F32_BLOCK 16                    // lanes per block: one AVX-512 vector
+#define F32_U     5.9604645e-8f         // unit roundoff, 2^-24
+#define F32_BIQ   1.0e-6f               // |q| below this (relative) is a biquadratic
+#define F32_REDO  64                    // flagged lanes gathered per double redo
+
+static inline float sel(int m, float a, float b) {
+    return m ? a : b;
+}
+
+static inline int finite_f32(float x) {
+    return fabsf(x) < INFINITY;         // false for NaN too
+}
+
+static inline float clamp1(float x) {
+    x = x > -1.0f ? x : -1.0f;          // NaN -> -1, as maxsd in the scalar cubic
+    return x < 1.0f ? x : 1.0f;
+}
+
+// max(|re|, |im|) <= |z| <= |re| + |im|: the lower bound for the size of
+// a root, the upper one for an error
+static inline float mag_lo(float re, float im) {
+    float x = fabsf(re), y = fabsf(im);
+    return x > y ? x : y;
+}
+
+static inline float mag_hi(float re, float im) {
+    return fabsf(re) + fabsf(im);
+}
+
+static inline float dist2(float ar, float ai, float br, float bi) {
+    float dr = ar - br, di = ai - bi;
+    return dr * dr + di * di;
+}
+
+// 2^-e (x) and 2^e for e in -126..127, from the exponent field
+static inline float pow2(int e) {
+    int32_t bits = (e + 127) << 23;
+    float f;
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+// Binary exponent of |x| divided by k, as a float (0 and subnormals read as -127)
+static inline float exp_over(float x, float inv_k) {
+    int32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    return (float)(((bits >> 23) & 0xFF) - 127) * inv_k;
+}
+
+// Power-of-two scale for monic B, C, D, E: the largest of e(B), e(C)/2,
+// e(D)/3, e(E)/4, so every scaled coefficient is at most a few units
+static inline int root_scale(float B, float C, float D, float E) {
+    float e = exp_over(B, 1.0f);
+    float e2 = exp_over(C, 0.5f), e3 = exp_over(D, 1.0f / 3.0f), e4 = exp_over(E, 0.25f);
+    e = e > e2 ? e : e2;
+    e = e > e3 ? e : e3;
+    e = e > e4 ? e : e4;
+    int s = (int)e;
+    s = s > -126 ? s : -126;
+    return s < 126 ? s : 126;
+}
+
+// cbrt by the scalar cubic's recipe: exponent-bits seed, Halley steps
+// y <- y (y^3 + 2x)/(2y^3 + x); two take the ~3% seed past float precision
+static inline float cbrt_f32(float w) {
+    float x = fabsf(w);
+    int32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    bits = (int32_t)((float)bits * (1.0f / 3.0f)) + 709921077;
+    float y;
+    memcpy(&y, &bits, sizeof(y));
+    for (int k = 0; k < 2; k++) {
+        float y3 = y * y * y;
+        y = y * (y3 + 2.0f * x) / (2.0f * y3 + x);
+    }
+    return copysignf(y, w);
+}
+
+// Depressed cubic t^3 + 3kt + 2h = 0 in both of its forms. Cardano (disc >
+// 0): t1 = u + v real, t2,3 = tr ± i ti. Three real roots: t1 >= t2 >= t3
+// by 4c^3 - 3c = cos θ, as in cubic/src/solve_poly_3.asm.
+typedef struct {
+    int cardano;
+    float t1, t2, t3;                   // t2, t3: tr, ti in the Cardano form
+} depressed_roots;
+
+static inline depressed_roots depressed_solve(float h, float k) {
+    depressed_roots d;
+    float disc = h * h + k * k * k;
+    d.cardano = disc > 0.0f;
+
+    float sd = sqrtf(disc > 0.0f ? disc : 0.0f);
+    float u = cbrt_f32(-(h + copysignf(sd, h)));
+    float v = u != 0.0f ? -k / u : 0.0f;
+    float cr1 = u + v, ctr = -0.5f * cr1, cti = 0.8660254f * fabsf(u - v);
+
+    float m = sqrtf(-k > 0.0f ? -k : 0.0f);
+    float m3 = m * m * m;
+    float ct = clamp1(m3 != 0.0f ? -h / m3 : -1.0f);
+    float c = 0.5f + 0.5f * sqrtf(0.5f * (1.0f + ct));
+    for (int it = 0; it < 4; it++) {
+        float c2 = c * c;
+        float g = (4.0f * c2 - 3.0f) * c - ct, gp = 12.0f * c2 - 3.0f;
+        c -= gp != 0.0f ? g / gp : 0.0f;
+    }
+    float one_c2 = 1.0f - c * c;
+    float sn = 1.7320508f * sqrtf(one_c2 > 0.0f ? one_c2 : 0.0f);
+
+    d.t1 = sel(d.cardano, cr1, 2.0f * m * c);
+    d.t2 = sel(d.cardano, ctr, m * (sn - c));
+    d.t3 = sel(d.cardano, cti, -m * (sn + c));
+    return d;
+}
+
+// Largest real root of z^3 + Pz + Q = 0 (cubic_depressed_max_root)
+static inline float depressed_max_root(float P, float Q) {
+    depressed_roots d = depressed_solve(0.5f * Q, P * (1.0f / 3.0f));
+    return d.t1;
+}
+
+// |f(y)| at a complex root of the depressed cubic y^3 + py + q or quartic
+// y^4 + py^2 + qy + r, plus the rounding of evaluating it
+static inline float residual3(float yr, float yi, float p, float q) {
+    float wr = yr * yr - yi * yi + p, wi = 2.0f * yr * yi;
+    float fr = wr * yr - wi * yi + q, fi = wr * yi + wi * yr;
+    float m = mag_hi(yr, yi);
+    return mag_hi(fr, fi) + 4.0f * F32_U * m * m * m;
+}
+
+static inline float residual4(float yr, float yi, float p, float q, float r) {
+    float y2r = yr * yr - yi * yi, y2i = 2.0f * yr * yi;
+    float wr = y2r + p;
+    float fr = wr * y2r - y2i * y2i + q * yr + r, fi = wr * y2i + y2i * y2r + q * yi;
+    float m2 = mag_hi(y2r, y2i);
+    return mag_hi(fr, fi) + 4.0f * F32_U * m2 * m2;
+}
+
+// Does a root pass? df: |f| at the root plus the rounding the depressed
+// coefficients carry there, fp: |f'| there (so df/fp is a Newton step,
+// which holds whether or not the closed form was stable), shift: rounding
+// of the shift back to x, size: |root|
+static inline int root_ok(float df, float fp, float shift, float size, float tol) {
+    return df + shift * fp <= tol * size * fp;
+}
+
+// === Quadratic block ===
+// The SSE2 solve_poly_2 program: q = -(b + sign(b)√D)/2, roots q/a and
+// c/q in its textbook order; complex roots -b/2a ± i √(-D)/2a with r1_imag
+// of the sign of 1/a.
+// The relative error of either real root is about
+// u (b^2 + 4|ac|) / (√|D| (|b| + √|D|)).
+static inline __attribute__((always_inline))
+void quad_block(const float* restrict a, const float* restrict b, const float* restrict c,
+                float* restrict r1r, float* restrict r1i, float* restrict r2r, float* restrict r2i,
+                int* restrict bad, float tol) {
+    for (int l = 0; l < F32_BLOCK; l++) {
+        float A = a[l], Bq = b[l], Cq = c[l];
+        float ia = 1.0f / A;
+        float D = Bq * Bq - 4.0f * A * Cq;
+        float sd = sqrtf(fabsf(D));
+        float q = -0.5f * (Bq + copysignf(sd, Bq));
+        int real = D >= 0.0f;
+        int bneg = copysignf(1.0f, Bq) < 0.0f;   // q/a is r1 for b < 0 (and -0.0)
+        float qa = q * ia, cq = q != 0.0f ? Cq / q : qa;
+
+        r1r[l] = sel(real, sel(bneg, qa, cq), -0.5f * Bq * ia);
+        r2r[l] = sel(real, sel(bneg, cq, qa), -0.5f * Bq * ia);
+        r1i[l] = sel(real, 0.0f, 0.5f * sd * ia);
+        r2i[l] = sel(real, 0.0f, -0.5f * sd * ia);
+
+        float terms = Bq * Bq + 4.0f * fabsf(A * Cq);
+        bad[l] = !(4.0f * F32_U * terms <= tol * sd * (fabsf(Bq) + sd))
+               | !finite_f32(r1r[l] + r2r[l] + r1i[l]);
+    }
+}
+
+// === Cubic block ===
+// Monic, scaled to unit roots, depressed by s = -B/3 as in
+// solve_poly_3_batch. Root k of lane l goes to out[k][l] + i out[3 + k][l].
+static inline __attribute__((always_inline))
+void cubic_block(const float* restrict a, const float* restrict b,
+                 const float* restrict c, const float* restrict d,
+                 float (*restrict out)[F32_BLOCK], int* restrict bad, float tol) {
+    for (int l = 0; l < F32_BLOCK; l++) {
+        float ia = 1.0f / a[l];
+        float B = b[l] * ia, C = c[l] * ia, D = d[l] * ia;
+        int e = root_scale(B, C, D, 0.0f);
+        float lo = pow2(-e);
+        B = B * lo;                     // one factor at a time: lo^3 may underflow
+        C = C * lo * lo;
+        D = D * lo * lo * lo;
+
+        float s = B * (-1.0f / 3.0f);
+        float as = fabsf(s), aB = fabsf(B), aC = fabsf(C), aD = fabsf(D);
+        float p = (3.0f * s + 2.0f * B) * s + C;
+        float q = ((s + B) * s + C) * s + D;
+        float dk = F32_U * ((3.0f * as + 2.0f * aB) * as + aC);       // 3 δk
+        float dh = F32_U * (((as + aB) * as + aC) * as + aD);        // 2 δh
+        depressed_roots t = depressed_solve(0.5f * q, p * (1.0f / 3.0f));
+
+        // Roots T1, T2, T3 as complex numbers
+        float T1r = t.t1, T2r = t.t2, T3r = sel(t.cardano, t.t2, t.t3);
+        float T1i = 0.0f, T2i = sel(t.cardano, t.t3, 0.0f), T3i = sel(t.cardano, -t.t3, 0.0f);
+        float d12 = sqrtf(dist2(T1r, T1i, T2r, T2i));
+        float d13 = sqrtf(dist2(T1r, T1i, T3r, T3i));
+        float d23 = sqrtf(dist2(T2r, T2i, T3r, T3i));
+        float f1 = residual3(T1r, T1i, p, q) + dk * mag_hi(T1r, T1i) + dh;
+        float f2 = residual3(T2r, T2i, p, q) + dk * mag_hi(T2r, T2i) + dh;
+        float f3 = residual3(T3r, T3i, p, q) + dk * mag_hi(T3r, T3i) + dh;
+        float shift = 2.0f * F32_U * as;
+
+        float X1r = T1r + s, X2r = T2r + s, X3r = T3r + s;
+        int ok = root_ok(f1, d12 * d13, shift, mag_lo(X1r, T1i), tol)
+               & root_ok(f2, d12 * d23, shift, mag_lo(X2r, T2i), tol)
+               & root_ok(f3, d13 * d23, shift, mag_lo(X3r, T3i), tol);
+        float hi = pow2(e);
+        bad[l] = !ok | !finite_f32((X1r + X2r + X3r + T2i) * hi);
+
+        out[0][l] = X1r * hi;
+        out[1][l] = X2r * hi;
+        out[2][l] = X3r * hi;
+        out[3][l] = T1i * hi;
+        out[4][l] = T2i * hi;
+        out[5][l] = T3i * hi;
+    }
+}
+
+// === Quartic block ===
+// solve_poly_4_production lane by lane: depressed y^4 + py^2 + qy + r by
+// s = -B/4, Ferrari through the resolvent's largest root m (one Newton
+// step), or the biquadratic z^2 + pz + r, y = ±√z, when q is negligible
+// or m <= 0. Root k of lane l goes to out[k][l] + i out[4 + k][l].
+static inline __attribute__((always_inline))
+void quartic_block(const float* restrict a, const float* restrict b, const float* restrict c,
+                   const float* restrict d, const float* restrict e_,
+                   float (*restrict out)[F32_BLOCK], int* restrict bad, float tol) {
+    for (int l = 0; l < F32_BLOCK; l++) {
+        float ia = 1.0f / a[l];
+        float B = b[l] * ia, C = c[l] * ia, D = d[l] * ia, E = e_[l] * ia;
+        int e = root_scale(B, C, D, E);
+        float lo = pow2(-e);
+        B = B * lo;
+        C = C * lo * lo;
+        D = D * lo * lo * lo;
+        E = E * lo * lo * lo * lo;
+
+        float s = -0.25f * B;
+        float as = fabsf(s), aB = fabsf(B), aC = fabsf(C), aD = fabsf(D), aE = fabsf(E);
+        float p = (6.0f * s + 3.0f * B) * s + C;
+        float q = ((4.0f * s + 3.0f * B) * s + 2.0f * C) * s + D;
+        float r = (((s + B) * s + C) * s + D) * s + E;
+        float dp = F32_U * ((6.0f * as + 3.0f * aB) * as + aC);
+        float dq = F32_U * (((4.0f * as + 3.0f * aB) * as + 2.0f * aC) * as + aD);
+        float dr = F32_U * ((((as + aB) * as + aC) * as + aD) * as + aE);
+
+        // --- Ferrari: m, then y^2 ∓ σy + γ± = 0 ---
+        float P = -p * p * (1.0f / 12.0f) - r;
+        float Q = -p * p * p * (1.0f / 108.0f) + p * r * (1.0f / 3.0f) - 0.125f * q * q;
+        float m = depressed_max_root(P, Q) - p * (1.0f / 3.0f);
+        float c3 = 0.25f * p * p - r;
+        float R = ((m + p) * m + c3) * m - 0.125f * q * q;
+        float Rp = (3.0f * m + 2.0f * p) * m + c3;
+        m -= Rp != 0.0f ? R / Rp : 0.0f;
+        int biq = (fabsf(q) <= F32_BIQ * (1.0f + fabsf(p) + fabsf(r))) | !(m > 0.0f);
+
+        float sigma = sqrtf(m > 0.0f ? 2.0f * m : 0.0f);
+        float g0 = 0.5f * p + m;
+        float eq = sigma != 0.0f ? q / (2.0f * sigma) : 0.0f;
+        float gp = g0 + eq, gm = g0 - eq;
+        int differ = g0 * eq < 0.0f;                     // γ- has no cancellation
+        float gp2 = sel(differ, sel(gm != 0.0f, r / gm, gp), gp);
+        float gm2 = sel(differ, gm, sel(gp != 0.0f, r / gp, gm));
+
+        // y^2 - σy + γ+ and y^2 + σy + γ-, each real or a conjugate pair
+        float D1 = sigma * sigma - 4.0f * gp2, D2 = sigma * sigma - 4.0f * gm2;
+        float sq1 = sqrtf(fabsf(D1)), sq2 = sqrtf(fabsf(D2));
+        float u1 = -0.5f * (-sigma - sq1), u2 = -0.5f * (sigma + sq2);
+        float v1 = u1 != 0.0f ? gp2 / u1 : gp2, v2 = u2 != 0.0f ? gm2 / u2 : gm2;
+        int real1 = D1 >= 0.0f, real2 = D2 >= 0.0f;
+        float f0r = sel(real1, u1, 0.5f * sigma), f0i = sel(real1, 0.0f, 0.5f * sq1);
+        float f1r = sel(real1, v1, 0.5f * sigma), f1i = sel(real1, 0.0f, -0.5f * sq1);
+        float f2r = sel(real2, u2, -0.5f * sigma), f2i = sel(real2, 0.0f, 0.5f * sq2);
+        float f3r = sel(real2, v2, -0.5f * sigma), f3i = sel(real2, 0.0f, -0.5f * sq2);
+
+        // --- Biquadratic: z^2 + pz + r = 0, y = ±√z ---
+        float Db = p * p - 4.0f * r;
+        int breal = Db >= 0.0f;
+        float sqb = sqrtf(fabsf(Db));
+        float z1 = -0.5f * (p + copysignf(sqb, p));
+        float z2 = z1 != 0.0f ? r / z1 : r;
+        float w1 = sqrtf(fabsf(z1)), w2 = sqrtf(fabsf(z2));
+        int pos1 = z1 >= 0.0f, pos2 = z2 >= 0.0f;
+        float beta = 0.5f * sqb, alpha = -0.5f * p, mz = sqrtf(fabsf(r));
+        int apos = alpha >= 0.0f;
+        float wa = sqrtf(0.5f * (mz + fabsf(alpha)));
+        float wb = wa != 0.0f ? 0.5f * beta / wa : 0.0f;
+        float wr = sel(apos, wa, wb), wi = sel(apos, wb, wa);
+        float b0r = sel(breal, sel(pos1, w1, 0.0f), wr), b0i = sel(breal, sel(pos1, 0.0f, w1), wi);
+        float b1r = sel(breal, sel(pos1, -w1, 0.0f), wr), b1i = sel(breal, sel(pos1, 0.0f, -w1), -wi);
+        float b2r = sel(breal, sel(pos2, w2, 0.0f), -wr), b2i = sel(breal, sel(pos2, 0.0f, w2), -wi);
+        float b3r = sel(breal, sel(pos2, -w2, 0.0f), -wr), b3i = sel(breal, sel(pos2, 0.0f, -w2), wi);
+
+        float y0r = sel(biq, b0r, f0r), y0i = sel(biq, b0i, f0i);
+        float y1r = sel(biq, b1r, f1r), y1i = sel(biq, b1i, f1i);
+        float y2r = sel(biq, b2r, f2r), y2i = sel(biq, b2i, f2i);
+        float y3r = sel(biq, b3r, f3r), y3i = sel(biq, b3i, f3i);
+
+        // --- Error estimate: |f'(y_k)| from the six root distances ---
+        float d01 = sqrtf(dist2(y0r, y0i, y1r, y1i)), d02 = sqrtf(dist2(y0r, y0i, y2r, y2i));
+        float d03 = sqrtf(dist2(y0r, y0i, y3r, y3i)), d12 = sqrtf(dist2(y1r, y1i, y2r, y2i));
+        float d13 = sqrtf(dist2(y1r, y1i, y3r, y3i)), d23 = sqrtf(dist2(y2r, y2i, y3r, y3i));
+        float m0 = mag_hi(y0r, y0i), m1 = mag_hi(y1r, y1i);
+        float m2 = mag_hi(y2r, y2i), m3 = mag_hi(y3r, y3i);
+        float f0 = residual4(y0r, y0i, p, q, r) + (m0 * dp + dq) * m0 + dr;
+        float f1 = residual4(y1r, y1i, p, q, r) + (m1 * dp + dq) * m1 + dr;
+        float f2 = residual4(y2r, y2i, p, q, r) + (m2 * dp + dq) * m2 + dr;
+        float f3 = residual4(y3r, y3i, p, q, r) + (m3 * dp + dq) * m3 + dr;
+        float shift = 2.0f * F32_U * as;
+        float x0r = y0r + s, x1r = y1r + s, x2r = y2r + s, x3r = y3r + s;
+        int ok = root_ok(f0, d01 * d02 * d03, shift, mag_lo(x0r, y0i), tol)
+               & root_ok(f1, d01 * d12 * d13, shift, mag_lo(x1r, y1i), tol)
+               & root_ok(f2, d02 * d12 * d23, shift, mag_lo(x2r, y2i), tol)
+               & root_ok(f3, d03 * d13 * d23, shift, mag_lo(x3r, y3i), tol);
+        float hi = pow2(e);
+        bad[l] = !ok | !finite_f32((x0r + x1r + x2r + x3r + m0 + m1 + m2 + m3) * hi);
+
+        out[0][l] = x0r * hi;
+        out[1][l] = x1r * hi;
+        out[2][l] = x2r * hi;
+        out[3][l] = x3r * hi;
+        out[4][l] = y0i * hi;
+        out[5][l] = y1i * hi;
+        out[6][l] = y2i * hi;
+        out[7][l] = y3i * hi;
+    }
+}
+
+// === Double-precision redo of flagged lanes ===
+
+static void redo_quad(const float* a, const float* b, const float* c, size_t i,
+                      float* r1r, float* r1i, float* r2r, float* r2i) {
+    double x1r, x1i, x2r, x2i;
+    solve_poly_2(a[i], b[i], c[i], &x1r, &x1i, &x2r, &x2i);
+    r1r[i] = (float)x1r;
+    r1i[i] = (float)x1i;
+    r2r[i] = (float)x2r;
+    r2i[i] = (float)x2i;
+}
+
+// Flagged cubics are gathered and go through solve_poly_3_batch together
+// (it matches solve_poly_3 bit for bit); quartics one at a time, scaled by
+// 2^-e as in quartic_block and the roots by 2^e after
+static void redo_poly(int degree, const float* const* coef, const size_t* lane, int count,
+                      size_t n, float* re, float* im) {
+    if (degree == 3) {
+        double g[4][F32_REDO] = { { 0.0 } };
+        double zr[3 * F32_REDO], zi[3 * F32_REDO];
+        for (int k = 0; k < 4; k++)
+            for (int j = 0; j < count; j++)
+                g[k][j] = coef[k][lane[j]];
+        solve_poly_3_batch(g[0], g[1], g[2], g[3], count, zr, zi);
+        for (int j = 0; j < count; j++)
+            for (int k = 0; k < 3; k++) {
+                re[k * n + lane[j]] = (float)zr[k * count + j];
+                im[k * n + lane[j]] = (float)zi[k * count + j];
+            }
+        return;
+    }
+    for (int j = 0; j < count; j++) {
+        size_t i = lane[j];
+        float ia = 1.0f / coef[0][i];
+        int e = root_scale(coef[1][i] * ia, coef[2][i] * ia, coef[3][i] * ia, coef[4][i] * ia);
+        double lo = ldexp(1.0, -e), hi = ldexp(1.0, e);
+        double zr[4] = { NAN, NAN, NAN, NAN }, zi[4] = { NAN, NAN, NAN, NAN };
+        solve_poly_4_production(coef[0][i], coef[1][i] * lo, coef[2][i] * lo * lo,
+                                coef[3][i] * lo * lo * lo, coef[4][i] * lo * lo * lo * lo,
+                                zr, zi);
+        for (int k = 0; k < 4; k++) {
+            re[k * n + i] = (float)(zr[k] * hi);
+            im[k * n + i] = (float)(zi[k] * hi);
+        }
+    }
+}
+
+static inline float f32_tol(float tol) {
+    return tol > 0.0f ? tol : DSKYPOLY_F32_TOL;
+}
+
+// Lanes past the end of a batch: a = 1, everything else 0
+static void pad_block(float* dst, const float* src, size_t m, float fill) {
+    memcpy(dst, src, m * sizeof(float));
+    for (size_t l = m; l < F32_BLOCK; l++)
+        dst[l] = fill;
+}
+
+// Block results out to a root plane; a full block is one fixed-size copy
+// the compiler inlines rather than a memcpy call per plane
+static inline void put_block(float* dst, const float* src, size_t m) {
+    if (m == F32_BLOCK)
+        memcpy(dst, src, F32_BLOCK * sizeof(float));
+    else
+        memcpy(dst, src, m * sizeof(float));
+}
+
+// === Drivers: full blocks in place, the ragged tail through padded copies ===
+
+static inline __attribute__((always_inline))
+int quad_run(const float* a, const float* b, const float* c, size_t n,
+             float* r1r, float* r1i, float* r2r, float* r2i, float tol) {
+    int bad[F32_BLOCK];
+    int redone = 0;
+    tol = f32_tol(tol);
+    for (size_t i = 0; i < n; i += F32_BLOCK) {
+        size_t m = n - i < F32_BLOCK ? n - i : F32_BLOCK;
+        if (m == F32_BLOCK) {
+            quad_block(a + i, b + i, c + i, r1r + i, r1i + i, r2r + i, r2i + i, bad, tol);
+        } else {
+            float ta[F32_BLOCK], tb[F32_BLOCK], tc[F32_BLOCK];
+            float o[4][F32_BLOCK];
+            pad_block(ta, a + i, m, 1.0f);
+            pad_block(tb, b + i, m, 0.0f);
+            pad_block(tc, c + i, m, 0.0f);
+            quad_block(ta, tb, tc, o[0], o[1], o[2], o[3], bad, tol);
+            memcpy(r1r + i, o[0], m * sizeof(float));
+            memcpy(r1i + i, o[1], m * sizeof(float));
+            memcpy(r2r + i, o[2], m * sizeof(float));
+            memcpy(r2i + i, o[3], m * sizeof(float));
+        }
+        int any = 0;
+        for (int l = 0; l < F32_BLOCK; l++)
+            any |= bad[l];
+        for (size_t l = 0; any && l < m; l++)
+            if (bad[l]) {
+                redo_quad(a, b, c, i + l, r1r, r1i, r2r, r2i);
+                redone++;
+            }
+    }
+    return redone;
+}
+
+static inline __attribute__((always_inline))
+int poly_run(int degree, const float* const* coef, size_t n, float* re, float* im, float tol) {
+    // Root planes are staged per block: eight output streams off two base
+    // pointers are more than the vectorizer will check for overlap
+    int bad[F32_BLOCK];
+    float out[8][F32_BLOCK];
+    size_t lane[F32_REDO];
+    int pending = 0, redone = 0;
+    tol = f32_tol(tol);
+    for (size_t i = 0; i < n; i += F32_BLOCK) {
+        size_t m = n - i < F32_BLOCK ? n - i : F32_BLOCK;
+        const float* in[5];
+        float t[5][F32_BLOCK];
+        for (int k = 0; k <= degree; k++) {
+            in[k] = coef[k] + i;
+            if (m < F32_BLOCK) {
+                pad_block(t[k], in[k], m, k ? 0.0f : 1.0f);
+                in[k] = t[k];
+            }
+        }
+        if (degree == 3)
+            cubic_block(in[0], in[1], in[2], in[3], out, bad, tol);
+        else
+            quartic_block(in[0], in[1], in[2], in[3], in[4], out, bad, tol);
+        for (int k = 0; k < degree; k++) {
+            put_block(re + k * n + i, out[k], m);
+            put_block(im + k * n + i, out[degree + k], m);
+        }
+        int any = 0;
+        for (int l = 0; l < F32_BLOCK; l++)
+            any |= bad[l];
+        for (size_t l = 0; any && l < m; l++)
+            if (bad[l]) {
+                lane[pending++] = i + l;
+                redone++;
+            }
+        // Room for another block's worth, or flush
+        if (pending > F32_REDO - F32_BLOCK) {
+            redo_poly(degree, coef, lane, pending, n, re, im);
+            pending = 0;
+        }
+    }
+    if (pending)
+        redo_poly(degree, coef, lane, pending, n, re, im);
+    return redone;
+}
+
+// === One instance per vector width ===
+
+int solve_poly_2_batch_f32_sse2(const float* a, const float* b, const float* c, size_t n,
+                                float* r1_real, float* r1_imag,
+                                float* r2_real, float* r2_imag, float tol) {
+    return quad_run(a, b, c, n, r1_real, r1_imag, r2_real, r2_imag, tol);
+}
+
+__attribute__((target("avx2")))
+int solve_poly_2_batch_f32_avx2(const float* a, const float* b, const float* c, size_t n,
+                                float* r1_real, float* r1_imag,
+                                float* r2_real, float* r2_imag, float tol) {
+    return quad_run(a, b, c, n, r1_real, r1_imag, r2_real, r2_imag, tol);
+}
+
+__attribute__((target("avx512f")))
+int solve_poly_2_batch_f32_avx512(const float* a, const float* b, const float* c, size_t n,
+                                  float* r1_real, float* r1_imag,
+                                  float* r2_real, float* r2_imag, float tol) {
+    return quad_run(a, b, c, n, r1_real, r1_imag, r2_real, r2_imag, tol);
+}
+
+int solve_poly_3_batch_f32_sse2(const float* a, const float* b, const float* c, const float* d,
+                                size_t n, float* re, float* im, float tol) {
+    const float* coef[4] = { a, b, c, d };
+    return poly_run(3, coef, n, re, im, tol);
+}
+
+__attribute__((target("avx2")))
+int solve_poly_3_batch_f32_avx2(const float* a, const float* b, const float* c, const float* d,
+                                size_t n, float* re, float* im, float tol) {
+    const float* coef[4] = { a, b, c, d };
+    return poly_run(3, coef, n, re, im, tol);
+}
+
+__attribute__((target("avx512f")))
+int solve_poly_3_batch_f32_avx512(const float* a, const float* b, const float* c, const float* d,
+                                  size_t n, float* re, float* im, float tol) {
+    const float* coef[4] = { a, b, c, d };
+    return poly_run(3, coef, n, re, im, tol);
+}
+
+int solve_poly_4_batch_f32_sse2(const float* a, const float* b, const float* c, const float* d,
+                                const float* e, size_t n, float* re, float* im, float tol) {
+    const float* coef[5] = { a, b, c, d, e };
+    return poly_run(4, coef, n, re, im, tol);
+}
+
+__attribute__((target("avx2")))
+int solve_poly_4_batch_f32_avx2(const float* a, const float* b, const float* c, const float* d,
+                                const float* e, size_t n, float* re, float* im, float tol) {
+    const float* coef[5] = { a, b, c, d, e };
+    return poly_run(4, coef, n, re, im, tol);
+}
+
+__attribute__((target("avx512f")))
+int solve_poly_4_batch_f32_avx512(const float* a, const float* b, const float* c, const float* d,
+                                  const float* e, size_t n, float* re, float* im, float tol) {
+    const float* coef[5] = { a, b, c, d, e };
+    return poly_run(4, coef, n, re, im, tol);
+}
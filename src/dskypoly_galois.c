@@ -0,0 +1,525 @@
+// === dskypoly_galois.c for DSKYpoly ===
+// Exact factor and Galois-group information from reductions mod small primes.
+//
+// Take an integer polynomial f whose leading coefficient is not divisible
+// by p. Reduce it mod p. If f mod p stays squarefree, the degrees of its
+// irreducible factors are the cycle type of a Frobenius element of the
+// Galois group (Dedekind). By Chebotarev, every cycle type of the group
+// turns up among the primes, with its own frequency. Three cheap facts
+// follow:
+//
+//   - The degree of a rational factor of f is a sum of some of the factor
+//     degrees mod p, for every good prime p.
+//   - If f has no root mod some p, it has no rational root.
+//   - Suppose an irreducible quintic splits as 1+1+3 or 2+3 mod some p.
+//     Its group then holds a 3-cycle, and the only transitive subgroups of
+//     S5 with a 3-cycle are A5 and S5. Neither is solvable.
+//
+// Roots mod p come from evaluating f at every residue at once. The sweep
+// runs in SSE2 float lanes and reduces with a multiplied reciprocal. Values
+// stay below 2^24, so every step is exact. The degree-2 factors come from
+// gcd(f, x^(p^2) - x) with scalar arithmetic on polynomials of degree 5 or
+// less.
+//
+// A rational root u/v has v dividing the leading coefficient. So it reduces
+// to a simple root of f mod any prime where the roots are all simple. Each
+// such root is Hensel lifted to a p-adic precision beyond the Cauchy bound
+// on a0*u/v. The lifted value is read back as a rational and confirmed by
+// exact division. The cofactor keeps integer coefficients (Gauss).
+// Polynomials that are not integral, or whose coefficients are too large,
+// get only their zero roots split off.
+
+#include <emmintrin.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "dskypoly.h"
+
+#define GALOIS_LANES 64         // residues a sweep covers: every p in the table is below
+#define GALOIS_PRIMES 12        // good primes behind a classification
+#define SPLIT_PRIMES 6          // good primes tried for a no-root witness (or more,
+                                // until one has nothing but simple roots)
+#define COFACTOR_MAX (1ll << 52)  // cofactor coefficients stay exact doubles
+
+static const uint8_t small_primes[] = {
+    3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59, 61
+};
+#define SMALL_PRIMES (int)(sizeof(small_primes) / sizeof(small_primes[0]))
+
+#define MAGIC(p) (UINT64_MAX / (p) + 1)
+static const uint64_t prime_magic[] = {
+    MAGIC(3), MAGIC(5), MAGIC(7), MAGIC(11), MAGIC(13), MAGIC(17), MAGIC(19), MAGIC(23),
+    MAGIC(29), MAGIC(31), MAGIC(37), MAGIC(41), MAGIC(43), MAGIC(47), MAGIC(53), MAGIC(59),
+    MAGIC(61)
+};
+
+typedef unsigned __int128 u128;
+
+// === F_p: polynomials of degree <= 2*DSKYPOLY_MAX_DEGREE, lowest term first ===
+
+static uint32_t fp_pow(uint32_t a, uint32_t e, uint32_t p) {
+    uint32_t r = 1;
+    for (; e; e >>= 1, a = a * a % p)
+        if (e & 1)
+            r = r * a % p;
+    return r;
+}
+
+static uint32_t fp_inv(uint32_t a, uint32_t p) {
+    return fp_pow(a, p - 2, p);
+}
+
+static int fp_degree(const uint32_t* a, int d) {
+    while (d >= 0 && a[d] == 0)
+        d--;
+    return d;
+}
+
+// a mod m in place for a monic m of degree dm >= 1; returns the degree left
+static int fp_rem(uint32_t* a, int da, const uint32_t* m, int dm, uint32_t p) {
+    for (int i = da; i >= dm; i--) {
+        uint32_t q = a[i];
+        for (int j = 0; q && j < dm; j++)
+            a[i - dm + j] = (a[i - dm + j] + (p - q) * m[j]) % p;
+        a[i] = 0;
+    }
+    return fp_degree(a, dm - 1);
+}
+
+static void fp_monic(uint32_t* a, int d, uint32_t p) {
+    uint32_t s = fp_inv(a[d], p);
+    for (int i = 0; i <= d; i++)
+        a[i] = a[i] * s % p;
+}
+
+// Degree of gcd(a, b); both are clobbered, -1 if both are zero
+static int fp_gcd_degree(uint32_t* a, int da, uint32_t* b, int db, uint32_t p) {
+    da = fp_degree(a, da);
+    db = fp_degree(b, db);
+    while (db >= 0) {
+        fp_monic(b, db, p);
+        if (db == 0)
+            return 0;
+        da = fp_rem(a, da, b, db, p);
+        uint32_t* t = a;
+        a = b;
+        b = t;
+        int dt = da;
+        da = db;
+        db = dt;
+    }
+    return da;
+}
+
+// x^e mod m for a monic m of degree d >= 2, into out[0..d)
+static void fp_pow_x(uint32_t* out, uint32_t e, const uint32_t* m, int d, uint32_t p) {
+    uint32_t base[2 * DSKYPOLY_MAX_DEGREE] = { 0, 1 };
+    uint32_t acc[2 * DSKYPOLY_MAX_DEGREE] = { 1 };
+    uint32_t t[2 * DSKYPOLY_MAX_DEGREE];
+    for (; e; e >>= 1) {
+        if (e & 1) {
+            memset(t, 0, sizeof(t));
+            for (int i = 0; i < d; i++)
+                for (int j = 0; j < d; j++)
+                    t[i + j] = (t[i + j] + acc[i] * base[j]) % p;
+            fp_rem(t, 2 * d - 2, m, d, p);
+            memcpy(acc, t, d * sizeof(*t));
+        }
+        memset(t, 0, sizeof(t));
+        for (int i = 0; i < d; i++)
+            for (int j = 0; j < d; j++)
+                t[i + j] = (t[i + j] + base[i] * base[j]) % p;
+        fp_rem(t, 2 * d - 2, m, d, p);
+        memcpy(base, t, d * sizeof(*t));
+    }
+    memcpy(out, acc, d * sizeof(*acc));
+}
+
+// t mod p for 0 <= t < 2^24: the float quotient is off by one at most
+static inline __m128 mod_ps(__m128 t, __m128 p, __m128 inv) {
+    t = _mm_sub_ps(t, _mm_mul_ps(_mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_mul_ps(t, inv))), p));
+    t = _mm_sub_ps(t, _mm_and_ps(_mm_cmpge_ps(t, p), p));
+    return _mm_add_ps(t, _mm_and_ps(_mm_cmplt_ps(t, _mm_setzero_ps()), p));
+}
+
+// f mod p at every residue, eight per pass; hi[k] is the coefficient of
+// x^(n-k). zero[x] is set for the roots; returns how many there are.
+// Reduced residues times x < 64 grow by 6 bits a Horner step, so three
+// steps in a row stay exact below 2^24 and only every third is reduced.
+static int fp_roots(const uint32_t* hi, int n, uint32_t p, uint8_t* zero) {
+    const __m128 vp = _mm_set1_ps((float)p), inv = _mm_set1_ps(1.0f / (float)p);
+    const __m128 four = _mm_set1_ps(4.0f);
+    int count = 0;
+    for (uint32_t base = 0; base < p; base += 8) {
+        __m128 x0 = _mm_add_ps(_mm_set1_ps((float)base), _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f));
+        __m128 x1 = _mm_add_ps(x0, four);
+        __m128 a0 = _mm_set1_ps((float)hi[0]), a1 = a0;
+        for (int k = 1; k <= n; k++) {
+            __m128 c = _mm_set1_ps((float)hi[k]);
+            a0 = _mm_add_ps(_mm_mul_ps(a0, x0), c);
+            a1 = _mm_add_ps(_mm_mul_ps(a1, x1), c);
+            if (k % 3 == 0 || k == n) {
+                a0 = mod_ps(a0, vp, inv);
+                a1 = mod_ps(a1, vp, inv);
+            }
+        }
+        unsigned mask = _mm_movemask_ps(_mm_cmpeq_ps(a0, _mm_setzero_ps()))
+                      | _mm_movemask_ps(_mm_cmpeq_ps(a1, _mm_setzero_ps())) << 4;
+        if (p - base < 8)
+            mask &= (1u << (p - base)) - 1;
+        for (int j = 0; j < 8; j++)
+            zero[base + j] = (uint8_t)(mask >> j & 1);
+        count += __builtin_popcount(mask);
+    }
+    return count;
+}
+
+// Primes 3, 5 and 7 (small_primes[0..2]) in one pass, one eight-lane
+// block each: most polynomials without a rational root are told so by
+// one of them, at the latency of a single sweep
+static void fp_roots_first3(const uint32_t hi[3][DSKYPOLY_MAX_DEGREE + 1], int n,
+                            uint8_t zero[3][GALOIS_LANES], int* count) {
+    __m128 vp[3], inv[3], a[3][2];
+    const __m128 x0 = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+    const __m128 x1 = _mm_setr_ps(4.0f, 5.0f, 6.0f, 7.0f);
+    for (int j = 0; j < 3; j++) {
+        vp[j] = _mm_set1_ps((float)small_primes[j]);
+        inv[j] = _mm_set1_ps(1.0f / (float)small_primes[j]);
+        a[j][0] = a[j][1] = _mm_set1_ps((float)hi[j][0]);
+    }
+    for (int k = 1; k <= n; k++)
+        for (int j = 0; j < 3; j++) {
+            __m128 c = _mm_set1_ps((float)hi[j][k]);
+            a[j][0] = _mm_add_ps(_mm_mul_ps(a[j][0], x0), c);
+            a[j][1] = _mm_add_ps(_mm_mul_ps(a[j][1], x1), c);
+            if (k % 3 == 0 || k == n) {
+                a[j][0] = mod_ps(a[j][0], vp[j], inv[j]);
+                a[j][1] = mod_ps(a[j][1], vp[j], inv[j]);
+            }
+        }
+    for (int j = 0; j < 3; j++) {
+        unsigned mask = _mm_movemask_ps(_mm_cmpeq_ps(a[j][0], _mm_setzero_ps()))
+                      | _mm_movemask_ps(_mm_cmpeq_ps(a[j][1], _mm_setzero_ps())) << 4;
+        mask &= (1u << small_primes[j]) - 1;
+        for (int x = 0; x < 8; x++)
+            zero[j][x] = (uint8_t)(mask >> x & 1);
+        count[j] = __builtin_popcount(mask);
+    }
+}
+
+// Clears zero[x] for the roots that are repeated (f'(x) = 0 mod p) and
+// returns how many simple ones are left; the reduction is a multiply by
+// the reciprocal, as in the sweep
+static int fp_simple(const uint32_t* hi, int n, uint32_t p, uint8_t* zero) {
+    float fp = (float)p, inv = 1.0f / fp;
+    int simple = 0;
+    for (uint32_t x = 0; x < p; x++) {
+        if (!zero[x])
+            continue;
+        float d = 0.0f;
+        for (int k = 0; k < n; k++) {
+            d = d * (float)x + (float)((n - k) * hi[k]);    // < 61 * 63 + 5 * 60
+            d -= (float)(int)(d * inv) * fp;
+            d = d >= fp ? d - fp : d;
+            d = d < 0.0f ? d + fp : d;
+        }
+        zero[x] = d != 0.0f;
+        simple += zero[x];
+    }
+    return simple;
+}
+
+// === Z: the integer polynomial, highest term first ===
+
+static int64_t abs64(int64_t x) {
+    return x < 0 ? -x : x;
+}
+
+static int64_t gcd64(int64_t a, int64_t b) {
+    a = abs64(a);
+    b = abs64(b);
+    while (b) {
+        int64_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+// coeffs as integers, if every one is an integer of at most DSKYPOLY_GALOIS_COEF_MAX
+static int integral(const double* c, int n, int64_t* a) {
+    for (int k = 0; k <= n; k++) {
+        if (!(c[k] >= -DSKYPOLY_GALOIS_COEF_MAX && c[k] <= DSKYPOLY_GALOIS_COEF_MAX))
+            return 0;
+        a[k] = (int64_t)c[k];
+        if ((double)a[k] != c[k])
+            return 0;
+    }
+    return a[0] != 0;
+}
+
+// a mod small_primes[i], by multiplying with a 64-bit reciprocal
+// (Lemire's fastmod): exact for the 32-bit magnitudes integral() admits
+static void reduce_mod(const int64_t* a, int n, int i, uint32_t* hi) {
+    uint32_t p = small_primes[i];
+    uint64_t m = prime_magic[i];
+    for (int k = 0; k <= n; k++) {
+        uint32_t x = (uint32_t)abs64(a[k]);
+        uint32_t r = (uint32_t)(((u128)(m * x) * p) >> 64);
+        hi[k] = a[k] < 0 && r ? p - r : r;
+    }
+}
+
+// a / (v x - u) into q[0..n-1] when it divides exactly, every quotient
+// coefficient within COFACTOR_MAX
+static int divide_linear(const int64_t* a, int n, int64_t u, int64_t v, int64_t* q) {
+    __int128 carry = 0;
+    for (int k = 0; k < n; k++) {
+        __int128 t = a[k] + carry;
+        if (t % v != 0)
+            return 0;
+        t /= v;
+        if (t > COFACTOR_MAX || t < -COFACTOR_MAX)
+            return 0;
+        q[k] = (int64_t)t;
+        carry = (__int128)u * q[k];
+    }
+    return a[n] + carry == 0;
+}
+
+// === Z/p^k: Hensel lifting of a simple root ===
+
+// a*b mod m for a, b < m < 2^62: the long double quotient is off by one
+// at most, and the wrapped 64-bit difference puts that right
+static uint64_t mulmod(uint64_t a, uint64_t b, uint64_t m) {
+    uint64_t q = (uint64_t)((long double)a * b / m);
+    int64_t r = (int64_t)(a * b - q * m);
+    return r < 0 ? (uint64_t)r + m : (uint64_t)r >= m ? (uint64_t)r - m : (uint64_t)r;
+}
+
+// f and f' at r, coefficients am[] already reduced mod m
+static void eval_mod(const uint64_t* am, int n, uint64_t r, uint64_t m,
+                     uint64_t* f, uint64_t* df) {
+    uint64_t v = 0, d = 0;
+    for (int k = 0; k <= n; k++) {
+        d = mulmod(d, r, m) + v;
+        d = d >= m ? d - m : d;
+        v = mulmod(v, r, m) + am[k];
+        v = v >= m ? v - m : v;
+    }
+    *f = v;
+    *df = d;
+}
+
+// x, a simple root mod p of the polynomial am[] reduced mod m = p^k,
+// lifted to a root mod m. The root and 1/f' at it are refined together
+// (r -= f w, w *= 2 - f' w), doubling their p-adic digits every step
+// without a single division.
+static uint64_t hensel_lift(const uint64_t* am, int n, uint32_t x, uint32_t p, uint64_t m) {
+    uint64_t r = x, f, df;
+    eval_mod(am, n, r, m, &f, &df);
+    uint64_t w = fp_inv((uint32_t)(df % p), p);
+    for (uint64_t have = p; have < m; have = (u128)have * have >= m ? m : have * have) {
+        r = r + m - mulmod(f, w, m);
+        r = r >= m ? r - m : r;
+        eval_mod(am, n, r, m, &f, &df);
+        uint64_t t = 2 + m - mulmod(df, w, m);
+        w = mulmod(w, t >= m ? t - m : t, m);
+    }
+    return r;
+}
+
+// Rational roots of the integral a (constant term nonzero), split off a in
+// place: returns how many went to root[], a keeps the cofactor of degree
+// n minus that
+static int rational_roots(int64_t* a, int n, double* root) {
+    uint32_t hi[DSKYPOLY_MAX_DEGREE + 1];
+    uint8_t zero[GALOIS_LANES], best_zero[GALOIS_LANES];
+    int best = 0, best_rank = 2 * GALOIS_LANES, good = 0;
+
+    // Lift the roots of the prime with the fewest, all simple; a squarefree
+    // a has such primes. Otherwise only simple roots can be lifted, and a
+    // simple rational root only collides with another mod a few primes:
+    // take the prime with the most. A prime with no roots at all ends it.
+    uint32_t first_hi[3][DSKYPOLY_MAX_DEGREE + 1];
+    uint8_t first_zero[3][GALOIS_LANES];
+    int first_count[3];
+    for (int i = 0; i < 3; i++)
+        reduce_mod(a, n, i, first_hi[i]);
+    fp_roots_first3(first_hi, n, first_zero, first_count);
+
+    for (int i = 0; i < SMALL_PRIMES && (good < SPLIT_PRIMES || best_rank > n); i++) {
+        uint32_t p = small_primes[i];
+        int count;
+        if (i < 3) {
+            memcpy(hi, first_hi[i], sizeof(hi));
+            memcpy(zero, first_zero[i], p);
+            count = first_count[i];
+        } else {
+            reduce_mod(a, n, i, hi);
+            count = fp_roots(hi, n, p, zero);
+        }
+        if (hi[0] == 0)
+            continue;
+        good++;
+        if (count == 0)
+            return 0;
+        int simple = fp_simple(hi, n, p, zero);
+        int rank = simple == count ? count : GALOIS_LANES + 8 * (n - simple) + count;
+        if (simple && rank < best_rank) {
+            best = (int)p;
+            best_rank = rank;
+            memcpy(best_zero, zero, sizeof(zero));
+        }
+    }
+    if (!best)
+        return 0;
+
+    // |a0 * root| <= |a0| + max |ak| (Cauchy): lift past twice that
+    int64_t bound = 0;
+    for (int k = 1; k <= n; k++)
+        bound = abs64(a[k]) > bound ? abs64(a[k]) : bound;
+    bound += abs64(a[0]);
+    uint64_t m = best;
+    while (m <= 2 * (uint64_t)bound)
+        m *= best;
+
+    // Lift against the original, divide the cofactor
+    uint64_t am[DSKYPOLY_MAX_DEGREE + 1];
+    for (int k = 0; k <= n; k++) {
+        int64_t c = a[k] % (int64_t)m;
+        am[k] = (uint64_t)(c < 0 ? c + (int64_t)m : c);
+    }
+    int64_t a0 = a[0];
+    int d = n, found = 0;
+    for (uint32_t x = 0; x < (uint32_t)best && d > 0; x++) {
+        if (!best_zero[x])
+            continue;
+        uint64_t r = hensel_lift(am, n, x, best, m);
+        uint64_t ya = mulmod(r, (uint64_t)(a0 < 0 ? a0 + (int64_t)m : a0), m);
+        int64_t y = ya > m / 2 ? (int64_t)ya - (int64_t)m : (int64_t)ya;
+        if (y == 0)
+            continue;
+        int64_t g = gcd64(y, a0);
+        int64_t u = y / g, v = a0 / g;
+        if (v < 0) {
+            u = -u;
+            v = -v;
+        }
+        int64_t q[DSKYPOLY_MAX_DEGREE];
+        if (a[d] % u != 0 || !divide_linear(a, d, u, v, q))
+            continue;
+        memcpy(a, q, sizeof(*q) * d);
+        d--;
+        root[found++] = (double)u / (double)v;
+    }
+    return found;
+}
+
+// Zero roots for any coefficients, then the rational ones if it is
+// integral; c keeps the cofactor. Returns the count.
+static int split_roots(double* c, int degree, double* root) {
+    int k = 0;
+    while (k < degree && c[degree - k] == 0.0 && c[0] != 0.0)
+        root[k++] = 0.0;
+    int64_t a[DSKYPOLY_MAX_DEGREE + 1];
+    int d = degree - k;
+    if (d >= 2 && integral(c, d, a)) {
+        int r = rational_roots(a, d, root + k);
+        for (int j = 0; r && j <= d - r; j++)
+            c[j] = (double)a[j];
+        k += r;
+    }
+    return k;
+}
+
+int dskypoly_galois_split(const double* coeffs, int degree, double* root, double* cofactor) {
+    if (degree < 2 || degree > DSKYPOLY_MAX_DEGREE)
+        return 0;
+    double c[DSKYPOLY_MAX_DEGREE + 1];
+    memcpy(c, coeffs, sizeof(*c) * (degree + 1));
+    int k = split_roots(c, degree, root);
+    if (k)
+        memcpy(cofactor, c, sizeof(*c) * (degree - k + 1));
+    return k;
+}
+
+// Factor degrees of a squarefree f mod p (hi: degree n, monic or not):
+// cnt[d] factors of degree d
+static void factor_pattern(const uint32_t* hi, int n, uint32_t p, int roots, int* cnt) {
+    memset(cnt, 0, sizeof(int) * (DSKYPOLY_MAX_DEGREE + 1));
+    cnt[1] = roots;
+    int rest = n - roots;
+    if (rest < 4) {
+        if (rest)
+            cnt[rest] = 1;
+        return;
+    }
+    // 4 or 5 left: 2+2 or 4, 2+3 or 5, told apart by gcd(f, x^(p^2) - x)
+    uint32_t f[2 * DSKYPOLY_MAX_DEGREE] = { 0 }, g[2 * DSKYPOLY_MAX_DEGREE] = { 0 };
+    for (int k = 0; k <= n; k++)
+        f[k] = hi[n - k];
+    fp_monic(f, n, p);
+    fp_pow_x(g, p * p, f, n, p);
+    g[1] = (g[1] + p - 1) % p;
+    int quadratics = (fp_gcd_degree(f, n, g, n - 1, p) - roots) / 2;
+    cnt[2] = quadratics;
+    if (rest - 2 * quadratics)
+        cnt[rest - 2 * quadratics] = 1;
+}
+
+int dskypoly_galois_classify(const double* coeffs, int degree, dskypoly_galois* g) {
+    memset(g, 0, sizeof(*g));
+    if (degree < 2 || degree > DSKYPOLY_MAX_DEGREE || coeffs[0] == 0.0)
+        return g->verdict = DSKYPOLY_GALOIS_UNKNOWN;
+
+    double c[DSKYPOLY_MAX_DEGREE + 1];
+    memcpy(c, coeffs, sizeof(*c) * (degree + 1));
+    g->rational = split_roots(c, degree, g->root);
+    memcpy(g->cofactor, c, sizeof(*c) * (degree - g->rational + 1));
+    g->factor_degrees = (2u << degree) - 1;
+
+    int64_t a[DSKYPOLY_MAX_DEGREE + 1];
+    int beyond_f20 = 0;             // a 3-cycle or a transposition: not in F20
+    if (integral(coeffs, degree, a) && a[degree] != 0) {
+        unsigned degrees = (2u << degree) - 1;
+        for (int i = 0; i < SMALL_PRIMES && g->primes < GALOIS_PRIMES; i++) {
+            uint32_t p = small_primes[i];
+            uint32_t hi[DSKYPOLY_MAX_DEGREE + 1] = { 0 };
+            uint32_t f[2 * DSKYPOLY_MAX_DEGREE], df[2 * DSKYPOLY_MAX_DEGREE];
+            reduce_mod(a, degree, i, hi);
+            if (hi[0] == 0)
+                continue;
+            for (int k = 0; k <= degree; k++)
+                f[k] = hi[degree - k];
+            for (int k = 1; k <= degree; k++)
+                df[k - 1] = (uint32_t)k % p * f[k] % p;
+            if (fp_gcd_degree(f, degree, df, degree - 1, p) != 0)
+                continue;               // p divides the discriminant
+
+            uint8_t zero[GALOIS_LANES];
+            int cnt[DSKYPOLY_MAX_DEGREE + 1];
+            factor_pattern(hi, degree, p, fp_roots(hi, degree, p, zero), cnt);
+            unsigned sums = 1;
+            for (int d = 1; d <= degree; d++)
+                for (int j = 0; j < cnt[d]; j++)
+                    sums |= sums << d;
+            degrees &= sums;
+            beyond_f20 |= cnt[3] > 0 || (cnt[1] == 3 && cnt[2] == 1);
+            g->primes++;
+        }
+        if (g->primes)
+            g->factor_degrees = degrees;
+    }
+
+    unsigned whole = 1u | 1u << degree;
+    if (g->rational)
+        g->verdict = DSKYPOLY_GALOIS_REDUCIBLE;
+    else if (!g->primes || g->factor_degrees != whole)
+        g->verdict = DSKYPOLY_GALOIS_UNKNOWN;
+    else if (degree < 5)
+        g->verdict = DSKYPOLY_GALOIS_SOLVABLE;     // every subgroup of S4 is
+    else
+        g->verdict = beyond_f20 ? DSKYPOLY_GALOIS_NONSOLVABLE : DSKYPOLY_GALOIS_IRREDUCIBLE;
+    return g->verdict;
+}
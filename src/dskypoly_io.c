@@ -0,0 +1,657 @@
+// === dskypoly_io.c for DSKYpoly ===
+// Binary coefficient and root files, solved straight out of mmap.
+//
+// Both file kinds are a 64-byte header followed by planes of doubles, one
+// plane per coefficient (or per root component), each plane starting on a
+// 64-byte boundary. That is exactly the structure-of-arrays layout of the
+// batched kernels, so degrees 2 and 3 run the SIMD kernels directly on the
+// mapped pages and the output is written into a mapped file in place; no
+// text is parsed and nothing is copied. Degrees 4 and 5 go through the
+// bulk driver block by block.
+
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include <x86intrin.h>
+
+#include "dskypoly.h"
+
+#define SOLVE_BLOCK (1 << 16)   // polynomials per bulk-driver call, degrees 4-5
+
+static const char coef_magic[8] = DSKYPOLY_COEF_MAGIC;
+static const char root_magic[8] = DSKYPOLY_ROOT_MAGIC;
+
+static size_t file_bytes(const dskypoly_file_header* h) {
+    return sizeof(*h) + h->planes * h->stride * sizeof(double);
+}
+
+static void fill_header(dskypoly_file_header* h, const char magic[8],
+                        int degree, size_t count, size_t planes) {
+    memset(h, 0, sizeof(*h));
+    memcpy(h->magic, magic, sizeof(h->magic));
+    h->version = DSKYPOLY_FILE_VERSION;
+    h->degree = degree;
+    h->count = count;
+    h->stride = dskypoly_file_stride(count);
+    h->planes = planes;
+}
+
+// A coefficient file header that matches its own geometry and fits in size bytes
+static int coeffs_header_ok(const dskypoly_file_header* h, size_t size) {
+    return memcmp(h->magic, coef_magic, sizeof(h->magic)) == 0
+        && h->version == DSKYPOLY_FILE_VERSION
+        && h->degree >= 2 && h->degree <= DSKYPOLY_MAX_DEGREE
+        && h->planes == h->degree + 1
+        && dskypoly_file_fits(h, size);
+}
+
+// Roots k..degree-1 of polynomial i are ones it does not have (all of
+// them for a zero leading coefficient): NaN in both of their planes. r
+// holds 2*degree planes of ps doubles.
+static void missing_roots(double* r, size_t ps, int degree, size_t i, int k) {
+    for (k = k > 0 ? k : 0; k < degree; k++)
+        r[k * ps + i] = r[(degree + k) * ps + i] = NAN;
+}
+
+// The batch kernels solve every lane; a lane with a == 0 has no roots
+static void missing_leading(const double* a, double* r, size_t ps, int degree, size_t n) {
+    for (size_t i = 0; i < n; i++)
+        if (a[i] == 0.0)
+            missing_roots(r, ps, degree, i, 0);
+}
+
+// Create path at its final size and map it writable; zero-filled by ftruncate
+static void* create_mapped(const char* path, size_t bytes) {
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        return NULL;
+    void* map = MAP_FAILED;
+    if (ftruncate(fd, (off_t)bytes) == 0)
+        map = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    int saved = errno;
+    close(fd);
+    errno = saved;
+    return map == MAP_FAILED ? NULL : map;
+}
+
+int dskypoly_file_write_coeffs(const char* path, int degree, size_t count,
+                               const double* coeffs) {
+    if (degree < 2 || degree > DSKYPOLY_MAX_DEGREE) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    dskypoly_file_header h;
+    fill_header(&h, coef_magic, degree, count, degree + 1);
+    size_t bytes = file_bytes(&h);
+    char* map = create_mapped(path, bytes);
+    if (!map)
+        return -1;
+
+    memcpy(map, &h, sizeof(h));
+    double* planes = (double*)(map + sizeof(h));
+    for (size_t i = 0; i < count; i++)
+        for (int k = 0; k <= degree; k++)
+            planes[k * h.stride + i] = coeffs[i * (degree + 1) + k];
+
+    return munmap(map, bytes);
+}
+
+// Degrees 4-5: gather a block of planes into the bulk driver's records,
+// solve on every core, scatter the roots back into the output planes
+static int solve_blocks(const double* in, double* out, int degree,
+                        size_t count, size_t stride) {
+    dskypoly_poly* polys = malloc(sizeof(*polys) * SOLVE_BLOCK);
+    double* re = malloc(sizeof(double) * SOLVE_BLOCK * DSKYPOLY_MAX_DEGREE);
+    double* im = malloc(sizeof(double) * SOLVE_BLOCK * DSKYPOLY_MAX_DEGREE);
+    int* nroots = malloc(sizeof(int) * SOLVE_BLOCK);
+    if (!polys || !re || !im || !nroots) {
+        free(polys);
+        free(re);
+        free(im);
+        free(nroots);
+        errno = ENOMEM;
+        return -1;
+    }
+
+    for (size_t base = 0; base < count; base += SOLVE_BLOCK) {
+        size_t n = count - base < SOLVE_BLOCK ? count - base : SOLVE_BLOCK;
+        for (size_t i = 0; i < n; i++) {
+            polys[i].degree = degree;
+            for (int k = 0; k <= degree; k++)
+                polys[i].coeffs[k] = in[k * stride + base + i];
+        }
+        dskypoly_solve(polys, n, re, im, nroots, 0);
+        for (int k = 0; k < degree; k++) {
+            double* re_plane = out + k * stride + base;
+            double* im_plane = out + (degree + k) * stride + base;
+            for (size_t i = 0; i < n; i++) {
+                re_plane[i] = re[i * DSKYPOLY_MAX_DEGREE + k];
+                im_plane[i] = im[i * DSKYPOLY_MAX_DEGREE + k];
+            }
+        }
+        // The scratch still holds the last block's roots past nroots[i]
+        for (size_t i = 0; i < n; i++)
+            if (nroots[i] < degree)
+                missing_roots(out + base, stride, degree, i, nroots[i]);
+    }
+
+    free(polys);
+    free(re);
+    free(im);
+    free(nroots);
+    return 0;
+}
+
+int dskypoly_file_solve(const char* in_path, const char* out_path) {
+    int fd = open(in_path, O_RDONLY);
+    if (fd < 0)
+        return -1;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return -1;
+    }
+    if ((size_t)st.st_size < sizeof(dskypoly_file_header)) {
+        close(fd);
+        errno = EINVAL;
+        return -1;
+    }
+    char* in = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (in == MAP_FAILED)
+        return -1;
+    madvise(in, st.st_size, MADV_SEQUENTIAL);
+
+    // === Validate before touching any plane ===
+    dskypoly_file_header h;
+    memcpy(&h, in, sizeof(h));
+    if (!coeffs_header_ok(&h, st.st_size)) {
+        munmap(in, st.st_size);
+        errno = EINVAL;
+        return -1;
+    }
+
+    int degree = h.degree;
+    size_t count = h.count, stride = h.stride;
+    const double* c = (const double*)(in + sizeof(h));
+
+    dskypoly_file_header oh;
+    fill_header(&oh, root_magic, degree, count, 2 * degree);
+    size_t out_bytes = file_bytes(&oh);
+    char* out = create_mapped(out_path, out_bytes);
+    if (!out) {
+        int saved = errno;
+        munmap(in, st.st_size);
+        errno = saved;
+        return -1;
+    }
+    memcpy(out, &oh, sizeof(oh));
+    double* r = (double*)(out + sizeof(oh));
+
+    // === Roots: re planes 0..degree-1, then im planes ===
+    int rc = 0;
+    uint64_t t0 = __rdtsc();
+    switch (degree) {
+    case 2:
+        solve_poly_2_batch(c, c + stride, c + 2 * stride, count,
+                           r, r + 2 * stride, r + stride, r + 3 * stride);
+        missing_leading(c, r, stride, 2, count);
+        break;
+    case 3:
+        // The cubic kernels address root k at k*n + i, so they run over the
+        // whole stride; the padding lanes are cleared again afterwards.
+        solve_poly_3_batch(c, c + stride, c + 2 * stride, c + 3 * stride,
+                           stride, r, r + 3 * stride);
+        for (int p = 0; p < 6; p++)
+            memset(r + p * stride + count, 0, (stride - count) * sizeof(double));
+        missing_leading(c, r, stride, 3, count);
+        break;
+    default:
+        rc = solve_blocks(c, r, degree, count, stride);
+        break;
+    }
+    // dskypoly_solve records degrees 4-5 one solve at a time
+    if (degree <= 3)
+        dskypoly_stats_record_batch(degree, count, __rdtsc() - t0);
+
+    int saved = errno;
+    munmap(in, st.st_size);
+    if (munmap(out, out_bytes) != 0 && rc == 0)
+        return -1;
+    errno = saved;
+    return rc;
+}
+
+// === Streaming solve: reader thread, solver workers, writer ===
+// For files far larger than memory: the reader preads one chunk of every
+// coefficient plane into a slab, the workers solve whole slabs, and the
+// calling thread writes them out in chunk order, each stage on its own
+// thread so the disk and the cores stay busy together. Slabs are allocated
+// once, 64-byte aligned, and cycle free -> ready -> done -> free through
+// three bounded lock-free queues (the Vyukov ring of the event log); there
+// are workers + 3 of them, so one can be filling and one draining while
+// every worker holds one.
+
+#define STREAM_CHUNK (1 << 14)                      // polynomials per slab
+#define STREAM_LINE_MAX (DSKYPOLY_MAX_DEGREE * 56)  // one line of text roots at most
+
+typedef struct {
+    size_t index;               // chunk number
+    size_t base, n;             // first polynomial of the chunk, polynomials in it
+    double* coef;               // degree+1 planes of STREAM_CHUNK
+    double* roots;              // 2*degree planes of n: re planes, then im planes
+    dskypoly_poly* polys;       // bulk driver records, degrees 4-5
+    double* re;                 // bulk driver roots, degrees 4-5
+    double* im;
+    int* nroots;                // bulk driver root counts, degrees 4-5
+    char* text;                 // formatted lines (text output only)
+    size_t text_len;
+} stream_slab;
+
+typedef struct {
+    _Alignas(64) _Atomic size_t seq;    // == ticket: free, == ticket+1: filled
+    stream_slab* slab;
+} stream_cell;
+
+typedef struct {
+    stream_cell* cells;
+    size_t mask;
+    _Alignas(64) _Atomic size_t head;   // next push ticket
+    _Alignas(64) _Atomic size_t tail;   // next pop ticket
+} stream_queue;
+
+typedef struct {
+    int in_fd, out_fd;
+    int degree, text;
+    size_t count, stride;
+    size_t chunks;              // slabs' worth of polynomials in the file
+    int workers;
+    stream_queue free_q, ready_q, done_q;
+    _Atomic int failed;         // first errno seen by any stage, 0 while healthy
+} stream_job;
+
+// Never pushed with data: tells a worker the reader is done
+static stream_slab stream_end;
+
+static int queue_init(stream_queue* q, size_t capacity) {
+    size_t slots = 1;
+    while (slots < capacity)
+        slots *= 2;
+    q->cells = aligned_alloc(64, slots * sizeof(*q->cells));
+    if (!q->cells)
+        return -1;
+    for (size_t i = 0; i < slots; i++)
+        atomic_init(&q->cells[i].seq, i);
+    q->mask = slots - 1;
+    atomic_init(&q->head, 0);
+    atomic_init(&q->tail, 0);
+    return 0;
+}
+
+// Queues are sized for every slab and sentinel at once: a push cannot fail
+static void queue_push(stream_queue* q, stream_slab* slab) {
+    size_t pos = atomic_fetch_add_explicit(&q->head, 1, memory_order_relaxed);
+    stream_cell* cell = &q->cells[pos & q->mask];
+    while (atomic_load_explicit(&cell->seq, memory_order_acquire) != pos)
+        _mm_pause();
+    cell->slab = slab;
+    atomic_store_explicit(&cell->seq, pos + 1, memory_order_release);
+}
+
+// NULL when the queue is empty
+static stream_slab* queue_pop(stream_queue* q) {
+    size_t pos = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    for (;;) {
+        stream_cell* cell = &q->cells[pos & q->mask];
+        size_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+        intptr_t dif = (intptr_t)seq - (intptr_t)(pos + 1);
+        if (dif == 0) {
+            if (atomic_compare_exchange_weak_explicit(&q->tail, &pos, pos + 1,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                stream_slab* slab = cell->slab;
+                atomic_store_explicit(&cell->seq, pos + q->mask + 1, memory_order_release);
+                return slab;
+            }
+        } else if (dif < 0) {
+            return NULL;
+        } else {
+            pos = atomic_load_explicit(&q->tail, memory_order_relaxed);
+        }
+    }
+}
+
+static void stream_fail(stream_job* job, int err) {
+    int none = 0;
+    atomic_compare_exchange_strong(&job->failed, &none, err ? err : EIO);
+}
+
+// Next slab, spinning briefly and then sleeping: a stage waits on the
+// disk or on the solvers for milliseconds at a time. NULL once any stage
+// has failed.
+static stream_slab* queue_wait(stream_job* job, stream_queue* q) {
+    for (unsigned spins = 0;; spins++) {
+        stream_slab* slab = queue_pop(q);
+        if (slab)
+            return slab;
+        if (atomic_load_explicit(&job->failed, memory_order_relaxed))
+            return NULL;
+        if (spins < 256) {
+            _mm_pause();
+        } else {
+            struct timespec pause = { 0, 50 * 1000 };
+            nanosleep(&pause, NULL);
+        }
+    }
+}
+
+// pread/pwrite until done; off < 0 writes at the descriptor's position
+static int read_full(int fd, void* buf, size_t len, off_t off) {
+    char* p = buf;
+    while (len) {
+        ssize_t got = pread(fd, p, len, off);
+        if (got < 0 && errno == EINTR)
+            continue;
+        if (got <= 0) {
+            if (got == 0)
+                errno = EINVAL;         // file shorter than its header says
+            return -1;
+        }
+        p += got;
+        off += got;
+        len -= got;
+    }
+    return 0;
+}
+
+static int write_full(int fd, const void* buf, size_t len, off_t off) {
+    const char* p = buf;
+    while (len) {
+        ssize_t put = off < 0 ? write(fd, p, len) : pwrite(fd, p, len, off);
+        if (put < 0 && errno == EINTR)
+            continue;
+        if (put <= 0)
+            return -1;
+        p += put;
+        if (off >= 0)
+            off += put;
+        len -= put;
+    }
+    return 0;
+}
+
+static off_t plane_offset(const stream_job* job, int plane, size_t base) {
+    return (off_t)(sizeof(dskypoly_file_header)
+                   + ((size_t)plane * job->stride + base) * sizeof(double));
+}
+
+static void* reader_main(void* arg) {
+    stream_job* job = arg;
+    for (size_t index = 0; index < job->chunks; index++) {
+        stream_slab* slab = queue_wait(job, &job->free_q);
+        if (!slab)
+            break;
+        slab->index = index;
+        slab->base = index * STREAM_CHUNK;
+        slab->n = job->count - slab->base < STREAM_CHUNK ? job->count - slab->base
+                                                         : STREAM_CHUNK;
+        for (int k = 0; k <= job->degree; k++)
+            if (read_full(job->in_fd, slab->coef + (size_t)k * STREAM_CHUNK,
+                          slab->n * sizeof(double), plane_offset(job, k, slab->base)) != 0) {
+                stream_fail(job, errno);
+                break;
+            }
+        queue_push(&job->ready_q, slab);
+    }
+    for (int w = 0; w < job->workers; w++)
+        queue_push(&job->ready_q, &stream_end);
+    return NULL;
+}
+
+// One slab: the batched kernels straight on its planes for degrees 2-3,
+// the bulk driver on this thread for 4-5; then the text lines if wanted
+static void solve_slab(const stream_job* job, stream_slab* slab) {
+    int degree = job->degree;
+    size_t n = slab->n;
+    const double* c = slab->coef;
+    double* r = slab->roots;
+
+    uint64_t t0 = __rdtsc();
+    if (degree == 2) {
+        solve_poly_2_batch(c, c + STREAM_CHUNK, c + 2 * STREAM_CHUNK, n,
+                           r, r + 2 * n, r + n, r + 3 * n);
+        missing_leading(c, r, n, 2, n);
+    } else if (degree == 3) {
+        solve_poly_3_batch(c, c + STREAM_CHUNK, c + 2 * STREAM_CHUNK, c + 3 * STREAM_CHUNK,
+                           n, r, r + 3 * n);
+        missing_leading(c, r, n, 3, n);
+    } else {
+        for (size_t i = 0; i < n; i++) {
+            slab->polys[i].degree = degree;
+            for (int k = 0; k <= degree; k++)
+                slab->polys[i].coeffs[k] = c[k * STREAM_CHUNK + i];
+        }
+        dskypoly_solve(slab->polys, n, slab->re, slab->im, slab->nroots, 1);
+        for (int k = 0; k < degree; k++)
+            for (size_t i = 0; i < n; i++) {
+                r[k * n + i] = slab->re[i * DSKYPOLY_MAX_DEGREE + k];
+                r[(degree + k) * n + i] = slab->im[i * DSKYPOLY_MAX_DEGREE + k];
+            }
+        // The slab's re/im still hold an earlier chunk's roots past nroots[i]
+        for (size_t i = 0; i < n; i++)
+            if (slab->nroots[i] < degree)
+                missing_roots(r, n, degree, i, slab->nroots[i]);
+    }
+    if (degree <= 3)
+        dskypoly_stats_record_batch(degree, n, __rdtsc() - t0);
+
+    if (!job->text)
+        return;
+    // The --degree output: one line of `re im` pairs per polynomial
+    char* out = slab->text;
+    for (size_t i = 0; i < n; i++) {
+        for (int k = 0; k < degree; k++)
+            out += snprintf(out, STREAM_LINE_MAX, "%s%.17g %+.17gi", k ? "  " : "",
+                            r[k * n + i], r[(degree + k) * n + i]);
+        *out++ = '\n';
+    }
+    slab->text_len = out - slab->text;
+}
+
+static void* worker_main(void* arg) {
+    stream_job* job = arg;
+    stream_slab* slab;
+    while ((slab = queue_wait(job, &job->ready_q)) && slab != &stream_end) {
+        solve_slab(job, slab);
+        queue_push(&job->done_q, slab);
+    }
+    return NULL;
+}
+
+static int write_slab(stream_job* job, const stream_slab* slab) {
+    if (job->text)
+        return write_full(job->out_fd, slab->text, slab->text_len, -1);
+    for (int p = 0; p < 2 * job->degree; p++)
+        if (write_full(job->out_fd, slab->roots + p * slab->n, slab->n * sizeof(double),
+                       plane_offset(job, p, slab->base)) != 0)
+            return -1;
+    return 0;
+}
+
+// The calling thread's stage: slabs come back in any order and leave in
+// chunk order, so text lines and file writes stay sequential. At most
+// nslabs are in flight, so (index % nslabs) never collides.
+static void writer_run(stream_job* job, stream_slab** held, size_t nslabs) {
+    size_t next = 0;
+    while (next < job->chunks) {
+        stream_slab* slab = queue_wait(job, &job->done_q);
+        if (!slab)
+            return;
+        held[slab->index % nslabs] = slab;
+        while (next < job->chunks && (slab = held[next % nslabs]) && slab->index == next) {
+            held[next % nslabs] = NULL;
+            if (write_slab(job, slab) != 0) {
+                stream_fail(job, errno);
+                return;
+            }
+            queue_push(&job->free_q, slab);
+            next++;
+        }
+    }
+}
+
+static size_t slab_bytes(int degree, int text) {
+    size_t bytes = (size_t)(3 * degree + 1) * STREAM_CHUNK * sizeof(double);
+    if (degree >= 4)
+        bytes += STREAM_CHUNK * (sizeof(dskypoly_poly) + 2 * DSKYPOLY_MAX_DEGREE * sizeof(double)
+                                 + sizeof(int));
+    if (text)
+        bytes += STREAM_CHUNK * STREAM_LINE_MAX;
+    return (bytes + 63) & ~(size_t)63;
+}
+
+static void slab_carve(stream_slab* slab, char* mem, int degree, int text) {
+    memset(slab, 0, sizeof(*slab));
+    slab->coef = (double*)mem;
+    slab->roots = slab->coef + (size_t)(degree + 1) * STREAM_CHUNK;
+    char* p = (char*)(slab->roots + (size_t)2 * degree * STREAM_CHUNK);
+    if (degree >= 4) {
+        slab->polys = (dskypoly_poly*)p;
+        slab->re = (double*)(p + STREAM_CHUNK * sizeof(dskypoly_poly));
+        slab->im = slab->re + STREAM_CHUNK * DSKYPOLY_MAX_DEGREE;
+        slab->nroots = (int*)(slab->im + STREAM_CHUNK * DSKYPOLY_MAX_DEGREE);
+        p = (char*)(slab->nroots + STREAM_CHUNK);
+    }
+    if (text)
+        slab->text = p;
+}
+
+static int stream_workers(int threads) {
+    if (threads <= 0) {
+        const char* env = getenv("DSKYPOLY_THREADS");
+        threads = env ? atoi(env) : 0;
+    }
+    if (threads <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 0 ? (int)cpus : 1;
+    }
+    return threads;
+}
+
+// Root file of the input's shape, created sparse at full size with its header
+static int create_roots(const char* path, const stream_job* job) {
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        return -1;
+    dskypoly_file_header oh;
+    fill_header(&oh, root_magic, job->degree, job->count, 2 * job->degree);
+    if (ftruncate(fd, (off_t)file_bytes(&oh)) != 0 || write_full(fd, &oh, sizeof(oh), 0) != 0) {
+        int saved = errno;
+        close(fd);
+        errno = saved;
+        return -1;
+    }
+    return fd;
+}
+
+int dskypoly_file_stream(const char* in_path, const char* out_path, int text, int threads) {
+    stream_job job = { .in_fd = -1, .out_fd = -1, .text = text };
+    dskypoly_file_header h;
+    struct stat st;
+    int to_stdout = strcmp(out_path, "-") == 0;
+    if (to_stdout && !text) {
+        errno = EINVAL;                 // a root file is written plane by plane
+        return -1;
+    }
+    if ((job.in_fd = open(in_path, O_RDONLY)) < 0)
+        return -1;
+    if (fstat(job.in_fd, &st) != 0 || read_full(job.in_fd, &h, sizeof(h), 0) != 0) {
+        int saved = errno;
+        close(job.in_fd);
+        errno = saved;
+        return -1;
+    }
+    if (!coeffs_header_ok(&h, st.st_size)) {
+        close(job.in_fd);
+        errno = EINVAL;
+        return -1;
+    }
+    posix_fadvise(job.in_fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    job.degree = h.degree;
+    job.count = h.count;
+    job.stride = h.stride;
+    job.chunks = (h.count + STREAM_CHUNK - 1) / STREAM_CHUNK;
+    job.workers = stream_workers(threads);
+    if ((size_t)job.workers > job.chunks)
+        job.workers = job.chunks ? (int)job.chunks : 1;
+    atomic_init(&job.failed, 0);
+
+    job.out_fd = to_stdout ? STDOUT_FILENO
+               : text ? open(out_path, O_WRONLY | O_CREAT | O_TRUNC, 0644)
+                      : create_roots(out_path, &job);
+    int err = job.out_fd < 0 ? errno : ENOMEM;
+
+    size_t nslabs = (size_t)job.workers + 3;
+    size_t bytes = slab_bytes(job.degree, text);
+    stream_slab* slabs = calloc(nslabs, sizeof(*slabs));
+    stream_slab** held = calloc(nslabs, sizeof(*held));
+    char* mem = job.out_fd < 0 ? NULL : aligned_alloc(64, nslabs * bytes);
+    pthread_t* tids = calloc(job.workers + 1, sizeof(*tids));
+    int rc = -1;
+    if (mem && slabs && held && tids
+        && queue_init(&job.free_q, nslabs) == 0
+        && queue_init(&job.ready_q, nslabs + job.workers) == 0
+        && queue_init(&job.done_q, nslabs) == 0) {
+        for (size_t s = 0; s < nslabs; s++) {
+            slab_carve(&slabs[s], mem + s * bytes, job.degree, text);
+            queue_push(&job.free_q, &slabs[s]);
+        }
+
+        // tids[0] is the reader; a worker that fails to start is one fewer
+        // sentinel consumer, so the count is fixed before the reader runs
+        int started = 0;
+        for (int w = 0; w < job.workers; w++)
+            if (pthread_create(&tids[1 + started], NULL, worker_main, &job) == 0)
+                started++;
+        job.workers = started;
+        if (started && pthread_create(&tids[0], NULL, reader_main, &job) == 0) {
+            writer_run(&job, held, nslabs);
+            pthread_join(tids[0], NULL);
+        } else {
+            stream_fail(&job, EAGAIN);
+            for (int w = 0; w < started; w++)
+                queue_push(&job.ready_q, &stream_end);
+        }
+        for (int w = 0; w < started; w++)
+            pthread_join(tids[1 + w], NULL);
+        err = atomic_load(&job.failed);
+        rc = err ? -1 : 0;
+    }
+
+    if (job.out_fd >= 0 && !to_stdout && close(job.out_fd) != 0 && rc == 0) {
+        err = errno;
+        rc = -1;
+    }
+    close(job.in_fd);
+    free(job.free_q.cells);
+    free(job.ready_q.cells);
+    free(job.done_q.cells);
+    free(tids);
+    free(mem);
+    free(held);
+    free(slabs);
+    errno = err;
+    return rc;
+}
@@ -0,0 +1,166 @@
+// === dskypoly_log.c for DSKYpoly ===
+// Event log behind a preallocated lock-free ring.
+//
+// Callers copy their message into the next free slot and return; they never
+// open a file, format a timestamp or take a lock. A background thread wakes
+// every LOG_DRAIN_NS, stamps everything that has arrived with one wall-clock
+// time, and appends the whole batch to the log file in a single buffered
+// write. When the level filters a message out, dskypoly_log() costs one
+// relaxed load and a compare.
+//
+// The ring is a bounded multi-producer queue (Vyukov): each slot carries a
+// sequence number that says whether it is free for the ticket a producer
+// holds, or filled and ready for the drainer. A full ring drops the message
+// and counts it, so the hot path never waits on the disk.
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+
+#include "dskypoly.h"
+
+#define LOG_SLOTS    1024               // power of two
+#define LOG_MSG_MAX  120
+#define LOG_DRAIN_NS (20 * 1000 * 1000) // 20 ms between drains
+
+typedef struct {
+    _Atomic size_t seq;                 // == ticket: free, == ticket+1: filled
+    char msg[LOG_MSG_MAX];
+} log_slot;
+
+static log_slot ring[LOG_SLOTS];
+static _Atomic size_t ring_head;        // next producer ticket
+static size_t ring_tail;                // next slot to drain (drainer only)
+static _Atomic unsigned long dropped;
+
+static _Atomic int log_level = DSKYPOLY_LOG_OFF;   // nothing is queued until opened
+static _Atomic int running;
+static FILE* log_file;
+static pthread_t drainer;
+
+int dskypoly_log_enabled(int level) {
+    return level <= atomic_load_explicit(&log_level, memory_order_relaxed);
+}
+
+void dskypoly_log_set_level(int level) {
+    atomic_store_explicit(&log_level, level, memory_order_relaxed);
+}
+
+void dskypoly_log(int level, const char* msg) {
+    if (!dskypoly_log_enabled(level))
+        return;
+
+    size_t pos = atomic_load_explicit(&ring_head, memory_order_relaxed);
+    log_slot* slot;
+    for (;;) {
+        slot = &ring[pos & (LOG_SLOTS - 1)];
+        size_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        intptr_t dif = (intptr_t)seq - (intptr_t)pos;
+        if (dif == 0) {
+            if (atomic_compare_exchange_weak_explicit(&ring_head, &pos, pos + 1,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed))
+                break;
+        } else if (dif < 0) {
+            atomic_fetch_add_explicit(&dropped, 1, memory_order_relaxed);
+            return;                     // ring full: the drainer is behind
+        } else {
+            pos = atomic_load_explicit(&ring_head, memory_order_relaxed);
+        }
+    }
+
+    strncpy(slot->msg, msg, LOG_MSG_MAX - 1);
+    slot->msg[LOG_MSG_MAX - 1] = '\0';
+    atomic_store_explicit(&slot->seq, pos + 1, memory_order_release);
+}
+
+// Write out everything filled so far under one timestamp
+static void drain_batch(void) {
+    log_slot* slot = &ring[ring_tail & (LOG_SLOTS - 1)];
+    unsigned long lost = atomic_exchange_explicit(&dropped, 0, memory_order_relaxed);
+    if (atomic_load_explicit(&slot->seq, memory_order_acquire) != ring_tail + 1 && !lost)
+        return;
+
+    char stamp[32];
+    time_t now = time(NULL);
+    struct tm t;
+    localtime_r(&now, &t);
+    strftime(stamp, sizeof(stamp), "[%Y-%m-%d %H:%M:%S]", &t);
+
+    for (;;) {
+        slot = &ring[ring_tail & (LOG_SLOTS - 1)];
+        if (atomic_load_explicit(&slot->seq, memory_order_acquire) != ring_tail + 1)
+            break;
+        fprintf(log_file, "%s %s\n", stamp, slot->msg);
+        atomic_store_explicit(&slot->seq, ring_tail + LOG_SLOTS, memory_order_release);
+        ring_tail++;
+    }
+    if (lost)
+        fprintf(log_file, "%s %lu log messages dropped (ring full)\n", stamp, lost);
+    fflush(log_file);
+}
+
+static void* drain_main(void* arg) {
+    (void)arg;
+    struct timespec pause = { 0, LOG_DRAIN_NS };
+    while (atomic_load_explicit(&running, memory_order_acquire)) {
+        drain_batch();
+        nanosleep(&pause, NULL);
+    }
+    drain_batch();                      // whatever arrived before close
+    return NULL;
+}
+
+// DSKYPOLY_LOG_LEVEL=off|info|debug (or 0..2) overrides the caller's level
+static int env_level(int level) {
+    const char* env = getenv("DSKYPOLY_LOG_LEVEL");
+    if (!env)
+        return level;
+    if (!strcasecmp(env, "off"))
+        return DSKYPOLY_LOG_OFF;
+    if (!strcasecmp(env, "info"))
+        return DSKYPOLY_LOG_INFO;
+    if (!strcasecmp(env, "debug"))
+        return DSKYPOLY_LOG_DEBUG;
+    return atoi(env);
+}
+
+int dskypoly_log_open(const char* path, int level) {
+    level = env_level(level);
+    if (level <= DSKYPOLY_LOG_OFF || atomic_load(&running))
+        return 0;
+
+    log_file = fopen(path, "a");
+    if (!log_file)
+        return -1;
+
+    for (size_t i = 0; i < LOG_SLOTS; i++)
+        atomic_init(&ring[i].seq, i);
+    atomic_store(&ring_head, 0);
+    ring_tail = 0;
+
+    atomic_store(&running, 1);
+    if (pthread_create(&drainer, NULL, drain_main, NULL) != 0) {
+        atomic_store(&running, 0);
+        fclose(log_file);
+        log_file = NULL;
+        return -1;
+    }
+    dskypoly_log_set_level(level);
+    atexit(dskypoly_log_close);
+    return 0;
+}
+
+void dskypoly_log_close(void) {
+    if (!atomic_exchange(&running, 0))
+        return;
+    dskypoly_log_set_level(DSKYPOLY_LOG_OFF);
+    pthread_join(drainer, NULL);
+    fclose(log_file);
+    log_file = NULL;
+}
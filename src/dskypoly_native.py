@@ -0,0 +1,223 @@
+#!/usr/bin/env python3
+# === dskypoly_native.py for DSKYpoly ===
+# ctypes binding to build/libdskypoly.so (make lib). NumPy coefficient
+# arrays are read in place through their strides and roots land directly
+# in a preallocated complex128 array: nothing is copied on either side.
+#
+#   import numpy as np, dskypoly_native as dp
+#   c = np.random.randn(100000, 4)         # 100000 cubics, x^3 coefficient first
+#   z = dp.roots(c)                        # complex128, shape (100000, 3)
+#   dp.roots(c, out=z)                     # reuse the output buffer
+#
+# ctypes drops the GIL for the duration of the call, so Python threads
+# solving separate batches run in parallel.
+
+import ctypes
+import os
+import sys
+
+MAX_DEGREE = 64   # DSKYPOLY_STRIDED_MAX_DEGREE
+QR_MAX_DEGREE = 16   # DSKYPOLY_COMPANION_MAX_DEGREE
+
+
+def _load():
+    path = os.environ.get("DSKYPOLY_LIB")
+    if not path:
+        here = os.path.dirname(os.path.abspath(__file__))
+        path = os.path.join(here, "..", "build", "libdskypoly.so")
+    lib = ctypes.CDLL(path, use_errno=True)
+    lib.dskypoly_roots_strided.restype = ctypes.c_int
+    lib.dskypoly_roots_strided.argtypes = [
+        ctypes.c_void_p, ctypes.c_int, ctypes.c_size_t,
+        ctypes.c_ssize_t, ctypes.c_ssize_t,
+        ctypes.c_void_p, ctypes.c_void_p,
+    ]
+    lib.dskypoly_tracker_create.restype = ctypes.c_void_p
+    lib.dskypoly_tracker_create.argtypes = [ctypes.c_double, ctypes.c_double]
+    lib.dskypoly_tracker_destroy.argtypes = [ctypes.c_void_p]
+    lib.dskypoly_tracker_forget.argtypes = [ctypes.c_void_p, ctypes.c_uint64]
+    lib.dskypoly_tracker_update.restype = ctypes.c_int
+    lib.dskypoly_tracker_update.argtypes = [
+        ctypes.c_void_p, ctypes.c_uint64, ctypes.c_void_p, ctypes.c_int,
+        ctypes.c_void_p, ctypes.c_void_p, ctypes.POINTER(ctypes.c_int),
+    ]
+    lib.solve_poly_n_companion_batch.restype = ctypes.c_int
+    lib.solve_poly_n_companion_batch.argtypes = [
+        ctypes.c_void_p, ctypes.c_int, ctypes.c_size_t,
+        ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p,
+    ]
+    lib.eval_poly_n.argtypes = [
+        ctypes.c_void_p, ctypes.c_int, ctypes.c_void_p, ctypes.c_size_t,
+        ctypes.c_void_p, ctypes.c_void_p,
+    ]
+    lib.eval_poly_n_complex.argtypes = [
+        ctypes.c_void_p, ctypes.c_int, ctypes.c_void_p, ctypes.c_void_p, ctypes.c_size_t,
+        ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p,
+    ]
+    return lib
+
+
+_lib = _load()
+
+
+def roots_buffer(coeffs, degree, count, poly_stride, coef_stride, roots, nroots=None):
+    """Low-level call on raw buffers; no NumPy needed.
+
+    coeffs, roots and nroots are addresses (ints) or writable buffers such
+    as array('d') / array('i'); strides count doubles. roots receives
+    2 * count * degree doubles (re, im interleaved)."""
+    def addr(buf, ctype):
+        if buf is None or isinstance(buf, int):
+            return buf
+        return ctypes.addressof(ctype.from_buffer(buf))
+
+    if degree < 1 or degree > MAX_DEGREE:
+        raise ValueError(f"degree must be 1..{MAX_DEGREE}, got {degree}")
+    rc = _lib.dskypoly_roots_strided(addr(coeffs, ctypes.c_double), degree, count,
+                                     poly_stride, coef_stride,
+                                     addr(roots, ctypes.c_double),
+                                     addr(nroots, ctypes.c_int))
+    if rc != 0:
+        raise OSError(ctypes.get_errno(), os.strerror(ctypes.get_errno()))
+
+
+def roots(coeffs, out=None, nroots=None, method=None):
+    """Roots of every row of coeffs, highest power first.
+
+    coeffs is float64 of shape (n, degree+1) in any layout (transposed and
+    sliced views are fine), or 1-D for a single polynomial. out, if given,
+    must be a C-contiguous complex128 array of shape (n, degree); nroots an
+    int32 array of shape (n,), set to degree or 0 for a zero leading
+    coefficient. method="qr" takes companion-matrix eigenvalues instead
+    (numpy.roots' method, degree <= QR_MAX_DEGREE), at the cost of one
+    copy of coeffs into coefficient planes. Returns out."""
+    import numpy as np
+
+    if coeffs.dtype != np.float64:
+        raise TypeError("coeffs must be float64 (convert once with astype)")
+    single = coeffs.ndim == 1
+    c = coeffs[np.newaxis, :] if single else coeffs
+    if c.ndim != 2:
+        raise ValueError("coeffs must be 1-D or 2-D")
+    n, degree = c.shape[0], c.shape[1] - 1
+
+    if out is None:
+        out = np.empty((n, degree), dtype=np.complex128)
+    elif (out.dtype != np.complex128 or out.shape != (n, degree)
+          or not out.flags.c_contiguous or not out.flags.writeable):
+        raise ValueError(f"out must be a writable C-contiguous complex128 array of shape {(n, degree)}")
+    if nroots is not None and (nroots.dtype != np.int32 or nroots.shape != (n,)
+                               or not nroots.flags.c_contiguous):
+        raise ValueError(f"nroots must be a C-contiguous int32 array of shape {(n,)}")
+
+    if method == "qr":
+        if degree < 1 or degree > QR_MAX_DEGREE:
+            raise ValueError(f"method='qr' needs degree 1..{QR_MAX_DEGREE}, got {degree}")
+        planes = np.ascontiguousarray(c.T)
+        re = np.empty((degree, n))
+        im = np.empty((degree, n))
+        _lib.solve_poly_n_companion_batch(planes.ctypes.data, degree, n,
+                                          re.ctypes.data, im.ctypes.data,
+                                          None if nroots is None else nroots.ctypes.data)
+        out.real[...] = re.T
+        out.imag[...] = im.T
+        return out[0] if single else out
+    if method is not None:
+        raise ValueError(f"unknown method {method!r}")
+
+    # NumPy strides are in bytes and may be negative; the C side takes doubles
+    roots_buffer(c.ctypes.data, degree, n, c.strides[0] // 8, c.strides[1] // 8,
+                 out.ctypes.data, None if nroots is None else nroots.ctypes.data)
+    return out[0] if single else out
+
+
+def evaluate(coeffs, x, derivative=False):
+    """p(x), and p'(x) when derivative is set, at every point of x.
+
+    coeffs is a 1-D float64 array, highest power first, of any degree that
+    fits a C int (the kernels read it in place). Real float64 points
+    are read in place when contiguous; complex points are split into real
+    and imaginary planes for the kernel. Returns p or (p, dp), shaped like x."""
+    import numpy as np
+
+    c = np.ascontiguousarray(coeffs, dtype=np.float64)
+    if c.ndim != 1 or c.size < 1:
+        raise ValueError("coeffs must be a non-empty 1-D array")
+    n = c.size - 1
+    if n > 2**31 - 1:
+        raise ValueError("degree must fit the kernels' int n")
+    x = np.asarray(x)
+    if np.iscomplexobj(x):
+        xr = np.ascontiguousarray(x.real, dtype=np.float64)
+        xi = np.ascontiguousarray(x.imag, dtype=np.float64)
+        pr, pi = np.empty_like(xr), np.empty_like(xr)
+        dr, di = (np.empty_like(xr), np.empty_like(xr)) if derivative else (None, None)
+        _lib.eval_poly_n_complex(c.ctypes.data, n, xr.ctypes.data, xi.ctypes.data, xr.size,
+                                 pr.ctypes.data, pi.ctypes.data,
+                                 None if dr is None else dr.ctypes.data,
+                                 None if di is None else di.ctypes.data)
+        p = pr + 1j * pi
+        return (p, dr + 1j * di) if derivative else p
+    x = np.ascontiguousarray(x, dtype=np.float64)
+    p = np.empty_like(x)
+    dp = np.empty_like(x) if derivative else None
+    _lib.eval_poly_n(c.ctypes.data, n, x.ctypes.data, x.size, p.ctypes.data,
+                     None if dp is None else dp.ctypes.data)
+    return (p, dp) if derivative else p
+
+
+class Tracker:
+    """Warm-started roots for streams of slowly drifting polynomials.
+
+    update() remembers each stream's roots and, while its coefficients only
+    drift, moves them to first order plus about one Newton step instead of
+    solving again. Not thread-safe: one Tracker per thread.
+
+        tr = Tracker()
+        for tick in feed:
+            z = tr.update(tick.symbol_id, tick.coeffs)   # highest power first
+    """
+
+    def __init__(self, max_drift=0.0, tol=0.0):
+        self._t = _lib.dskypoly_tracker_create(max_drift, tol)
+        if not self._t:
+            raise MemoryError("dskypoly_tracker_create")
+        self.steps = -1     # Newton steps of the last update, -1 if solved cold
+
+    def update(self, stream, coeffs):
+        """Roots of the stream's next polynomial as a list of complex."""
+        degree = len(coeffs) - 1
+        if degree < 1 or degree > MAX_DEGREE:
+            raise ValueError(f"degree must be 1..{MAX_DEGREE}, got {degree}")
+        c = (ctypes.c_double * (degree + 1))(*coeffs)
+        re = (ctypes.c_double * degree)()
+        im = (ctypes.c_double * degree)()
+        steps = ctypes.c_int()
+        n = _lib.dskypoly_tracker_update(self._t, stream, c, degree, re, im,
+                                         ctypes.byref(steps))
+        if n < 0:
+            raise OSError(ctypes.get_errno(), os.strerror(ctypes.get_errno()))
+        self.steps = steps.value
+        return [complex(re[k], im[k]) for k in range(n)]
+
+    def forget(self, stream):
+        _lib.dskypoly_tracker_forget(self._t, stream)
+
+    def close(self):
+        if self._t:
+            _lib.dskypoly_tracker_destroy(self._t)
+            self._t = None
+
+    def __del__(self):
+        self.close()
+
+
+if __name__ == "__main__":
+    # python3 dskypoly_native.py a b c ...  (coefficients, highest power first)
+    from array import array
+    c = array("d", map(float, sys.argv[1:] or ["1", "-3", "2"]))
+    degree = len(c) - 1
+    z = array("d", bytes(16 * degree))
+    roots_buffer(c, degree, 1, 0, 1, z)
+    for k in range(degree):
+        print(f"x{k + 1} = {complex(z[2 * k], z[2 * k + 1])}")
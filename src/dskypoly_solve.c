@@ -0,0 +1,520 @@
+// === dskypoly_solve.c for DSKYpoly ===
+// Bulk driver: solves a mixed batch of degree 2-5 polynomials on every core.
+//
+// The batch is cut into chunks of consecutive polynomials and every worker
+// starts with an equal share of chunks. A quintic costs tens of quadratics,
+// so equal shares do not finish together: a worker that runs dry steals the
+// back half of the first non-empty share it finds and keeps going.
+//
+// Each share is a [begin, end) range of chunk indices packed into a single
+// 64-bit word. The owner pops from the front and thieves cut from the back,
+// both with one compare-and-swap, so the only shared writes are one CAS per
+// chunk on the owner's own cache line.
+//
+// Every solve is timed with the TSC and recorded in the calling thread's
+// statistics block (src/dskypoly_stats.c): degree, outcome class, cycles,
+// and for quintics the special form detected and the Aberth sweep count.
+// Quartics and quintics with rational roots (zero roots for any
+// coefficients, the rest for integer ones) have them split off exactly
+// first and the cofactor solved a degree or two down.
+// An optional refinement pass (src/refine_poly_n.asm) polishes the roots
+// right after each solve, while the coefficients are still in cache.
+// dskypoly_solve_cached puts a root cache (src/dskypoly_cache.c) in front
+// of every scalar solve.
+//
+// dskypoly_solve_sorted first classifies every polynomial by the kernel
+// and branch it will take (degree, then the quintic special form) and
+// counting-sorts the indices by that kind. Chunks then walk the sorted
+// order: runs of quadratics and cubics are gathered into planes for the
+// packed batch kernels, every other kind reaches its scalar kernel in
+// uniform runs that keep its branches predicted, and roots are scattered
+// back to the caller's original slots.
+
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <x86intrin.h>
+
+#include "dskypoly.h"
+
+#define SOLVE_CHUNK 256   // polynomials per scheduling unit (~10-100 us of work)
+
+// One share per worker, padded so owners never false-share
+typedef struct {
+    _Alignas(64) _Atomic uint64_t range;   // begin | (uint64_t)end << 32
+} solve_share;
+
+typedef struct {
+    const dskypoly_poly* polys;
+    size_t n;
+    size_t chunk;            // polynomials per chunk
+    double* re;
+    double* im;
+    int* nroots;
+    const dskypoly_refine* refine;  // NULL, or steps > 0
+    const uint32_t* order;          // sorted solve order (NULL: as given)
+    const uint8_t* kind;            // solve_kind of every polynomial
+    dskypoly_cache* cache;          // NULL: solve everything
+    int workers;
+    solve_share* shares;
+} solve_job;
+
+typedef struct {
+    solve_job* job;
+    int id;
+    int started;             // pthread_create succeeded, join at the end
+    pthread_t tid;
+} solve_worker;
+
+// Sort keys of the pre-pass, one per kernel and predicted branch
+enum {
+    KIND_SCALAR,             // zero leading coefficient or unsupported degree
+    KIND_QUADRATIC,
+    KIND_CUBIC,
+    KIND_QUARTIC,
+    KIND_QUINTIC,            // + DSKYPOLY_SPECIAL_*: one bucket per form
+    KIND_COUNT = KIND_QUINTIC + DSKYPOLY_SPECIAL_CASES
+};
+
+static inline uint64_t pack_range(uint32_t begin, uint32_t end) {
+    return begin | (uint64_t)end << 32;
+}
+
+// Rational roots split off exactly (src/dskypoly_galois.c), the cofactor
+// through the kernel one or two degrees down; -1 when there were none
+static int solve_split(const double* c, int degree, double* re, double* im) {
+    double q[DSKYPOLY_MAX_DEGREE + 1];
+    int k = dskypoly_galois_split(c, degree, re, q);
+    if (!k)
+        return -1;
+    dskypoly_stats_split(k);
+    for (int j = 0; j < k; j++)
+        im[j] = 0.0;
+    re += k;
+    im += k;
+
+    switch (degree - k) {
+    case 1:
+        re[0] = -q[1] / q[0];
+        im[0] = 0.0;
+        return degree;
+    case 2:
+        solve_poly_2(q[0], q[1], q[2], &re[0], &im[0], &re[1], &im[1]);
+        return degree;
+    case 3:
+        return k + solve_poly_3(q[0], q[1], q[2], q[3], re, im);
+    case 4:
+        return k + solve_poly_4_production(q[0], q[1], q[2], q[3], q[4], re, im);
+    }
+    return k;
+}
+
+// One polynomial through the degree's silent kernel
+static int solve_one(const dskypoly_poly* p, double* re, double* im) {
+    const double* c = p->coeffs;
+    int r;
+
+    switch (p->degree) {
+    case 2:
+        if (c[0] == 0.0)
+            return 0;
+        solve_poly_2(c[0], c[1], c[2], &re[0], &im[0], &re[1], &im[1]);
+        return 2;
+    case 3:
+        return solve_poly_3(c[0], c[1], c[2], c[3], re, im);
+    case 4:
+        if (c[0] != 0.0 && (r = solve_split(c, 4, re, im)) >= 0)
+            return r;
+        return solve_poly_4_production(c[0], c[1], c[2], c[3], c[4], re, im);
+    case 5: {
+        // Radical-solvable forms first, then rational roots split off;
+        // everything else goes to Aberth
+        int kind, sweeps;
+        r = solve_poly_5_special_r(c[0], c[1], c[2], c[3], c[4], c[5], re, im, &kind);
+        dskypoly_stats_special(kind);
+        if (r == 5 || (c[0] != 0.0 && (r = solve_split(c, 5, re, im)) >= 0))
+            return r;
+        r = solve_poly_n_aberth_sweeps(c, 5, re, im, &sweeps);
+        dskypoly_stats_sweeps(sweeps);
+        return r;
+    }
+    }
+    return -1;
+}
+
+static int solve_counted(const dskypoly_poly* p, double* re, double* im) {
+    uint64_t t0 = __rdtsc();
+    int r = solve_one(p, re, im);
+    dskypoly_stats_record(p->degree, r, re, im, __rdtsc() - t0);
+    return r;
+}
+
+// Solve polys[i] (through the cache when there is one), then polish
+// whatever the kernel produced
+static int solve_refined(const solve_job* job, size_t i) {
+    const dskypoly_poly* p = &job->polys[i];
+    const dskypoly_refine* refine = job->refine;
+    size_t off = i * DSKYPOLY_MAX_DEGREE;
+    double* re = job->re + off;
+    double* im = job->im + off;
+
+    int r = job->cache ? dskypoly_cache_lookup(job->cache, p, re, im) : -1;
+    if (r < 0) {
+        r = solve_counted(p, re, im);
+        if (job->cache)
+            dskypoly_cache_insert(job->cache, p, r, re, im);
+    }
+    if (refine && r > 0)
+        refine_poly_n(p->coeffs, p->degree, re, im,
+                      refine->err ? refine->err + off : NULL, refine->steps, refine->tol);
+    return r;
+}
+
+// Bookkeeping for a root set a batch kernel wrote to slot idx
+static void finish_batched(solve_job* job, size_t idx, int r, uint64_t cycles) {
+    const dskypoly_poly* p = &job->polys[idx];
+    size_t off = idx * DSKYPOLY_MAX_DEGREE;
+
+    dskypoly_stats_record(p->degree, r, job->re + off, job->im + off, cycles);
+    if (job->refine)
+        refine_poly_n(p->coeffs, p->degree, job->re + off, job->im + off,
+                      job->refine->err ? job->refine->err + off : NULL,
+                      job->refine->steps, job->refine->tol);
+    if (job->nroots)
+        job->nroots[idx] = r;
+}
+
+// order[0..m) are all quadratics with a != 0
+static void run_quadratics(solve_job* job, const uint32_t* order, size_t m) {
+    double a[SOLVE_CHUNK], b[SOLVE_CHUNK], c[SOLVE_CHUNK];
+    double r1r[SOLVE_CHUNK], r1i[SOLVE_CHUNK], r2r[SOLVE_CHUNK], r2i[SOLVE_CHUNK];
+
+    for (size_t j = 0; j < m; j++) {
+        const double* k = job->polys[order[j]].coeffs;
+        a[j] = k[0];
+        b[j] = k[1];
+        c[j] = k[2];
+    }
+    uint64_t t0 = __rdtsc();
+    solve_poly_2_batch(a, b, c, m, r1r, r1i, r2r, r2i);
+    uint64_t cycles = (__rdtsc() - t0) / m;
+
+    for (size_t j = 0; j < m; j++) {
+        size_t off = order[j] * (size_t)DSKYPOLY_MAX_DEGREE;
+        job->re[off] = r1r[j];
+        job->im[off] = r1i[j];
+        job->re[off + 1] = r2r[j];
+        job->im[off + 1] = r2i[j];
+        finish_batched(job, order[j], 2, cycles);
+    }
+}
+
+// order[0..m) are all cubics with a != 0
+static void run_cubics(solve_job* job, const uint32_t* order, size_t m) {
+    double a[SOLVE_CHUNK], b[SOLVE_CHUNK], c[SOLVE_CHUNK], d[SOLVE_CHUNK];
+    double r[3 * SOLVE_CHUNK], s[3 * SOLVE_CHUNK];
+
+    for (size_t j = 0; j < m; j++) {
+        const double* k = job->polys[order[j]].coeffs;
+        a[j] = k[0];
+        b[j] = k[1];
+        c[j] = k[2];
+        d[j] = k[3];
+    }
+    uint64_t t0 = __rdtsc();
+    solve_poly_3_batch(a, b, c, d, m, r, s);
+    uint64_t cycles = (__rdtsc() - t0) / m;
+
+    for (size_t j = 0; j < m; j++) {
+        size_t off = order[j] * (size_t)DSKYPOLY_MAX_DEGREE;
+        for (int k = 0; k < 3; k++) {
+            job->re[off + k] = r[k * m + j];
+            job->im[off + k] = s[k * m + j];
+        }
+        finish_batched(job, order[j], 3, cycles);
+    }
+}
+
+// A stretch of the sorted order: one kernel call per run of equal kinds,
+// at most SOLVE_CHUNK long
+static void run_sorted_chunk(solve_job* job, size_t i, size_t end) {
+    while (i < end) {
+        int kind = job->kind[job->order[i]];
+        size_t run = i + 1;
+        while (run < end && run - i < SOLVE_CHUNK && job->kind[job->order[run]] == kind)
+            run++;
+
+        if (kind == KIND_QUADRATIC) {
+            run_quadratics(job, job->order + i, run - i);
+        } else if (kind == KIND_CUBIC) {
+            run_cubics(job, job->order + i, run - i);
+        } else {
+            for (size_t j = i; j < run; j++) {
+                uint32_t idx = job->order[j];
+                int r = solve_refined(job, idx);
+                if (job->nroots)
+                    job->nroots[idx] = r;
+            }
+        }
+        i = run;
+    }
+}
+
+static void run_chunk(solve_job* job, uint32_t chunk) {
+    size_t i = (size_t)chunk * job->chunk;
+    size_t end = i + job->chunk < job->n ? i + job->chunk : job->n;
+
+    if (job->order) {
+        run_sorted_chunk(job, i, end);
+        return;
+    }
+    for (; i < end; i++) {
+        int r = solve_refined(job, i);
+        if (job->nroots)
+            job->nroots[i] = r;
+    }
+}
+
+// Owner side: take the front chunk of our own share
+static int pop_own(solve_share* share, uint32_t* chunk) {
+    uint64_t r = atomic_load(&share->range);
+    for (;;) {
+        uint32_t begin = (uint32_t)r, end = (uint32_t)(r >> 32);
+        if (begin >= end)
+            return 0;
+        if (atomic_compare_exchange_weak(&share->range, &r, pack_range(begin + 1, end))) {
+            *chunk = begin;
+            return 1;
+        }
+    }
+}
+
+// Thief side: move the back half (rounded up) of some victim's share into
+// ours. Shares only ever shrink except through this call, and a thief always
+// works through what it took, so finding every share empty means done.
+static int steal(solve_job* job, int self) {
+    for (int k = 1; k < job->workers; k++) {
+        solve_share* victim = &job->shares[(self + k) % job->workers];
+        uint64_t r = atomic_load(&victim->range);
+        for (;;) {
+            uint32_t begin = (uint32_t)r, end = (uint32_t)(r >> 32);
+            if (begin >= end)
+                break;
+            uint32_t split = end - (end - begin + 1) / 2;
+            if (atomic_compare_exchange_weak(&victim->range, &r, pack_range(begin, split))) {
+                atomic_store(&job->shares[self].range, pack_range(split, end));
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+static void* worker_main(void* arg) {
+    solve_worker* w = arg;
+    solve_job* job = w->job;
+    uint32_t chunk;
+
+    for (;;) {
+        if (pop_own(&job->shares[w->id], &chunk))
+            run_chunk(job, chunk);
+        else if (!steal(job, w->id))
+            break;
+    }
+    return NULL;
+}
+
+// Worker count: explicit request, then DSKYPOLY_THREADS, then online CPUs
+static int resolve_threads(int threads) {
+    if (threads <= 0) {
+        const char* env = getenv("DSKYPOLY_THREADS");
+        if (env)
+            threads = atoi(env);
+    }
+    if (threads <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 0 ? (int)cpus : 1;
+    }
+    return threads;
+}
+
+int dskypoly_solve(const dskypoly_poly* polys, size_t n,
+                   double* re, double* im, int* nroots, int threads) {
+    return dskypoly_solve_refined(polys, n, re, im, nroots, threads, NULL);
+}
+
+static inline size_t round64(size_t bytes) {
+    return (bytes + 63) & ~(size_t)63;
+}
+
+// Shares and worker records for a pool of `threads`, from one block
+static size_t pool_bytes(int threads) {
+    return round64(sizeof(solve_share) * threads) + round64(sizeof(solve_worker) * threads);
+}
+
+// Runs a prepared job on the pool; job->chunk may still be shrunk to fit.
+// pool is pool_bytes(threads) of 64-byte aligned scratch for the resolved
+// thread count, or NULL to allocate it here.
+static int run_job(solve_job* job, int threads, void* pool) {
+    size_t n = job->n;
+    int* nroots = job->nroots;
+
+    // Chunk indices must fit the 32-bit halves of a share
+    if ((n + job->chunk - 1) / job->chunk > UINT32_MAX)
+        job->chunk = (n + UINT32_MAX - 1) / UINT32_MAX;
+    size_t chunks = (n + job->chunk - 1) / job->chunk;
+
+    threads = resolve_threads(threads);
+    if ((size_t)threads > chunks)
+        threads = (int)chunks;
+    job->workers = threads;
+
+    void* owned = NULL;
+    if (!pool)
+        pool = owned = aligned_alloc(64, pool_bytes(threads));
+    if (!pool) {
+        // No room for a scheduler: solve everything on the calling thread
+        if (job->order) {
+            run_sorted_chunk(job, 0, n);
+            return 1;
+        }
+        for (size_t i = 0; i < n; i++) {
+            int r = solve_refined(job, i);
+            if (nroots)
+                nroots[i] = r;
+        }
+        return 1;
+    }
+    job->shares = pool;
+    solve_worker* workers =
+        (solve_worker*)((char*)pool + round64(sizeof(solve_share) * threads));
+
+    for (int t = 0; t < threads; t++) {
+        atomic_init(&job->shares[t].range,
+                    pack_range((uint32_t)(chunks * t / threads),
+                               (uint32_t)(chunks * (t + 1) / threads)));
+        workers[t].job = job;
+        workers[t].id = t;
+        workers[t].started = 0;
+    }
+
+    // The calling thread is worker 0. A worker that fails to start leaves
+    // its share behind, and the others steal it.
+    int started = 1;
+    for (int t = 1; t < threads; t++) {
+        workers[t].started =
+            pthread_create(&workers[t].tid, NULL, worker_main, &workers[t]) == 0;
+        started += workers[t].started;
+    }
+    worker_main(&workers[0]);
+    for (int t = 1; t < threads; t++)
+        if (workers[t].started)
+            pthread_join(workers[t].tid, NULL);
+
+    free(owned);
+    return started;
+}
+
+int dskypoly_solve_refined(const dskypoly_poly* polys, size_t n,
+                           double* re, double* im, int* nroots, int threads,
+                           const dskypoly_refine* refine) {
+    if (n == 0)
+        return 0;
+
+    solve_job job = {
+        .polys = polys, .n = n, .chunk = SOLVE_CHUNK,
+        .re = re, .im = im, .nroots = nroots,
+        .refine = refine && refine->steps > 0 ? refine : NULL,
+    };
+    return run_job(&job, threads, NULL);
+}
+
+int dskypoly_solve_cached(dskypoly_cache* cache, const dskypoly_poly* polys, size_t n,
+                          double* re, double* im, int* nroots, int threads,
+                          const dskypoly_refine* refine) {
+    if (n == 0)
+        return 0;
+
+    solve_job job = {
+        .polys = polys, .n = n, .chunk = SOLVE_CHUNK,
+        .re = re, .im = im, .nroots = nroots,
+        .refine = refine && refine->steps > 0 ? refine : NULL,
+        .cache = cache,
+    };
+    return run_job(&job, threads, NULL);
+}
+
+// Quintic form with the detector's exact zero test (solve_poly_5_special.asm)
+static int quintic_form(const double* c) {
+    if (c[1] == 0.0 && c[2] == 0.0 && c[3] == 0.0)
+        return c[4] == 0.0 ? DSKYPOLY_SPECIAL_MONOMIAL : DSKYPOLY_SPECIAL_BINOMIAL;
+    return c[5] == 0.0 ? DSKYPOLY_SPECIAL_FACTORIZABLE : DSKYPOLY_SPECIAL_GENERAL;
+}
+
+static int solve_kind(const dskypoly_poly* p) {
+    if (p->degree < 2 || p->degree > DSKYPOLY_MAX_DEGREE || p->coeffs[0] == 0.0)
+        return KIND_SCALAR;
+    if (p->degree == 5)
+        return KIND_QUINTIC + quintic_form(p->coeffs);
+    return KIND_QUADRATIC + p->degree - 2;
+}
+
+// Scratch layout: pool, then order[n], then kind[n]
+size_t dskypoly_solve_scratch_bytes(size_t n, int threads) {
+    return pool_bytes(resolve_threads(threads)) + round64(n * sizeof(uint32_t)) + round64(n);
+}
+
+int dskypoly_solve_sorted_in(void* scratch, const dskypoly_poly* polys, size_t n,
+                             double* re, double* im, int* nroots, int threads,
+                             const dskypoly_refine* refine) {
+    if (n == 0)
+        return 0;
+    if (n > UINT32_MAX)
+        return dskypoly_solve_refined(polys, n, re, im, nroots, threads, refine);
+
+    // Laid out for the resolved worker count, as the size query was; the
+    // pool only shrinks when run_job clips that count to the chunks
+    threads = resolve_threads(threads);
+    char* pool = scratch;
+    uint32_t* order = (uint32_t*)(pool + pool_bytes(threads));
+    uint8_t* kind = (uint8_t*)order + round64(n * sizeof(uint32_t));
+
+    // Counting sort: histogram, exclusive prefix sum, stable scatter
+    size_t start[KIND_COUNT] = { 0 };
+    for (size_t i = 0; i < n; i++) {
+        kind[i] = (uint8_t)solve_kind(&polys[i]);
+        start[kind[i]]++;
+    }
+    for (size_t k = 0, pos = 0; k < KIND_COUNT; k++) {
+        size_t count = start[k];
+        start[k] = pos;
+        pos += count;
+    }
+    for (size_t i = 0; i < n; i++)
+        order[start[kind[i]]++] = (uint32_t)i;
+
+    solve_job job = {
+        .polys = polys, .n = n, .chunk = SOLVE_CHUNK,
+        .re = re, .im = im, .nroots = nroots,
+        .refine = refine && refine->steps > 0 ? refine : NULL,
+        .order = order, .kind = kind,
+    };
+    return run_job(&job, threads, pool);
+}
+
+int dskypoly_solve_sorted(const dskypoly_poly* polys, size_t n,
+                          double* re, double* im, int* nroots, int threads,
+                          const dskypoly_refine* refine) {
+    if (n == 0)
+        return 0;
+
+    void* scratch = aligned_alloc(64, dskypoly_solve_scratch_bytes(n, threads));
+    if (!scratch)
+        return dskypoly_solve_refined(polys, n, re, im, nroots, threads, refine);
+    int started = dskypoly_solve_sorted_in(scratch, polys, n, re, im, nroots, threads, refine);
+    free(scratch);
+    return started;
+}
@@ -0,0 +1,328 @@
+// === dskypoly_stats.c for DSKYpoly ===
+// Per-thread solver counters, aggregated on demand without locks.
+//
+// Every thread that records a solve gets its own 64-byte aligned block of
+// counters, found through a thread-local pointer. Only that thread writes
+// the block, so a bump is a relaxed load and store of a plain word: no
+// lock prefix and no shared cache line on the hot path.
+//
+// Blocks are pushed once onto a lock-free list and never freed. A snapshot
+// walks the list and sums relaxed loads, so it may see a solve that is
+// half recorded (solves bumped, cycles not yet), but never a torn counter.
+// When a thread exits its block is released for the next new thread to
+// claim, counts and all, so totals survive thread churn without the list
+// growing past the peak number of live threads.
+//
+// Kernels assembled for profiling also land here, one call per solve with
+// a TSC stamp per phase (include/dskypoly_phase.inc). The per-phase totals
+// and histograms sit in the same block, and dskypoly_stats_fold writes them
+// as folded stacks for a flame graph.
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <x86intrin.h>
+
+#include "dskypoly.h"
+
+// Counters in the layout of dskypoly_stats, one writer each
+typedef struct stats_block {
+    _Alignas(64) _Atomic uint64_t counters[sizeof(dskypoly_stats) / sizeof(uint64_t)];
+    struct stats_block* next;           // immutable once published
+    _Atomic int owned;                  // claimed by a live thread
+} stats_block;
+
+static _Atomic(stats_block*) stats_head;
+static pthread_key_t stats_key;
+static pthread_once_t stats_once = PTHREAD_ONCE_INIT;
+static _Thread_local stats_block* local_block;
+
+#define COUNTER_INDEX(field) (offsetof(dskypoly_stats, field) / sizeof(uint64_t))
+
+// The phase labels of cubic/src/solve_poly_3.asm and
+// quartic/src/solve_poly_4_production.asm, by DSKYPOLY_PHASE_*
+static const char* phase_names[DSKYPOLY_PHASES] = {
+    "cardano_monic", "cardano_depress", "cardano_discriminant", "cardano_one_real",
+    "cardano_three_real", "ferrari_monic", "ferrari_depress", "ferrari_resolvent",
+    "ferrari_resolvent_root", "ferrari_extract", "ferrari_biquadratic"
+};
+
+// The destructor only runs for threads that recorded something
+static void release_block(void* block) {
+    atomic_store_explicit(&((stats_block*)block)->owned, 0, memory_order_release);
+}
+
+static void make_key(void) {
+    pthread_key_create(&stats_key, release_block);
+}
+
+static stats_block* claim_block(void) {
+    pthread_once(&stats_once, make_key);
+
+    // Reuse a block left behind by an exited thread
+    stats_block* b = atomic_load_explicit(&stats_head, memory_order_acquire);
+    for (; b; b = b->next) {
+        int free_block = 0;
+        if (atomic_compare_exchange_strong_explicit(&b->owned, &free_block, 1,
+                                                    memory_order_acquire,
+                                                    memory_order_relaxed))
+            break;
+    }
+
+    if (!b) {
+        b = aligned_alloc(64, sizeof(stats_block));
+        if (!b)
+            return NULL;
+        memset(b, 0, sizeof(*b));
+        atomic_init(&b->owned, 1);
+        b->next = atomic_load_explicit(&stats_head, memory_order_relaxed);
+        while (!atomic_compare_exchange_weak_explicit(&stats_head, &b->next, b,
+                                                      memory_order_release,
+                                                      memory_order_relaxed))
+            ;
+    }
+    pthread_setspecific(stats_key, b);
+    local_block = b;
+    return b;
+}
+
+static inline _Atomic uint64_t* local_counters(void) {
+    stats_block* b = local_block;
+    if (__builtin_expect(!b, 0) && !(b = claim_block()))
+        return NULL;
+    return b->counters;
+}
+
+// Single writer: a relaxed load and store, never a locked add
+static inline void bump(_Atomic uint64_t* c, uint64_t v) {
+    atomic_store_explicit(c, atomic_load_explicit(c, memory_order_relaxed) + v,
+                          memory_order_relaxed);
+}
+
+// Bucket b holds values in [2^b, 2^(b+1)); 0 lands in bucket 0
+static inline int log2_bucket(uint64_t v, int buckets) {
+    int b = v ? 63 - __builtin_clzll(v) : 0;
+    return b < buckets ? b : buckets - 1;
+}
+
+static inline double abs_d(double x) {
+    return x < 0 ? -x : x;
+}
+
+// Outcome class from the roots: an imaginary part above 1e-12 relative is
+// a complex pair (the iterative solvers leave rounding noise on real
+// roots), two real roots equal to 1e-9 relative a double root
+static int root_class(int n, const double* re, const double* im) {
+    for (int k = 0; k < n; k++)
+        if (abs_d(im[k]) > 1e-12 * (1.0 + abs_d(re[k])))
+            return DSKYPOLY_ROOTS_COMPLEX;
+    for (int j = 0; j < n; j++)
+        for (int k = j + 1; k < n; k++)
+            if (abs_d(re[j] - re[k]) <= 1e-9 * (1.0 + abs_d(re[j])))
+                return DSKYPOLY_ROOTS_DOUBLE;
+    return DSKYPOLY_ROOTS_REAL;
+}
+
+void dskypoly_stats_record(int degree, int nroots, const double* re, const double* im,
+                           uint64_t cycles) {
+    _Atomic uint64_t* c = local_counters();
+    if (!c || degree < 0 || degree > DSKYPOLY_MAX_DEGREE)
+        return;
+
+    bump(&c[COUNTER_INDEX(solves) + degree], 1);
+    bump(&c[COUNTER_INDEX(cycles) + degree * DSKYPOLY_CYCLE_BUCKETS
+            + log2_bucket(cycles, DSKYPOLY_CYCLE_BUCKETS)], 1);
+    if (nroots < degree) {
+        bump(&c[COUNTER_INDEX(failures) + degree], 1);
+        return;
+    }
+    bump(&c[COUNTER_INDEX(roots) + degree * DSKYPOLY_ROOTS_CLASSES
+            + root_class(degree, re, im)], 1);
+}
+
+void dskypoly_stats_record_batch(int degree, size_t n, uint64_t cycles) {
+    _Atomic uint64_t* c = local_counters();
+    if (!c || n == 0 || degree < 0 || degree > DSKYPOLY_MAX_DEGREE)
+        return;
+
+    bump(&c[COUNTER_INDEX(solves) + degree], n);
+    bump(&c[COUNTER_INDEX(cycles) + degree * DSKYPOLY_CYCLE_BUCKETS
+            + log2_bucket(cycles / n, DSKYPOLY_CYCLE_BUCKETS)], n);
+}
+
+void dskypoly_stats_sweeps(int sweeps) {
+    _Atomic uint64_t* c = local_counters();
+    if (!c || sweeps < 0)
+        return;
+
+    bump(&c[COUNTER_INDEX(sweeps)], (uint64_t)sweeps);
+    bump(&c[COUNTER_INDEX(sweep_hist) + log2_bucket((uint64_t)sweeps, DSKYPOLY_SWEEP_BUCKETS)], 1);
+}
+
+void dskypoly_stats_special(int kind) {
+    _Atomic uint64_t* c = local_counters();
+    if (!c || kind < 0 || kind >= DSKYPOLY_SPECIAL_CASES)
+        return;
+
+    bump(&c[COUNTER_INDEX(special) + kind], 1);
+}
+
+void dskypoly_stats_split(int roots) {
+    _Atomic uint64_t* c = local_counters();
+    if (!c || roots <= 0)
+        return;
+
+    bump(&c[COUNTER_INDEX(splits)], 1);
+    bump(&c[COUNTER_INDEX(split_roots)], (uint64_t)roots);
+}
+
+// Ticks between two back-to-back stamps, the same lfence-ordered reads
+// the kernels take: the least of a few tries, measured once
+static uint64_t stamp_overhead(void) {
+    static _Atomic uint64_t overhead = UINT64_MAX;
+    uint64_t o = atomic_load_explicit(&overhead, memory_order_relaxed);
+    if (o != UINT64_MAX)
+        return o;
+
+    for (int i = 0; i < 64; i++) {
+        _mm_lfence();
+        uint64_t t0 = __rdtsc();
+        _mm_lfence();
+        uint64_t t = __rdtsc() - t0;
+        o = t < o ? t : o;
+    }
+    atomic_store_explicit(&overhead, o, memory_order_relaxed);
+    return o;
+}
+
+void dskypoly_phase_record(int first, int n, const uint64_t* stamps) {
+    _Atomic uint64_t* c = local_counters();
+    if (!c || first < 0 || n < 2 || first + n - 1 > DSKYPOLY_PHASES)
+        return;
+
+    uint64_t overhead = stamp_overhead();
+    for (int k = 0; k < n - 1; k++) {
+        if (!stamps[k])
+            continue;
+        int next = k + 1;
+        while (!stamps[next])           // the end stamp is always taken
+            next++;
+        uint64_t t = stamps[next] - stamps[k];
+        t = t > overhead ? t - overhead : 0;
+        int phase = first + k;
+        bump(&c[COUNTER_INDEX(phase_cycles) + phase], t);
+        bump(&c[COUNTER_INDEX(phase_hist) + phase * DSKYPOLY_PHASE_BUCKETS
+                + log2_bucket(t, DSKYPOLY_PHASE_BUCKETS)], 1);
+    }
+}
+
+void dskypoly_stats_cache(int hit) {
+    _Atomic uint64_t* c = local_counters();
+    if (!c)
+        return;
+
+    bump(&c[hit ? COUNTER_INDEX(cache_hits) : COUNTER_INDEX(cache_misses)], 1);
+}
+
+void dskypoly_stats_snapshot(dskypoly_stats* out) {
+    uint64_t* sum = (uint64_t*)out;
+    memset(out, 0, sizeof(*out));
+
+    stats_block* b = atomic_load_explicit(&stats_head, memory_order_acquire);
+    for (; b; b = b->next) {
+        for (size_t i = 0; i < sizeof(dskypoly_stats) / sizeof(uint64_t); i++)
+            sum[i] += atomic_load_explicit(&b->counters[i], memory_order_relaxed);
+        out->blocks++;
+    }
+}
+
+void dskypoly_stats_print(const dskypoly_stats* s) {
+    static const char* classes[DSKYPOLY_ROOTS_CLASSES] = { "real", "complex", "double" };
+    static const char* special[DSKYPOLY_SPECIAL_CASES] = {
+        "general", "monomial", "binomial", "factorizable"
+    };
+
+    printf("=== Solver Statistics (%llu thread blocks) ===\n", (unsigned long long)s->blocks);
+    for (int d = 0; d <= DSKYPOLY_MAX_DEGREE; d++) {
+        if (!s->solves[d])
+            continue;
+        printf("degree %d: %llu solves", d, (unsigned long long)s->solves[d]);
+        for (int k = 0; k < DSKYPOLY_ROOTS_CLASSES; k++)
+            printf(", %s %llu", classes[k], (unsigned long long)s->roots[d][k]);
+        printf(", failed %llu\n", (unsigned long long)s->failures[d]);
+
+        printf("  cycles:");
+        for (int b = 0; b < DSKYPOLY_CYCLE_BUCKETS; b++)
+            if (s->cycles[d][b])
+                printf(" [2^%d]=%llu", b, (unsigned long long)s->cycles[d][b]);
+        printf("\n");
+    }
+
+    uint64_t numerical = 0;
+    for (int b = 0; b < DSKYPOLY_SWEEP_BUCKETS; b++)
+        numerical += s->sweep_hist[b];
+    if (numerical) {
+        printf("Aberth sweeps: %.2f per solve, histogram:", (double)s->sweeps / numerical);
+        for (int b = 0; b < DSKYPOLY_SWEEP_BUCKETS; b++)
+            if (s->sweep_hist[b])
+                printf(" [2^%d]=%llu", b, (unsigned long long)s->sweep_hist[b]);
+        printf("\n");
+    }
+    for (int k = 0; k < DSKYPOLY_SPECIAL_CASES; k++)
+        if (s->special[k]) {
+            printf("Quintic special cases:");
+            for (int j = 0; j < DSKYPOLY_SPECIAL_CASES; j++)
+                printf(" %s %llu", special[j], (unsigned long long)s->special[j]);
+            printf("\n");
+            break;
+        }
+    if (s->splits)
+        printf("Rational deflation: %llu solves, %llu roots split off exactly\n",
+               (unsigned long long)s->splits, (unsigned long long)s->split_roots);
+    uint64_t lookups = s->cache_hits + s->cache_misses;
+    if (lookups)
+        printf("Root cache: %llu hits, %llu misses (%.1f%% hit rate)\n",
+               (unsigned long long)s->cache_hits, (unsigned long long)s->cache_misses,
+               100.0 * s->cache_hits / lookups);
+
+    for (int p = 0; p < DSKYPOLY_PHASES; p++) {
+        uint64_t runs = 0;
+        for (int b = 0; b < DSKYPOLY_PHASE_BUCKETS; b++)
+            runs += s->phase_hist[p][b];
+        if (!runs)
+            continue;
+        printf("phase %-22s %llu runs, %.1f ticks each:", phase_names[p],
+               (unsigned long long)runs, (double)s->phase_cycles[p] / runs);
+        for (int b = 0; b < DSKYPOLY_PHASE_BUCKETS; b++)
+            if (s->phase_hist[p][b])
+                printf(" [2^%d]=%llu", b, (unsigned long long)s->phase_hist[p][b]);
+        printf("\n");
+    }
+}
+
+const char* dskypoly_phase_name(int phase) {
+    return phase >= 0 && phase < DSKYPOLY_PHASES ? phase_names[phase] : NULL;
+}
+
+int dskypoly_stats_fold(const dskypoly_stats* s, const char* path) {
+    FILE* out = strcmp(path, "-") == 0 ? stdout : fopen(path, "w");
+    if (!out)
+        return -1;
+
+    for (int p = 0; p < DSKYPOLY_PHASES; p++)
+        if (s->phase_cycles[p])
+            fprintf(out, "%s;%s %llu\n",
+                    p < DSKYPOLY_PHASE_FERRARI_MONIC ? "solve_poly_3" : "solve_poly_4_production",
+                    phase_names[p], (unsigned long long)s->phase_cycles[p]);
+    if (out == stdout)
+        return fflush(out) == 0 ? 0 : -1;
+    if (ferror(out)) {
+        fclose(out);
+        errno = EIO;
+        return -1;
+    }
+    return fclose(out) == 0 ? 0 : -1;
+}
@@ -0,0 +1,102 @@
+// === dskypoly_strided.c for DSKYpoly ===
+// Foreign-function entry point: roots of n polynomials of one degree, read
+// through arbitrary element strides and written as interleaved complex
+// doubles, so NumPy (or any FFI) hands over its own buffers untouched.
+//
+// Coefficient k of polynomial i is coeffs[i * poly_stride + k * coef_stride],
+// which covers C-order (n, degree+1) arrays, their transposes and sliced
+// views alike. Quadratics and cubics are gathered a chunk at a time into
+// planes for the packed batch kernels; everything else goes through the
+// scalar kernels one polynomial at a time.
+
+#include <errno.h>
+#include <stddef.h>
+
+#include "dskypoly.h"
+
+#define STRIDED_CHUNK 256
+
+static inline double coef(const double* c, size_t i, int k,
+                          ptrdiff_t poly_stride, ptrdiff_t coef_stride) {
+    return c[(ptrdiff_t)i * poly_stride + (ptrdiff_t)k * coef_stride];
+}
+
+// A zero leading coefficient has no place in the batch kernels: its lane
+// solves the dummy x^2 (or x^3) instead and reports no roots
+static void strided_batch(const double* c, int degree, size_t n,
+                          ptrdiff_t ps, ptrdiff_t cs, double* roots, int* nroots) {
+    double p[4][STRIDED_CHUNK];
+    double re[3 * STRIDED_CHUNK], im[3 * STRIDED_CHUNK];
+
+    for (size_t i = 0; i < n; i += STRIDED_CHUNK) {
+        size_t m = n - i < STRIDED_CHUNK ? n - i : STRIDED_CHUNK;
+        for (size_t j = 0; j < m; j++) {
+            double a = coef(c, i + j, 0, ps, cs);
+            p[0][j] = a != 0.0 ? a : 1.0;
+            for (int k = 1; k <= degree; k++)
+                p[k][j] = a != 0.0 ? coef(c, i + j, k, ps, cs) : 0.0;
+        }
+
+        if (degree == 2)
+            solve_poly_2_batch(p[0], p[1], p[2], m, re, im, re + m, im + m);
+        else
+            solve_poly_3_batch(p[0], p[1], p[2], p[3], m, re, im);
+
+        for (size_t j = 0; j < m; j++) {
+            double* z = roots + 2 * (i + j) * degree;
+            for (int k = 0; k < degree; k++) {
+                z[2 * k] = re[k * m + j];
+                z[2 * k + 1] = im[k * m + j];
+            }
+            if (nroots)
+                nroots[i + j] = coef(c, i + j, 0, ps, cs) != 0.0 ? degree : 0;
+        }
+    }
+}
+
+int dskypoly_roots_strided(const double* coeffs, int degree, size_t n,
+                           ptrdiff_t poly_stride, ptrdiff_t coef_stride,
+                           double* roots, int* nroots) {
+    if (degree < 1 || degree > DSKYPOLY_STRIDED_MAX_DEGREE) {
+        errno = EINVAL;
+        return -1;
+    }
+    if (degree == 2 || degree == 3) {
+        strided_batch(coeffs, degree, n, poly_stride, coef_stride, roots, nroots);
+        return 0;
+    }
+
+    double c[DSKYPOLY_STRIDED_MAX_DEGREE + 1];
+    double re[DSKYPOLY_STRIDED_MAX_DEGREE], im[DSKYPOLY_STRIDED_MAX_DEGREE];
+    for (size_t i = 0; i < n; i++) {
+        for (int k = 0; k <= degree; k++)
+            c[k] = coef(coeffs, i, k, poly_stride, coef_stride);
+
+        int r;
+        if (degree == 1) {
+            r = c[0] != 0.0;
+            re[0] = r ? -c[1] / c[0] : 0.0;
+            im[0] = 0.0;
+        } else if (degree == 4) {
+            r = solve_poly_4_production(c[0], c[1], c[2], c[3], c[4], re, im);
+        } else if (degree == 5 &&
+                   solve_poly_5_special_r(c[0], c[1], c[2], c[3], c[4], c[5], re, im, NULL) == 5) {
+            r = 5;
+        } else {
+            r = solve_poly_n_aberth(c, degree, re, im);
+            // Unconverged roots are still the best approximations; only a
+            // zero leading coefficient leaves nothing to report
+            if (c[0] != 0.0)
+                r = degree;
+        }
+
+        double* z = roots + 2 * i * degree;
+        for (int k = 0; k < degree; k++) {
+            z[2 * k] = r ? re[k] : 0.0;
+            z[2 * k + 1] = r ? im[k] : 0.0;
+        }
+        if (nroots)
+            nroots[i] = r;
+    }
+    return 0;
+}
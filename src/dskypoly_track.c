@@ -0,0 +1,292 @@
+// === dskypoly_track.c for DSKYpoly ===
+// Root tracking for streams of slowly drifting polynomials.
+//
+// Each stream ID keeps its last coefficients and roots. An update whose
+// coefficients moved by at most max_drift (relative) never touches the
+// closed forms: every old root z is moved to first order,
+//
+//   z <- z - dp(z) / p'(z)        dp = p_new - p_old, p' of the old polynomial
+//
+// and Newton on the new polynomial finishes the job, usually in one step
+// since the first-order move already leaves an error of order drift^2. A
+// root that will not settle in DSKYPOLY_TRACK_STEPS, or two roots whose
+// disks overlap (both chased one true root), sends the update to a cold
+// solve, as does a first tick, a new degree or a larger jump. The stop test
+// is the plain Newton step rather than refine_poly_n's rigorous radii:
+// the bounds cost more than the tick they would be checking. Streams live
+// in an open-addressing table keyed by ID, each with one allocation for
+// its state.
+
+#include <errno.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "dskypoly.h"
+
+#define TRACK_MIN_SLOTS 64            // power of two; doubles at half load
+
+typedef struct {
+    uint64_t id;
+    int degree;                       // 0: empty slot
+    double* state;                    // coeffs[degree+1], re[degree], im[degree]
+} track_slot;
+
+struct dskypoly_tracker {
+    track_slot* slots;
+    size_t mask;                      // slot count - 1
+    size_t used;
+    double max_drift;
+    double tol;
+};
+
+// splitmix64 finalizer: sequential IDs spread over the whole table
+static inline size_t slot_hash(uint64_t id) {
+    id ^= id >> 30;
+    id *= 0xBF58476D1CE4E5B9ull;
+    id ^= id >> 27;
+    id *= 0x94D049BB133111EBull;
+    id ^= id >> 31;
+    return (size_t)id;
+}
+
+static track_slot* find_slot(const dskypoly_tracker* t, uint64_t id) {
+    for (size_t i = slot_hash(id) & t->mask;; i = (i + 1) & t->mask)
+        if (!t->slots[i].degree || t->slots[i].id == id)
+            return &t->slots[i];
+}
+
+static int grow(dskypoly_tracker* t) {
+    size_t count = (t->mask + 1) * 2;
+    track_slot* old = t->slots;
+    size_t old_count = t->mask + 1;
+
+    t->slots = calloc(count, sizeof(track_slot));
+    if (!t->slots) {
+        t->slots = old;
+        errno = ENOMEM;
+        return -1;
+    }
+    t->mask = count - 1;
+    for (size_t i = 0; i < old_count; i++)
+        if (old[i].degree)
+            *find_slot(t, old[i].id) = old[i];
+    free(old);
+    return 0;
+}
+
+dskypoly_tracker* dskypoly_tracker_create(double max_drift, double tol) {
+    dskypoly_tracker* t = malloc(sizeof(*t));
+    if (!t)
+        return NULL;
+    t->slots = calloc(TRACK_MIN_SLOTS, sizeof(track_slot));
+    if (!t->slots) {
+        free(t);
+        return NULL;
+    }
+    t->mask = TRACK_MIN_SLOTS - 1;
+    t->used = 0;
+    t->max_drift = max_drift > 0.0 ? max_drift : DSKYPOLY_TRACK_DRIFT;
+    t->tol = tol > 0.0 ? tol : DSKYPOLY_TRACK_TOL;
+    return t;
+}
+
+void dskypoly_tracker_destroy(dskypoly_tracker* t) {
+    if (!t)
+        return;
+    for (size_t i = 0; i <= t->mask; i++)
+        free(t->slots[i].state);
+    free(t->slots);
+    free(t);
+}
+
+size_t dskypoly_tracker_streams(const dskypoly_tracker* t) {
+    return t->used;
+}
+
+void dskypoly_tracker_forget(dskypoly_tracker* t, uint64_t stream) {
+    track_slot* s = find_slot(t, stream);
+    if (!s->degree)
+        return;
+    free(s->state);
+    s->degree = 0;
+    s->state = NULL;
+    t->used--;
+
+    // Backward-shift deletion: pull later members of the probe run into
+    // the hole so lookups never need tombstones
+    size_t hole = (size_t)(s - t->slots);
+    for (size_t i = (hole + 1) & t->mask; t->slots[i].degree; i = (i + 1) & t->mask) {
+        size_t home = slot_hash(t->slots[i].id) & t->mask;
+        if (((i - home) & t->mask) >= ((i - hole) & t->mask)) {
+            t->slots[hole] = t->slots[i];
+            t->slots[i].degree = 0;
+            t->slots[i].state = NULL;
+            hole = i;
+        }
+    }
+}
+
+// The same kernels the bulk driver picks, so a cold update returns the
+// roots dskypoly_solve would, in the same order
+static int solve_cold(const double* c, int degree, double* re, double* im) {
+    switch (degree) {
+    case 1:
+        re[0] = -c[1] / c[0];
+        im[0] = 0.0;
+        return 1;
+    case 2:
+        solve_poly_2(c[0], c[1], c[2], &re[0], &im[0], &re[1], &im[1]);
+        return 2;
+    case 3:
+        return solve_poly_3(c[0], c[1], c[2], c[3], re, im);
+    case 4:
+        return solve_poly_4_production(c[0], c[1], c[2], c[3], c[4], re, im);
+    case 5:
+        if (solve_poly_5_special_r(c[0], c[1], c[2], c[3], c[4], c[5], re, im, NULL) == 5)
+            return 5;
+        // fall through
+    default:
+        solve_poly_n_aberth(c, degree, re, im);
+        return degree;          // unconverged roots are still the best guesses
+    }
+}
+
+// First-order move of every old root onto the new coefficients, then
+// Newton until each step is below tol (1 + |z|). Returns the most steps
+// any root took, or -1 when the roots have to be solved from scratch.
+static int track_warm(const dskypoly_tracker* t, const double* old, const double* c,
+                      int degree, double* re, double* im) {
+    double scale = 0.0, drift = 0.0;
+    for (int k = 0; k <= degree; k++) {
+        double m = fabs(old[k]);
+        double d = fabs(c[k] - old[k]);
+        if (m > scale) scale = m;
+        if (!(d <= drift)) drift = d;                 // NaN forces a cold solve
+    }
+    if (!(drift <= t->max_drift * scale))
+        return -1;
+
+    double radius[DSKYPOLY_TRACK_MAX_DEGREE];
+    int most = 0;
+    for (int j = 0; j < degree; j++) {
+        // dp(z) and p'(z) of the old polynomial by Horner, complex
+        // arithmetic on split parts
+        double x = re[j], y = im[j];
+        double dr = c[0] - old[0], di = 0.0;
+        double pr = old[0], pi = 0.0, qr = 0.0, qi = 0.0;
+        for (int k = 1; k <= degree; k++) {
+            double tr = qr * x - qi * y + pr, ti = qr * y + qi * x + pi;
+            qr = tr; qi = ti;
+            tr = pr * x - pi * y + old[k]; ti = pr * y + pi * x;
+            pr = tr; pi = ti;
+            tr = dr * x - di * y + (c[k] - old[k]); ti = dr * y + di * x;
+            dr = tr; di = ti;
+        }
+        double q2 = qr * qr + qi * qi;
+        if (!(q2 > 0.0))
+            return -1;
+        double inv = 1.0 / q2;
+        x -= (dr * qr + di * qi) * inv;
+        y -= (di * qr - dr * qi) * inv;
+
+        // Newton on the new polynomial; the last step also sizes the disk
+        // n |p / p'| that the overlap test below uses
+        double step2 = INFINITY, lim = 0.0;
+        int s = 0;
+        while (!(step2 <= lim * lim)) {
+            if (s == DSKYPOLY_TRACK_STEPS)
+                return -1;
+            pr = c[0]; pi = 0.0; qr = 0.0; qi = 0.0;
+            for (int k = 1; k <= degree; k++) {
+                double tr = qr * x - qi * y + pr, ti = qr * y + qi * x + pi;
+                qr = tr; qi = ti;
+                tr = pr * x - pi * y + c[k]; ti = pr * y + pi * x;
+                pr = tr; pi = ti;
+            }
+            q2 = qr * qr + qi * qi;
+            if (!(q2 > 0.0))
+                return -1;
+            inv = 1.0 / q2;
+            double sr = (pr * qr + pi * qi) * inv, si = (pi * qr - pr * qi) * inv;
+            x -= sr;
+            y -= si;
+            step2 = sr * sr + si * si;
+            lim = t->tol * (1.0 + sqrt(x * x + y * y));
+            s++;
+        }
+        re[j] = x;
+        im[j] = y;
+        radius[j] = degree * sqrt(step2) + lim;
+        if (s > most)
+            most = s;
+    }
+
+    // Two roots that settled in one disk chased the same true root
+    for (int j = 0; j < degree; j++)
+        for (int k = j + 1; k < degree; k++) {
+            double dx = re[j] - re[k], dy = im[j] - im[k], r = radius[j] + radius[k];
+            if (dx * dx + dy * dy <= r * r)
+                return -1;
+        }
+    return most;
+}
+
+int dskypoly_tracker_update(dskypoly_tracker* t, uint64_t stream, const double* coeffs,
+                            int degree, double* re, double* im, int* steps) {
+    if (degree < 1 || degree > DSKYPOLY_TRACK_MAX_DEGREE) {
+        errno = EINVAL;
+        return -1;
+    }
+    if (steps)
+        *steps = -1;
+    if (coeffs[0] == 0.0) {
+        // Nothing to track through a vanishing leading coefficient
+        dskypoly_tracker_forget(t, stream);
+        return 0;
+    }
+
+    track_slot* s = find_slot(t, stream);
+    if (s->degree == degree) {
+        double* old = s->state;
+        memcpy(re, old + degree + 1, degree * sizeof(double));
+        memcpy(im, old + 2 * degree + 1, degree * sizeof(double));
+        int taken = track_warm(t, old, coeffs, degree, re, im);
+        if (taken >= 0) {
+            if (steps)
+                *steps = taken;
+            memcpy(old, coeffs, (degree + 1) * sizeof(double));
+            memcpy(old + degree + 1, re, degree * sizeof(double));
+            memcpy(old + 2 * degree + 1, im, degree * sizeof(double));
+            return degree;
+        }
+    }
+
+    int n = solve_cold(coeffs, degree, re, im);
+
+    // Remember the stream, growing the table before it passes half full.
+    // Out of memory leaves the roots good but the stream untracked.
+    if (s->degree != degree) {
+        double* state = realloc(s->state, (3 * degree + 1) * sizeof(double));
+        if (!state) {
+            dskypoly_tracker_forget(t, stream);
+            errno = ENOMEM;
+            return -1;
+        }
+        if (!s->degree) {
+            if (2 * (t->used + 1) > t->mask + 1 && grow(t) < 0) {
+                free(state);
+                return -1;
+            }
+            s = find_slot(t, stream);
+            s->id = stream;
+            t->used++;
+        }
+        s->state = state;
+        s->degree = degree;
+    }
+    memcpy(s->state, coeffs, (degree + 1) * sizeof(double));
+    memcpy(s->state + degree + 1, re, degree * sizeof(double));
+    memcpy(s->state + 2 * degree + 1, im, degree * sizeof(double));
+    return n;
+}
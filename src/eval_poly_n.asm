@@ -0,0 +1,446 @@
+;**************************************************************************
+; eval_poly_n.asm
+; Polynomial evaluation over arrays of points: p(x) and p'(x) in one pass
+; Packed SSE2 / AVX2 kernels; the public eval_poly_n and
+; eval_poly_n_complex symbols live in dskypoly_dispatch.c.
+;
+; C prototypes:
+;   void eval_poly_n_<isa>(const double* coeffs, int n,
+;                          const double* x, size_t m,
+;                          double* p, double* dp);
+;   void eval_poly_n_complex_<isa>(const double* coeffs, int n,
+;                                  const double* xr, const double* xi, size_t m,
+;                                  double* pr, double* pi,
+;                                  double* dr, double* di);
+;
+; coeffs[0] x^n + ... + coeffs[n] at every point, by the shared Horner
+; recurrence
+;   p' <- p' x + p,   p <- p x + a_k          (k = 1..n)
+; so the derivative costs one multiply-add per coefficient and no second
+; pass. Points are independent, so instead of reshaping one polynomial for
+; ILP (Estrin) the kernels keep several points' chains in flight: the real
+; kernels run 2 registers of points with p and p' each (4 chains), the
+; complex ones 4 chains per register (re/im of p and p'). dp (dr/di) may
+; be NULL to skip storing the derivative. No FMA contraction, so every
+; lane rounds exactly like the scalar tail and like the other ISA.
+;
+; Each a_k is broadcast straight from coeffs[] as the Horner loop reaches
+; it (vbroadcastsd, or movsd + unpcklpd on SSE2), so the frame is the same
+; size for every n and any degree the int can hold is evaluated.
+;**************************************************************************
+
+section .text
+    global eval_poly_n_sse2
+    global eval_poly_n_avx2
+    global eval_poly_n_complex_sse2
+    global eval_poly_n_complex_avx2
+
+; Both real kernels, arguments (System V AMD64):
+; rdi = coeffs[], esi = n, rdx = x[], rcx = m, r8 = p[], r9 = dp[] (or NULL)
+;
+; Shared register plan:
+; r10 = n, r11 = coeffs[], rax = byte offset of the current point,
+; rcx = points remaining, rsi = coefficient walk, rdi = coefficients left
+; in the Horner loop
+
+;--------------------------------------------------------------------------
+; SSE2 real kernel: 4 points per iteration
+;--------------------------------------------------------------------------
+eval_poly_n_sse2:
+    push rbp
+    mov rbp, rsp
+    movsxd r10, esi                ; n
+    test r10, r10
+    js .done
+
+    mov r11, rdi
+    xor eax, eax                   ; offset = 0
+
+    ; The AVX2 kernel finishes its ragged tail here with the same frame
+.resume:
+.quad_loop:
+    cmp rcx, 4
+    jb .pair
+
+    movupd xmm0, [rdx+rax]         ; x, points 0-1
+    movupd xmm1, [rdx+rax+16]      ; x, points 2-3
+    movsd xmm2, [r11]              ; p = a_0
+    unpcklpd xmm2, xmm2
+    movapd xmm3, xmm2
+    xorpd xmm4, xmm4               ; p' = 0
+    xorpd xmm5, xmm5
+    lea rsi, [r11+8]
+    mov rdi, r10
+    test rdi, rdi
+    jz .quad_store
+.quad_horner:
+    mulpd xmm4, xmm0
+    mulpd xmm5, xmm1
+    addpd xmm4, xmm2               ; p' = p' x + p
+    addpd xmm5, xmm3
+    movsd xmm6, [rsi]              ; a_k
+    unpcklpd xmm6, xmm6
+    mulpd xmm2, xmm0
+    mulpd xmm3, xmm1
+    addpd xmm2, xmm6               ; p = p x + a_k
+    addpd xmm3, xmm6
+    add rsi, 8
+    dec rdi
+    jnz .quad_horner
+.quad_store:
+    movupd [r8+rax], xmm2
+    movupd [r8+rax+16], xmm3
+    test r9, r9
+    jz .quad_next
+    movupd [r9+rax], xmm4
+    movupd [r9+rax+16], xmm5
+.quad_next:
+    add rax, 32
+    sub rcx, 4
+    jmp .quad_loop
+
+.pair:
+    ; === 2-3 points left: one register pair ===
+    cmp rcx, 2
+    jb .single
+    movupd xmm0, [rdx+rax]
+    movsd xmm2, [r11]
+    unpcklpd xmm2, xmm2
+    xorpd xmm4, xmm4
+    lea rsi, [r11+8]
+    mov rdi, r10
+    test rdi, rdi
+    jz .pair_store
+.pair_horner:
+    movsd xmm6, [rsi]
+    unpcklpd xmm6, xmm6
+    mulpd xmm4, xmm0
+    addpd xmm4, xmm2
+    mulpd xmm2, xmm0
+    addpd xmm2, xmm6
+    add rsi, 8
+    dec rdi
+    jnz .pair_horner
+.pair_store:
+    movupd [r8+rax], xmm2
+    test r9, r9
+    jz .pair_next
+    movupd [r9+rax], xmm4
+.pair_next:
+    add rax, 16
+    sub rcx, 2
+
+.single:
+    ; === Last odd point: same recurrence on the low lane ===
+    test rcx, rcx
+    jz .done
+    movsd xmm0, [rdx+rax]
+    movsd xmm2, [r11]
+    xorpd xmm4, xmm4
+    lea rsi, [r11+8]
+    mov rdi, r10
+    test rdi, rdi
+    jz .single_store
+.single_horner:
+    mulsd xmm4, xmm0
+    addsd xmm4, xmm2
+    mulsd xmm2, xmm0
+    addsd xmm2, [rsi]
+    add rsi, 8
+    dec rdi
+    jnz .single_horner
+.single_store:
+    movsd [r8+rax], xmm2
+    test r9, r9
+    jz .done
+    movsd [r9+rax], xmm4
+
+.done:
+    leave
+    ret
+
+;--------------------------------------------------------------------------
+; AVX2 real kernel: 8 points per iteration, tail through the SSE2 code
+;--------------------------------------------------------------------------
+eval_poly_n_avx2:
+    push rbp
+    mov rbp, rsp
+    movsxd r10, esi
+    test r10, r10
+    js .done
+
+    mov r11, rdi
+    xor eax, eax
+
+.oct_loop:
+    cmp rcx, 8
+    jb .tail
+
+    vmovupd ymm0, [rdx+rax]        ; x, points 0-3
+    vmovupd ymm1, [rdx+rax+32]     ; x, points 4-7
+    vbroadcastsd ymm2, [r11]       ; p = a_0
+    vmovapd ymm3, ymm2
+    vxorpd ymm4, ymm4, ymm4        ; p' = 0
+    vxorpd ymm5, ymm5, ymm5
+    lea rsi, [r11+8]
+    mov rdi, r10
+    test rdi, rdi
+    jz .oct_store
+.oct_horner:
+    vbroadcastsd ymm6, [rsi]       ; a_k
+    vmulpd ymm4, ymm4, ymm0
+    vmulpd ymm5, ymm5, ymm1
+    vaddpd ymm4, ymm4, ymm2        ; p' = p' x + p
+    vaddpd ymm5, ymm5, ymm3
+    vmulpd ymm2, ymm2, ymm0
+    vmulpd ymm3, ymm3, ymm1
+    vaddpd ymm2, ymm2, ymm6        ; p = p x + a_k
+    vaddpd ymm3, ymm3, ymm6
+    add rsi, 8
+    dec rdi
+    jnz .oct_horner
+.oct_store:
+    vmovupd [r8+rax], ymm2
+    vmovupd [r8+rax+32], ymm3
+    test r9, r9
+    jz .oct_next
+    vmovupd [r9+rax], ymm4
+    vmovupd [r9+rax+32], ymm5
+.oct_next:
+    add rax, 64
+    sub rcx, 8
+    jmp .oct_loop
+
+.tail:
+    vzeroupper
+    jmp eval_poly_n_sse2.resume
+
+.done:
+    leave
+    ret
+
+; Both complex kernels, arguments (System V AMD64):
+; rdi = coeffs[], esi = n, rdx = xr[], rcx = xi[], r8 = m, r9 = pr[],
+; [rbp+16] = pi[], [rbp+24] = dr[] (or NULL), [rbp+32] = di[]
+;
+; Shared register plan:
+; rbx = pi[], r12 = dr[], r13 = di[], r10 = n, r11 = coeffs[],
+; rax = byte offset, r8 = points remaining, rsi / rdi as in the real kernels
+; Per coefficient, with z = x + iy:
+;   p' <- p' z + p:   dr' = dr x - di y + pr,   di' = di x + dr y + pi
+;   p  <- p z + a_k:  pr' = pr x - pi y + a_k,  pi' = pi x + pr y
+
+;--------------------------------------------------------------------------
+; SSE2 complex kernel: 2 points per iteration
+;--------------------------------------------------------------------------
+eval_poly_n_complex_sse2:
+    push rbp
+    mov rbp, rsp
+    push rbx
+    push r12
+    push r13
+    mov rbx, [rbp+16]              ; pi[]
+    mov r12, [rbp+24]              ; dr[]
+    mov r13, [rbp+32]              ; di[]
+    movsxd r10, esi
+    test r10, r10
+    js .done
+
+    mov r11, rdi
+    xor eax, eax
+
+.resume:
+.pair_loop:
+    cmp r8, 2
+    jb .single
+
+    movupd xmm0, [rdx+rax]         ; x
+    movupd xmm1, [rcx+rax]         ; y
+    movsd xmm2, [r11]              ; pr = a_0
+    unpcklpd xmm2, xmm2
+    xorpd xmm3, xmm3               ; pi
+    xorpd xmm4, xmm4               ; dr
+    xorpd xmm5, xmm5               ; di
+    lea rsi, [r11+8]
+    mov rdi, r10
+    test rdi, rdi
+    jz .pair_store
+.pair_horner:
+    ; === p' = p' z + p ===
+    movapd xmm6, xmm4
+    mulpd xmm6, xmm0               ; dr x
+    movapd xmm7, xmm5
+    mulpd xmm7, xmm1               ; di y
+    subpd xmm6, xmm7
+    addpd xmm6, xmm2               ; dr'
+    mulpd xmm4, xmm1               ; dr y
+    mulpd xmm5, xmm0               ; di x
+    addpd xmm5, xmm4
+    addpd xmm5, xmm3               ; di'
+    movapd xmm4, xmm6
+
+    ; === p = p z + a_k ===
+    movsd xmm8, [rsi]              ; a_k
+    unpcklpd xmm8, xmm8
+    movapd xmm6, xmm2
+    mulpd xmm6, xmm0               ; pr x
+    movapd xmm7, xmm3
+    mulpd xmm7, xmm1               ; pi y
+    subpd xmm6, xmm7
+    addpd xmm6, xmm8               ; pr'
+    mulpd xmm2, xmm1               ; pr y
+    mulpd xmm3, xmm0               ; pi x
+    addpd xmm3, xmm2               ; pi'
+    movapd xmm2, xmm6
+
+    add rsi, 8
+    dec rdi
+    jnz .pair_horner
+.pair_store:
+    movupd [r9+rax], xmm2
+    movupd [rbx+rax], xmm3
+    test r12, r12
+    jz .pair_next
+    movupd [r12+rax], xmm4
+    movupd [r13+rax], xmm5
+.pair_next:
+    add rax, 16
+    sub r8, 2
+    jmp .pair_loop
+
+.single:
+    test r8, r8
+    jz .done
+    movsd xmm0, [rdx+rax]
+    movsd xmm1, [rcx+rax]
+    movsd xmm2, [r11]
+    xorpd xmm3, xmm3
+    xorpd xmm4, xmm4
+    xorpd xmm5, xmm5
+    lea rsi, [r11+8]
+    mov rdi, r10
+    test rdi, rdi
+    jz .single_store
+.single_horner:
+    movapd xmm6, xmm4
+    mulsd xmm6, xmm0
+    movapd xmm7, xmm5
+    mulsd xmm7, xmm1
+    subsd xmm6, xmm7
+    addsd xmm6, xmm2
+    mulsd xmm4, xmm1
+    mulsd xmm5, xmm0
+    addsd xmm5, xmm4
+    addsd xmm5, xmm3
+    movapd xmm4, xmm6
+
+    movapd xmm6, xmm2
+    mulsd xmm6, xmm0
+    movapd xmm7, xmm3
+    mulsd xmm7, xmm1
+    subsd xmm6, xmm7
+    addsd xmm6, [rsi]
+    mulsd xmm2, xmm1
+    mulsd xmm3, xmm0
+    addsd xmm3, xmm2
+    movapd xmm2, xmm6
+
+    add rsi, 8
+    dec rdi
+    jnz .single_horner
+.single_store:
+    movsd [r9+rax], xmm2
+    movsd [rbx+rax], xmm3
+    test r12, r12
+    jz .done
+    movsd [r12+rax], xmm4
+    movsd [r13+rax], xmm5
+
+.done:
+    lea rsp, [rbp-24]
+    pop r13
+    pop r12
+    pop rbx
+    pop rbp
+    ret
+
+;--------------------------------------------------------------------------
+; AVX2 complex kernel: 4 points per iteration, tail through the SSE2 code
+;--------------------------------------------------------------------------
+eval_poly_n_complex_avx2:
+    push rbp
+    mov rbp, rsp
+    push rbx
+    push r12
+    push r13
+    mov rbx, [rbp+16]
+    mov r12, [rbp+24]
+    mov r13, [rbp+32]
+    movsxd r10, esi
+    test r10, r10
+    js .done
+
+    mov r11, rdi
+    xor eax, eax
+
+.quad_loop:
+    cmp r8, 4
+    jb .tail
+
+    vmovupd ymm0, [rdx+rax]        ; x
+    vmovupd ymm1, [rcx+rax]        ; y
+    vbroadcastsd ymm2, [r11]       ; pr = a_0
+    vxorpd ymm3, ymm3, ymm3        ; pi
+    vxorpd ymm4, ymm4, ymm4        ; dr
+    vxorpd ymm5, ymm5, ymm5        ; di
+    lea rsi, [r11+8]
+    mov rdi, r10
+    test rdi, rdi
+    jz .quad_store
+.quad_horner:
+    vmulpd ymm6, ymm4, ymm0        ; dr x
+    vmulpd ymm7, ymm5, ymm1        ; di y
+    vsubpd ymm6, ymm6, ymm7
+    vaddpd ymm6, ymm6, ymm2        ; dr'
+    vmulpd ymm4, ymm4, ymm1        ; dr y
+    vmulpd ymm5, ymm5, ymm0        ; di x
+    vaddpd ymm5, ymm5, ymm4
+    vaddpd ymm5, ymm5, ymm3        ; di'
+    vmovapd ymm4, ymm6
+
+    vbroadcastsd ymm8, [rsi]       ; a_k
+    vmulpd ymm6, ymm2, ymm0        ; pr x
+    vmulpd ymm7, ymm3, ymm1        ; pi y
+    vsubpd ymm6, ymm6, ymm7
+    vaddpd ymm6, ymm6, ymm8        ; pr'
+    vmulpd ymm2, ymm2, ymm1        ; pr y
+    vmulpd ymm3, ymm3, ymm0        ; pi x
+    vaddpd ymm3, ymm3, ymm2        ; pi'
+    vmovapd ymm2, ymm6
+
+    add rsi, 8
+    dec rdi
+    jnz .quad_horner
+.quad_store:
+    vmovupd [r9+rax], ymm2
+    vmovupd [rbx+rax], ymm3
+    test r12, r12
+    jz .quad_next
+    vmovupd [r12+rax], ymm4
+    vmovupd [r13+rax], ymm5
+.quad_next:
+    add rax, 32
+    sub r8, 4
+    jmp .quad_loop
+
+.tail:
+    vzeroupper
+    jmp eval_poly_n_complex_sse2.resume
+
+.done:
+    lea rsp, [rbp-24]
+    pop r13
+    pop r12
+    pop rbx
+    pop rbp
+    ret
@@ -1,32 +1,27 @@
 #include <stdio.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
+#include <errno.h>
 #include <time.h>
 #include <math.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
-// External assembly function
-extern void solve_poly_2(double a, double b, double c,
-                         double* r1_real, double* r1_imag,
-                         double* r2_real, double* r2_imag);
+#include "dskypoly.h"
 
 // Persistent state
 static double a = 0, b = 0, c = 0;
 static double r1_real = 0, r1_imag = 0;
 static double r2_real = 0, r2_imag = 0;
 
-// Logging function
-void log_event(const char* msg) {
-    FILE *log = fopen("DSKYpoly.log", "a");
-    if (!log) {
-        perror("Log file error");
+// Logging function: queued to the log ring, echoed while the level is on
+void log_event(int level, const char* msg) {
+    if (!dskypoly_log_enabled(level))
         return;
-    }
-
-    time_t now = time(NULL);
-    struct tm *t = localtime(&now);
-    fprintf(log, "[%04d-%02d-%02d %02d:%02d:%02d] %s\n",
-        t->tm_year + 1900, t->tm_mon + 1, t->tm_mday,
-        t->tm_hour, t->tm_min, t->tm_sec, msg);
-    fclose(log);
+    dskypoly_log(level, msg);
     printf("DSKYpoly: %s\n", msg);
 }
 
@@ -38,8 +33,434 @@ void print_root(const char* label, double real, double imag) {
         printf("%s: %.4f %c %.4fi\n", label, real, (imag < 0 ? '-' : '+'), fabs(imag));
 }
 
-int main() {
+// --pack: whitespace-separated coefficients on stdin, degree+1 per polynomial
+static int pack_text(int degree, const char* out_path) {
+    if (degree < 2 || degree > DSKYPOLY_MAX_DEGREE) {
+        fprintf(stderr, "DSKYpoly: --pack degree must be 2..%d\n", DSKYPOLY_MAX_DEGREE);
+        return 2;
+    }
+    size_t cap = 1024, n = 0;
+    double* coeffs = malloc(cap * sizeof(double));
+    while (coeffs && scanf("%lf", &coeffs[n]) == 1) {
+        if (++n == cap) {
+            double* grown = realloc(coeffs, (cap *= 2) * sizeof(double));
+            if (!grown)
+                free(coeffs);
+            coeffs = grown;
+        }
+    }
+    if (!coeffs) {
+        errno = ENOMEM;
+        perror("DSKYpoly: --pack");
+        return 1;
+    }
+    if (n % (degree + 1) != 0) {
+        fprintf(stderr, "DSKYpoly: expected a multiple of %d coefficients\n", degree + 1);
+        free(coeffs);
+        return 1;
+    }
+    int rc = dskypoly_file_write_coeffs(out_path, degree, n / (degree + 1), coeffs);
+    if (rc != 0)
+        perror(out_path);
+    free(coeffs);
+    return rc != 0;
+}
+
+// --dump: one line of roots per polynomial from a root file
+static int dump_roots(const char* path) {
+    int fd = open(path, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        perror(path);
+        if (fd >= 0)
+            close(fd);
+        return 1;
+    }
+    dskypoly_file_header h;
+    if ((size_t)st.st_size < sizeof(h)) {
+        fprintf(stderr, "DSKYpoly: %s is not a root file\n", path);
+        close(fd);
+        return 1;
+    }
+    const char* map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        perror(path);
+        return 1;
+    }
+
+    memcpy(&h, map, sizeof(h));
+    if (memcmp(h.magic, DSKYPOLY_ROOT_MAGIC, 8) != 0
+        || h.degree < 2 || h.degree > DSKYPOLY_MAX_DEGREE || h.planes != 2 * h.degree
+        || !dskypoly_file_fits(&h, st.st_size)) {
+        fprintf(stderr, "DSKYpoly: %s is not a root file\n", path);
+        munmap((void*)map, st.st_size);
+        return 1;
+    }
+    const double* r = (const double*)(map + sizeof(h));
+    for (size_t i = 0; i < h.count; i++) {
+        for (uint32_t k = 0; k < h.degree; k++)
+            printf("%s%.9g %+.9gi", k ? "  " : "",
+                   r[k * h.stride + i], r[(h.degree + k) * h.stride + i]);
+        printf("\n");
+    }
+    munmap((void*)map, st.st_size);
+    return 0;
+}
+
+// === --batch: VERB/NOUN programs from stdin, no prompts ===
+// stdin is read in 1 MiB blocks and tokenised in place; numbers go through
+// a hand-written parser with strtod only as the fallback for inputs the
+// exact fast path cannot take. Output is fully buffered.
+
+#define BATCH_BUF (1 << 20)
+
+typedef struct {
+    char* buf;
+    size_t pos, len;
+    int eof;
+    int fd;
+} batch_reader;
+
+// Keep the unread tail, top the block up from the reader's descriptor
+static int batch_refill(batch_reader* r) {
+    memmove(r->buf, r->buf + r->pos, r->len - r->pos);
+    r->len -= r->pos;
+    r->pos = 0;
+    for (;;) {
+        ssize_t got = read(r->fd, r->buf + r->len, BATCH_BUF - 1 - r->len);
+        if (got > 0) {
+            r->len += got;
+            return 1;
+        }
+        if (got < 0 && errno == EINTR)
+            continue;
+        r->eof = 1;
+        return 0;
+    }
+}
+
+static inline int is_blank(char ch) {
+    return ch == ' ' || ch == '\n' || ch == '\t' || ch == '\r' || ch == '\f' || ch == '\v';
+}
+
+// Next whitespace-delimited token, NUL-terminated in place; NULL at end of input
+static char* batch_token(batch_reader* r) {
+    for (;;) {
+        while (r->pos < r->len && is_blank(r->buf[r->pos]))
+            r->pos++;
+        if (r->pos == r->len) {
+            if (r->eof || !batch_refill(r))
+                return NULL;
+            continue;
+        }
+        size_t end = r->pos;
+        while (end < r->len && !is_blank(r->buf[end]))
+            end++;
+        // A token cut by the block edge: pull in the rest, unless it
+        // already fills the whole block
+        if (end == r->len && !r->eof && (r->pos > 0 || r->len < BATCH_BUF - 1)) {
+            batch_refill(r);
+            continue;
+        }
+        char* tok = r->buf + r->pos;
+        r->buf[end] = '\0';
+        r->pos = end < r->len ? end + 1 : end;
+        return tok;
+    }
+}
+
+static const double exact_pow10[23] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// Decimal to double. Up to 15 significant digits with |exponent| <= 22 is
+// one exact integer conversion and one correctly rounded scale (Clinger's
+// fast path); anything else, including inf/nan, goes to strtod.
+static int parse_double(const char* s, double* out) {
+    const char* p = s;
+    int neg = 0;
+    if (*p == '+' || *p == '-')
+        neg = *p++ == '-';
+
+    uint64_t mant = 0;
+    int digits = 0, exp10 = 0, seen = 0;
+    for (; *p >= '0' && *p <= '9'; p++, seen = 1) {
+        if (digits < 19) {
+            mant = mant * 10 + (*p - '0');
+            digits += mant != 0;
+        } else {
+            exp10++;
+        }
+    }
+    if (*p == '.') {
+        for (p++; *p >= '0' && *p <= '9'; p++, seen = 1) {
+            if (digits < 19) {
+                mant = mant * 10 + (*p - '0');
+                digits += mant != 0;
+                exp10--;
+            }
+        }
+    }
+    if (seen && (*p == 'e' || *p == 'E')) {
+        const char* q = p + 1;
+        int eneg = 0, e = 0;
+        if (*q == '+' || *q == '-')
+            eneg = *q++ == '-';
+        if (*q >= '0' && *q <= '9') {
+            for (; *q >= '0' && *q <= '9'; q++)
+                if (e < 10000)
+                    e = e * 10 + (*q - '0');
+            exp10 += eneg ? -e : e;
+            p = q;
+        }
+    }
+
+    if (seen && *p == '\0' && digits <= 15 && exp10 >= -22 && exp10 <= 22) {
+        double v = (double)mant;
+        v = exp10 < 0 ? v / exact_pow10[-exp10] : v * exact_pow10[exp10];
+        *out = neg ? -v : v;
+        return 1;
+    }
+
+    char* end;
+    *out = strtod(s, &end);
+    return end != s && *end == '\0';
+}
+
+static int parse_int(const char* s, int* out) {
+    int v = 0, n = 0;
+    for (; *s >= '0' && *s <= '9' && n < 9; s++, n++)
+        v = v * 10 + (*s - '0');
+    *out = v;
+    return n > 0 && *s == '\0';
+}
+
+static int run_batch(void) {
+    static char out_buf[BATCH_BUF];
+    setvbuf(stdout, out_buf, _IOFBF, sizeof(out_buf));
+
+    batch_reader r = { .buf = malloc(BATCH_BUF), .fd = STDIN_FILENO };
+    if (!r.buf) {
+        perror("DSKYpoly: --batch");
+        return 1;
+    }
+
+    // A refill may move the block, so every token is parsed before the next
+    // one is fetched
+    unsigned long commands = 0;
+    int verb, noun, rc = 0;
+    char* tok;
+    while ((tok = batch_token(&r))) {
+        if (!parse_int(tok, &verb) || !(tok = batch_token(&r)) || !parse_int(tok, &noun)) {
+            fprintf(stderr, "DSKYpoly: bad VERB/NOUN after %lu commands\n", commands);
+            rc = 1;
+            break;
+        }
+        commands++;
+
+        if (verb == 10 && noun == 1) {
+            double* coeff[3] = { &a, &b, &c };
+            for (int k = 0; k < 3 && rc == 0; k++)
+                if (!(tok = batch_token(&r)) || !parse_double(tok, coeff[k]))
+                    rc = 1;
+            if (rc) {
+                fprintf(stderr, "DSKYpoly: bad coefficients for command %lu\n", commands);
+                break;
+            }
+        } else if (verb == 20 && noun == 1) {
+            solve_poly_2(a, b, c, &r1_real, &r1_imag, &r2_real, &r2_imag);
+        } else if (verb == 30 && noun == 1) {
+            print_root("Root 1", r1_real, r1_imag);
+            print_root("Root 2", r2_real, r2_imag);
+        } else if (verb == 99) {
+            break;
+        } else {
+            printf("Invalid VERB/NOUN combination.\n");
+        }
+    }
+
+    fflush(stdout);
+    char log_msg[128];
+    snprintf(log_msg, sizeof(log_msg), "Batch: %lu commands processed.", commands);
+    dskypoly_log(DSKYPOLY_LOG_INFO, log_msg);
+    free(r.buf);
+    return rc;
+}
+
+// === --degree: headless solve for schedulers, text in, text out ===
+// No banner, no prompts, no log ring: the first read is the input file.
+// degree+1 coefficients per polynomial, highest first, in any whitespace
+// layout; one line of `re im` pairs per polynomial out, at full precision.
+// Roots a polynomial does not have (all of them for a zero leading
+// coefficient) print as nan +nani, as in the root file format.
+// "-" names stdin or stdout.
+static int run_headless(int degree, const char* in_path, const char* out_path, int threads) {
+    if (degree < 2 || degree > DSKYPOLY_MAX_DEGREE) {
+        fprintf(stderr, "DSKYpoly: --degree must be 2..%d\n", DSKYPOLY_MAX_DEGREE);
+        return 2;
+    }
+    batch_reader r = { .buf = malloc(BATCH_BUF), .fd = STDIN_FILENO };
+    if (strcmp(in_path, "-") != 0 && (r.fd = open(in_path, O_RDONLY)) < 0) {
+        perror(in_path);
+        free(r.buf);
+        return 1;
+    }
+
+    size_t cap = 256, n = 0;
+    int k = 0, rc = 0;
+    dskypoly_poly* polys = malloc(cap * sizeof(*polys));
+    char* tok;
+    while (r.buf && polys && (tok = batch_token(&r))) {
+        if (k == 0) {
+            if (n == cap) {
+                dskypoly_poly* grown = realloc(polys, (cap *= 2) * sizeof(*polys));
+                if (!grown) {
+                    errno = ENOMEM;
+                    perror("DSKYpoly: --degree");
+                    rc = 1;
+                    break;
+                }
+                polys = grown;
+            }
+            polys[n].degree = degree;
+        }
+        if (!parse_double(tok, &polys[n].coeffs[k])) {
+            fprintf(stderr, "DSKYpoly: %s: bad coefficient '%s'\n", in_path, tok);
+            rc = 1;
+            break;
+        }
+        if (++k > degree) {
+            k = 0;
+            n++;
+        }
+    }
+    if (r.fd != STDIN_FILENO)
+        close(r.fd);
+    if (!r.buf || !polys) {
+        perror("DSKYpoly: --degree");
+        rc = 1;
+    } else if (rc == 0 && k != 0) {
+        fprintf(stderr, "DSKYpoly: %s: expected a multiple of %d coefficients\n",
+                in_path, degree + 1);
+        rc = 1;
+    }
+    free(r.buf);
+
+    double* re = rc ? NULL : malloc((n + 1) * DSKYPOLY_MAX_DEGREE * sizeof(double));
+    double* im = rc ? NULL : malloc((n + 1) * DSKYPOLY_MAX_DEGREE * sizeof(double));
+    int* nroots = rc ? NULL : malloc((n + 1) * sizeof(int));
+    FILE* out = NULL;
+    if (rc == 0 && (!re || !im || !nroots)) {
+        perror("DSKYpoly: --degree");
+        rc = 1;
+    } else if (rc == 0 && !(out = strcmp(out_path, "-") ? fopen(out_path, "w") : stdout)) {
+        perror(out_path);
+        rc = 1;
+    }
+    if (rc == 0) {
+        static char out_buf[BATCH_BUF];
+        setvbuf(out, out_buf, _IOFBF, sizeof(out_buf));
+        if (n)
+            dskypoly_solve(polys, n, re, im, nroots, threads);
+        for (size_t i = 0; i < n; i++) {
+            const double* zr = re + i * DSKYPOLY_MAX_DEGREE;
+            const double* zi = im + i * DSKYPOLY_MAX_DEGREE;
+            for (int j = 0; j < degree; j++) {
+                int have = j < nroots[i];
+                fprintf(out, "%s%.17g %+.17gi", j ? "  " : "",
+                        have ? zr[j] : NAN, have ? zi[j] : NAN);
+            }
+            fputc('\n', out);
+        }
+        if (fflush(out) != 0 || (out != stdout && fclose(out) != 0)) {
+            perror(out_path);
+            rc = 1;
+        }
+    }
+    free(re);
+    free(im);
+    free(nroots);
+    free(polys);
+    return rc;
+}
+
+int main(int argc, char** argv) {
     int verb, noun;
+
+    // === Non-interactive file modes ===
+    if (argc == 4 && strcmp(argv[1], "--solve-file") == 0) {
+        if (dskypoly_file_solve(argv[2], argv[3]) != 0) {
+            perror("DSKYpoly: --solve-file");
+            return 1;
+        }
+        return 0;
+    }
+    if (argc == 4 && strcmp(argv[1], "--pack") == 0)
+        return pack_text(atoi(argv[2]), argv[3]);
+    if (argc == 3 && strcmp(argv[1], "--dump") == 0)
+        return dump_roots(argv[2]);
+    if (argc == 2 && strcmp(argv[1], "--batch") == 0) {
+        // Per-command events would flood the ring at batch rates: one summary
+        if (dskypoly_log_open("DSKYpoly.log", DSKYPOLY_LOG_INFO) != 0)
+            perror("Log file error");
+        return run_batch();
+    }
+    if (argc > 1 && strcmp(argv[1], "--degree") == 0) {
+        // --degree N --in PATH --out PATH [--threads T], in any order
+        int degree = 0, threads = 0, ok = 1;
+        const char* in_path = NULL;
+        const char* out_path = NULL;
+        for (int i = 1; i < argc && ok; i += 2) {
+            ok = i + 1 < argc;
+            if (!ok)
+                break;
+            if (strcmp(argv[i], "--degree") == 0)
+                ok = parse_int(argv[i + 1], &degree);
+            else if (strcmp(argv[i], "--threads") == 0)
+                ok = parse_int(argv[i + 1], &threads);
+            else if (strcmp(argv[i], "--in") == 0)
+                in_path = argv[i + 1];
+            else if (strcmp(argv[i], "--out") == 0)
+                out_path = argv[i + 1];
+            else
+                ok = 0;
+        }
+        if (ok && in_path && out_path)
+            return run_headless(degree, in_path, out_path, threads);
+    }
+    if (argc >= 4 && strcmp(argv[1], "--stream") == 0) {
+        // --stream IN OUT [--text] [--threads T]
+        int text = 0, threads = 0, ok = 1;
+        for (int i = 4; i < argc && ok; i++) {
+            if (strcmp(argv[i], "--text") == 0)
+                text = 1;
+            else
+                ok = strcmp(argv[i], "--threads") == 0 && i + 1 < argc
+                  && parse_int(argv[++i], &threads);
+        }
+        if (ok) {
+            if (dskypoly_file_stream(argv[2], argv[3], text, threads) != 0) {
+                perror("DSKYpoly: --stream");
+                return 1;
+            }
+            return 0;
+        }
+    }
+    if (argc > 1) {
+        fprintf(stderr, "usage: %s                               (DSKY interface)\n"
+                        "       %s --batch                       (VERB/NOUN program on stdin)\n"
+                        "       %s --pack <degree> <out.dsky>    (text on stdin)\n"
+                        "       %s --solve-file <in.dsky> <roots.dsky>\n"
+                        "       %s --dump <roots.dsky>\n"
+                        "       %s --stream <in.dsky> <out> [--text] [--threads <t>]\n"
+                        "       %s --degree <n> --in <coeffs.txt> --out <roots.txt> [--threads <t>]\n",
+                argv[0], argv[0], argv[0], argv[0], argv[0], argv[0], argv[0]);
+        return 2;
+    }
+    if (dskypoly_log_open("DSKYpoly.log", DSKYPOLY_LOG_DEBUG) != 0)
+        perror("Log file error");
     printf("=== DSKYpoly Interface ===\n");
 
     while (1) {
@@ -50,35 +471,35 @@ int main() {
 
         char log_msg[128];
         snprintf(log_msg, sizeof(log_msg), "VERB %02d / NOUN %02d entered.", verb, noun);
-        log_event(log_msg);
+        log_event(DSKYPOLY_LOG_INFO, log_msg);
 
         if (verb == 10 && noun == 1) {
             printf("Loading quadratic polynomial coefficients...\n");
-            log_event("Prompting for coefficients.");
+            log_event(DSKYPOLY_LOG_INFO, "Prompting for coefficients.");
             printf("Enter coefficient a: ");
             scanf("%lf", &a);
             printf("Enter coefficient b: ");
             scanf("%lf", &b);
             printf("Enter coefficient c: ");
             scanf("%lf", &c);
-            log_event("Coefficients loaded.");
+            log_event(DSKYPOLY_LOG_INFO, "Coefficients loaded.");
         } else if (verb == 20 && noun == 1) {
             printf("Solving quadratic polynomial...\n");
-            log_event("Calling solver.");
+            log_event(DSKYPOLY_LOG_DEBUG, "Calling solver.");
             solve_poly_2(a, b, c, &r1_real, &r1_imag, &r2_real, &r2_imag);
-            log_event("Solver completed.");
+            log_event(DSKYPOLY_LOG_DEBUG, "Solver completed.");
         } else if (verb == 30 && noun == 1) {
             printf("Displaying the roots:\n");
-            log_event("Displaying roots.");
+            log_event(DSKYPOLY_LOG_INFO, "Displaying roots.");
             print_root("Root 1", r1_real, r1_imag);
             print_root("Root 2", r2_real, r2_imag);
         } else if (verb == 99) {
             printf("Exiting DSKYpoly.\n");
-            log_event("Program exited.");
+            log_event(DSKYPOLY_LOG_INFO, "Program exited.");
             break;
         } else {
             printf("Invalid VERB/NOUN combination.\n");
-            log_event("Invalid command.");
+            log_event(DSKYPOLY_LOG_INFO, "Invalid command.");
         }
     }
 
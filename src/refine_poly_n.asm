@@ -0,0 +1,361 @@
+;**************************************************************************
+; refine_poly_n.asm
+; DSKYpoly: Root polishing with a-posteriori error bounds
+;
+; C prototype:
+;   int refine_poly_n(const double* coeffs, int n, double* re, double* im,
+;                     double* err, int steps, double tol);
+;
+; The closed-form paths (x87 quadratic, Cardano, Ferrari) return roots
+; that are only as good as their worst cancellation. This pass takes any
+; approximations z_k of the roots of coeffs[0] x^n + ... + coeffs[n] and
+; polishes them on the original polynomial, two roots per SSE2 lane pair:
+;
+;   z <- z - p(z) / p'(z)                    (at most `steps` times)
+;
+; with p, p' and the running rounding bounds e_p = 4nu sum |a_k| |z|^k,
+; e_d = 4nu sum k |a_k| |z|^(k-1) (u = 2^-53) from one Horner pass. Every
+; disk below contains a true root, so err[k] is the smaller radius:
+;
+;   n (|p| + e_p) / (|p'| - e_d)             (Newton inclusion, simple roots)
+;   ((|p| + e_p) / |a_0|)^(1/n)              (product of root distances)
+;
+; The second one is what keeps clustered roots such as (x-1)^4 honest,
+; where p' vanishes with p and Newton alone only crawls. A root stops as
+; soon as its Newton radius drops to tol (1 + |z|), when |p| is already at
+; rounding level, or when |p'| is lost in rounding (no safe step left).
+;
+; re/im are updated in place; err (if non-NULL) gets the n radii. Returns
+; the number of roots whose radius met tol (tol <= 0: none stop early and
+; only exact roots count), or 0 with nothing touched if n < 1 or
+; coeffs[0] == 0. The work area is carved from the stack, about 72 bytes
+; per degree, so n is capped at 1024 (DSKYPOLY_REFINE_MAX_DEGREE): above
+; it the call returns -1 with errno = EINVAL and nothing touched.
+;**************************************************************************
+
+section .rodata
+    align 16
+    pd_one       dq 1.0, 1.0
+    pd_mask_abs  dq 0x7FFFFFFFFFFFFFFF, 0x7FFFFFFFFFFFFFFF
+    const_zero   dq 0.0
+    const_one    dq 1.0
+    four_ulp     dq 4.440892098500626e-16  ; 4u, scaled by n for the bounds
+
+section .text
+    global refine_poly_n
+    extern pow
+    extern __errno_location
+
+; Arguments (System V AMD64):
+; rdi = coeffs[], esi = n, rdx = re[], rcx = im[], r8 = err[] (or NULL),
+; r9d = steps, xmm0 = tol
+;
+; Frame (rbp-relative, below the five saved registers):
+; [rbp-48]  re[]             [rbp-56]  im[]
+; [rbp-64]  err[] (or NULL)  [rbp-72]  tol
+; [rbp-80]  1/n              [rbp-88]  root index across pow calls
+; [rbp-96]  roots that met   [rbp-104] (|p| + e_p) plane
+; [rbp-112] padding plane    [rbp-120] tol (1 + |z|) of the current root
+;
+; Work area (rsp-relative, 16-byte aligned, npad = n rounded up to even):
+; rbx = coefficient table, n+1 entries of { a_k, a_k, |a_k|, |a_k| }
+; r13 = zr[npad], r14 = zi[npad], r15 = radius[npad], r12 = n
+refine_poly_n:
+    push rbp
+    mov rbp, rsp
+    push rbx
+    push r12
+    push r13
+    push r14
+    push r15
+    sub rsp, 88
+
+    mov [rbp-48], rdx
+    mov [rbp-56], rcx
+    mov [rbp-64], r8
+    movsd [rbp-72], xmm0
+    movsxd r12, esi
+    mov r11, rdi
+
+    ; === Reject degree < 1 and a vanishing leading coefficient ===
+    xor eax, eax
+    test r12, r12
+    jle .exit
+    cmp r12, 1024                  ; DSKYPOLY_REFINE_MAX_DEGREE
+    jg .too_high
+    movsd xmm0, [r11]
+    ucomisd xmm0, [rel const_zero]
+    je .exit
+
+    ; === Carve the work area out of the stack ===
+    lea rax, [r12+1]
+    and rax, -2                    ; npad
+    lea r8, [rax+rax*4]            ; 5 planes of npad
+    lea r10, [r12+1]
+    lea r8, [r8+r10*4]             ; plus the table, 4 doubles per entry
+    shl r8, 3
+    sub rsp, r8
+    and rsp, -16
+    mov rbx, rsp                   ; table[]
+    shl r10, 5
+    lea r13, [rbx+r10]             ; zr[]
+    lea r14, [r13+rax*8]           ; zi[]
+    lea r15, [r14+rax*8]           ; radius[]
+    lea r8, [r15+rax*8]
+    mov [rbp-104], r8              ; (|p| + e_p)[]
+    lea r8, [r8+rax*8]
+    mov [rbp-112], r8              ; padding[]
+
+    ; Broadcast a_k and |a_k| so the Horner loop adds straight from memory
+    movapd xmm1, [rel pd_mask_abs]
+    mov r10, rbx
+    xor ecx, ecx
+.table_loop:
+    movsd xmm0, [r11+rcx*8]
+    unpcklpd xmm0, xmm0
+    movapd [r10], xmm0
+    andpd xmm0, xmm1
+    movapd [r10+16], xmm0
+    add r10, 32
+    inc rcx
+    cmp rcx, r12
+    jbe .table_loop
+
+    ; Roots into the planes; the odd-degree padding lane is 0 and always done
+    mov rdx, [rbp-48]
+    mov rcx, [rbp-56]
+    mov r8, [rbp-112]
+    xor r10d, r10d
+.load_loop:
+    mov r11, [rdx+r10*8]
+    mov [r13+r10*8], r11
+    mov r11, [rcx+r10*8]
+    mov [r14+r10*8], r11
+    mov qword [r8+r10*8], 0
+    inc r10
+    cmp r10, r12
+    jb .load_loop
+    test r12, 1
+    jz .vector
+    mov qword [r13+r12*8], 0
+    mov qword [r14+r12*8], 0
+    mov qword [r8+r12*8], -1
+
+.vector:
+    ; === Pair registers ===
+    ; rsi = (|p| + e_p)[], rdi = padding[], r8 = npad bytes, r9 = pair offset
+    ; r10 = table walker, r11d = steps left, edx = steps per root
+    ; xmm12 = n, xmm14 = 4nu, xmm15 = tol (broadcast)
+    mov edx, r9d
+    xor eax, eax
+    test edx, edx
+    cmovs edx, eax                 ; steps < 0 counts as 0
+    mov rsi, [rbp-104]
+    mov rdi, [rbp-112]
+    lea r8, [r12+1]
+    and r8, -2
+    shl r8, 3
+    xor r9d, r9d
+    cvtsi2sd xmm12, r12
+    movapd xmm14, xmm12
+    mulsd xmm14, [rel four_ulp]
+    unpcklpd xmm12, xmm12
+    unpcklpd xmm14, xmm14
+    movsd xmm15, [rbp-72]
+    unpcklpd xmm15, xmm15
+
+.pair:
+    mov r11d, edx
+.step:
+    movapd xmm0, [r13+r9]          ; x
+    movapd xmm1, [r14+r9]          ; y
+    movapd xmm2, xmm0
+    mulpd xmm2, xmm0
+    movapd xmm3, xmm1
+    mulpd xmm3, xmm1
+    addpd xmm2, xmm3
+    sqrtpd xmm2, xmm2              ; r = |z|
+
+    ; === Horner: p, p' and both rounding sums in one pass ===
+    movapd xmm3, [rbx]             ; pr = a_0
+    xorpd xmm4, xmm4               ; pi
+    xorpd xmm5, xmm5               ; dr
+    xorpd xmm6, xmm6               ; di
+    movapd xmm7, [rbx+16]          ; s = |a_0|
+    xorpd xmm11, xmm11             ; s' (derivative of s in r)
+    lea r10, [rbx+32]
+    mov ecx, r12d
+.horner:
+    ; s' = s' r + s, s = s r + |a_k|
+    mulpd xmm11, xmm2
+    addpd xmm11, xmm7
+    mulpd xmm7, xmm2
+    addpd xmm7, [r10+16]
+    ; d = d z + p
+    movapd xmm8, xmm5
+    mulpd xmm8, xmm0
+    movapd xmm9, xmm6
+    mulpd xmm9, xmm1
+    subpd xmm8, xmm9
+    addpd xmm8, xmm3               ; dr'
+    mulpd xmm5, xmm1
+    mulpd xmm6, xmm0
+    addpd xmm6, xmm5
+    addpd xmm6, xmm4               ; di'
+    movapd xmm5, xmm8
+    ; p = p z + a_k
+    movapd xmm8, xmm3
+    mulpd xmm8, xmm0
+    movapd xmm9, xmm4
+    mulpd xmm9, xmm1
+    subpd xmm8, xmm9
+    addpd xmm8, [r10]              ; pr'
+    mulpd xmm3, xmm1
+    mulpd xmm4, xmm0
+    addpd xmm4, xmm3               ; pi'
+    movapd xmm3, xmm8
+    add r10, 32
+    dec ecx
+    jnz .horner
+
+    ; === Newton radius n (|p| + e_p) / max(|p'| - e_d, 0) ===
+    movapd xmm8, xmm3
+    mulpd xmm8, xmm3
+    movapd xmm9, xmm4
+    mulpd xmm9, xmm4
+    addpd xmm8, xmm9
+    sqrtpd xmm8, xmm8              ; |p|
+    movapd xmm9, xmm5
+    mulpd xmm9, xmm5
+    movapd xmm10, xmm6
+    mulpd xmm10, xmm6
+    addpd xmm9, xmm10              ; |p'|^2, kept for the step
+    movapd xmm10, xmm9
+    sqrtpd xmm10, xmm10            ; |p'|
+    mulpd xmm7, xmm14              ; e_p
+    mulpd xmm11, xmm14             ; e_d
+    movapd xmm13, xmm8
+    cmplepd xmm13, xmm7            ; done: |p| at rounding level
+    addpd xmm7, xmm8
+    movapd [rsi+r9], xmm7          ; |p| + e_p, for the product radius
+    mulpd xmm7, xmm12
+    subpd xmm10, xmm11
+    xorpd xmm11, xmm11
+    maxpd xmm10, xmm11
+    movapd xmm8, xmm10
+    cmpeqpd xmm8, xmm11
+    orpd xmm13, xmm8               ; done: p' lost in rounding
+    divpd xmm7, xmm10              ; radius (+inf without a safe p')
+    movapd [r15+r9], xmm7
+    addpd xmm2, [rel pd_one]
+    mulpd xmm2, xmm15              ; tol (1 + |z|)
+    cmplepd xmm7, xmm2
+    orpd xmm13, xmm7               ; done: radius met tol
+    orpd xmm13, [rdi+r9]           ; padding lane
+    test r11d, r11d
+    jz .pair_done
+    movmskpd eax, xmm13
+    cmp eax, 3
+    je .pair_done
+
+    ; === z -= p / p' on the lanes still going ===
+    movapd xmm8, xmm3
+    mulpd xmm8, xmm5
+    movapd xmm10, xmm4
+    mulpd xmm10, xmm6
+    addpd xmm8, xmm10              ; Re(p conj p')
+    mulpd xmm4, xmm5
+    mulpd xmm3, xmm6
+    subpd xmm4, xmm3               ; Im(p conj p')
+    divpd xmm8, xmm9
+    divpd xmm4, xmm9
+    movapd xmm10, xmm13
+    andnpd xmm10, xmm8
+    andnpd xmm13, xmm4
+    subpd xmm0, xmm10
+    subpd xmm1, xmm13
+    movapd [r13+r9], xmm0
+    movapd [r14+r9], xmm1
+    dec r11d
+    jmp .step
+
+.pair_done:
+    add r9, 16
+    cmp r9, r8
+    jb .pair
+
+    ; === Product radius where Newton's did not meet tol; count the roots ===
+    cvtsi2sd xmm1, r12
+    movsd xmm0, [rel const_one]
+    divsd xmm0, xmm1
+    movsd [rbp-80], xmm0
+    mov qword [rbp-96], 0
+    mov qword [rbp-88], 0
+.bound_loop:
+    mov rcx, [rbp-88]
+    movsd xmm0, [r13+rcx*8]
+    mulsd xmm0, xmm0
+    movsd xmm1, [r14+rcx*8]
+    mulsd xmm1, xmm1
+    addsd xmm0, xmm1
+    sqrtsd xmm0, xmm0
+    addsd xmm0, [rel const_one]
+    mulsd xmm0, [rbp-72]
+    movsd [rbp-120], xmm0          ; tol (1 + |z|)
+    ucomisd xmm0, [r15+rcx*8]
+    jae .met                       ; unordered (NaN) falls through
+    mov rax, [rbp-104]
+    movsd xmm0, [rax+rcx*8]
+    divsd xmm0, [rbx+16]           ; (|p| + e_p) / |a_0|
+    movsd xmm1, [rbp-80]
+    call pow wrt ..plt
+    mov rcx, [rbp-88]
+    movsd xmm1, [r15+rcx*8]
+    minsd xmm1, xmm0               ; a NaN Newton radius (0/0) yields pow's
+    movsd xmm0, xmm1
+    movsd [r15+rcx*8], xmm0
+    movsd xmm1, [rbp-120]
+    ucomisd xmm1, xmm0
+    jb .bound_next
+.met:
+    inc qword [rbp-96]
+.bound_next:
+    inc qword [rbp-88]
+    cmp [rbp-88], r12
+    jb .bound_loop
+
+    ; === Polished roots and radii back to the caller ===
+    mov rdx, [rbp-48]
+    mov rcx, [rbp-56]
+    mov r8, [rbp-64]
+    xor r10d, r10d
+.store_loop:
+    mov r11, [r13+r10*8]
+    mov [rdx+r10*8], r11
+    mov r11, [r14+r10*8]
+    mov [rcx+r10*8], r11
+    test r8, r8
+    jz .store_next
+    mov r11, [r15+r10*8]
+    mov [r8+r10*8], r11
+.store_next:
+    inc r10
+    cmp r10, r12
+    jb .store_loop
+    mov rax, [rbp-96]
+    jmp .exit
+
+.too_high:
+    call __errno_location wrt ..plt
+    mov dword [rax], 22            ; EINVAL
+    mov eax, -1
+
+.exit:
+    lea rsp, [rbp-40]
+    pop r15
+    pop r14
+    pop r13
+    pop r12
+    pop rbx
+    pop rbp
+    ret
@@ -1,8 +1,12 @@
+// Standalone build (no assembler needed):
+//   gcc -Iinclude src/simple_main.c src/dskypoly_log.c -o dskypoly_simple -lm -pthread
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
 #include <math.h>
 
+#include "dskypoly.h"
+
 // Simple quadratic solver implementation
 void solve_poly_2(double a, double b, double c,
                   double* r1_real, double* r1_imag,
@@ -31,20 +35,11 @@ static double a = 0, b = 0, c = 0;
 static double r1_real = 0, r1_imag = 0;
 static double r2_real = 0, r2_imag = 0;
 
-// Logging function
-void log_event(const char* msg) {
-    FILE *log = fopen("DSKYpoly.log", "a");
-    if (!log) {
-        perror("Log file error");
+// Logging function: queued to the log ring, echoed while the level is on
+void log_event(int level, const char* msg) {
+    if (!dskypoly_log_enabled(level))
         return;
-    }
-
-    time_t now = time(NULL);
-    struct tm *t = localtime(&now);
-    fprintf(log, "[%04d-%02d-%02d %02d:%02d:%02d] %s\n",
-        t->tm_year + 1900, t->tm_mon + 1, t->tm_mday,
-        t->tm_hour, t->tm_min, t->tm_sec, msg);
-    fclose(log);
+    dskypoly_log(level, msg);
     printf("DSKYpoly: %s\n", msg);
 }
 
@@ -58,6 +53,8 @@ void print_root(const char* label, double real, double imag) {
 
 int main() {
     int verb, noun;
+    if (dskypoly_log_open("DSKYpoly.log", DSKYPOLY_LOG_DEBUG) != 0)
+        perror("Log file error");
     printf("=== DSKYpoly Interface ===\n");
 
     while (1) {
@@ -68,35 +65,35 @@ int main() {
 
         char log_msg[128];
         snprintf(log_msg, sizeof(log_msg), "VERB %02d / NOUN %02d entered.", verb, noun);
-        log_event(log_msg);
+        log_event(DSKYPOLY_LOG_INFO, log_msg);
 
         if (verb == 10 && noun == 1) {
             printf("Loading quadratic polynomial coefficients...\n");
-            log_event("Prompting for coefficients.");
+            log_event(DSKYPOLY_LOG_INFO, "Prompting for coefficients.");
             printf("Enter coefficient a: ");
             scanf("%lf", &a);
             printf("Enter coefficient b: ");
             scanf("%lf", &b);
             printf("Enter coefficient c: ");
             scanf("%lf", &c);
-            log_event("Coefficients loaded.");
+            log_event(DSKYPOLY_LOG_INFO, "Coefficients loaded.");
         } else if (verb == 20 && noun == 1) {
             printf("Solving quadratic polynomial...\n");
-            log_event("Calling solver.");
+            log_event(DSKYPOLY_LOG_DEBUG, "Calling solver.");
             solve_poly_2(a, b, c, &r1_real, &r1_imag, &r2_real, &r2_imag);
-            log_event("Solver completed.");
+            log_event(DSKYPOLY_LOG_DEBUG, "Solver completed.");
         } else if (verb == 30 && noun == 1) {
             printf("Displaying the roots:\n");
-            log_event("Displaying roots.");
+            log_event(DSKYPOLY_LOG_INFO, "Displaying roots.");
             print_root("Root 1", r1_real, r1_imag);
             print_root("Root 2", r2_real, r2_imag);
         } else if (verb == 99) {
             printf("Exiting DSKYpoly.\n");
-            log_event("Program exited.");
+            log_event(DSKYPOLY_LOG_INFO, "Program exited.");
             break;
         } else {
             printf("Invalid VERB/NOUN combination.\n");
-            log_event("Invalid command.");
+            log_event(DSKYPOLY_LOG_INFO, "Invalid command.");
         }
     }
 
@@ -1,9 +1,22 @@
 ;**************************************************************************
 ; solve_poly_2.asm
-; Robust quadratic solver for ax^2 + bx + c = 0
+; Robust quadratic solver for ax^2 + bx + c = 0, scalar SSE2
 ; Accepts inputs from C, returns real and imaginary parts of both roots
+;
+; Everything stays in xmm registers: no stack traffic, no x87 status-word
+; round trip. Real roots use the cancellation-free form
+;   q = -(b + sign(b) sqrt(D)) / 2,   roots q/a and c/q
+; so the smaller root keeps full precision when b^2 >> 4ac. Both quotients
+; come out of one packed divpd. Root order matches the textbook formula
+; (r1 = (-b + sqrt(D)) / 2a) of the x87 solve_poly_2_reference.
 ;**************************************************************************
 
+section .rodata
+    align 16
+    pd_sign     dq 0x8000000000000000, 0x8000000000000000
+    sd_four     dq 4.0
+    sd_neg_half dq -0.5
+
 section .text
     global solve_poly_2
 
@@ -13,141 +26,71 @@ solve_poly_2:
     ; rdi = &r1_real, rsi = &r1_imag
     ; rdx = &r2_real, rcx = &r2_imag
 
-    ; Save inputs to stack for FPU access
-    sub rsp, 32
-    movsd qword [rsp], xmm0    ; a
-    movsd qword [rsp+8], xmm1  ; b
-    movsd qword [rsp+16], xmm2 ; c
-
     ; === Compute Discriminant: D = b^2 - 4ac ===
-    ; Load and compute b^2
-    fld qword [rsp+8]          ; ST0 = b
-    fmul st0, st0              ; ST0 = b^2
-    
-    ; Load a and c, compute 4ac
-    fld qword [rsp]            ; ST0 = a, ST1 = b^2
-    fld qword [rsp+16]         ; ST0 = c, ST1 = a, ST2 = b^2
-    fmul st0, st1              ; ST0 = ac, ST1 = a, ST2 = b^2
-    
-    ; Multiply ac by 4
-    fld1                       ; ST0 = 1, ST1 = ac, ST2 = a, ST3 = b^2
-    fadd st0, st0              ; ST0 = 2, ST1 = ac, ST2 = a, ST3 = b^2
-    fadd st0, st0              ; ST0 = 4, ST1 = ac, ST2 = a, ST3 = b^2
-    fmul st0, st1              ; ST0 = 4ac, ST1 = ac, ST2 = a, ST3 = b^2
-    
-    ; Compute discriminant: b^2 - 4ac
-    fld st3                    ; ST0 = b^2, ST1 = 4ac, ST2 = ac, ST3 = a, ST4 = b^2
-    fsub st0, st1              ; ST0 = b^2 - 4ac = D, ST1 = 4ac, ST2 = ac, ST3 = a, ST4 = b^2
-    
-    ; Store discriminant temporarily
-    fst qword [rsp+24]         ; Store D at [rsp+24]
-    
-    ; Clean up stack completely
-    fstp st0                   ; Pop D
-    fstp st0                   ; Pop 4ac  
-    fstp st0                   ; Pop ac
-    fstp st0                   ; Pop a
-    fstp st0                   ; Pop b^2
-    
-    ; Reload discriminant
-    fld qword [rsp+24]         ; ST0 = D
-
-    ; Duplicate D for comparison
-    fld st0                    ; ST0 = D, ST1 = D
-
-    ; === Check if D < 0 ===
-    ftst                       ; Compare ST0 (which is D) with 0
-    fstsw ax                   ; Store FPU status word in AX
-    sahf                       ; Load status flags from AH
-    jb .complex_roots          ; If D < 0, jump to complex roots
-    ; D >= 0, continue to real roots
+    movapd xmm3, xmm1
+    mulsd xmm3, xmm1               ; b^2
+    movapd xmm4, xmm0
+    mulsd xmm4, xmm2               ; ac
+    mulsd xmm4, [rel sd_four]      ; 4ac
+    subsd xmm3, xmm4               ; D
+    xorpd xmm5, xmm5
+
+    ; === Check if D < 0 (unordered D takes the complex path, as x87 did) ===
+    ucomisd xmm3, xmm5
+    jb .complex_roots
 
 .real_roots:
-    ; === Compute sqrt(D) ===
-    fsqrt                          ; ST0 = sqrt(D)
-
-    ; === Compute -b / 2a (common term) ===
-    fld qword [rsp+8]              ; ST0 = b, ST1 = sqrt(D)
-    fchs                           ; ST0 = -b, ST1 = sqrt(D)
-    fld qword [rsp]                ; ST0 = a, ST1 = -b, ST2 = sqrt(D)
-    fadd st0, st0                  ; ST0 = 2a, ST1 = -b, ST2 = sqrt(D)
-
-    ; === Compute root1 = (-b + sqrt(D)) / 2a ===
-    fld st2                        ; ST0 = sqrt(D), ST1 = 2a, ST2 = -b, ST3 = sqrt(D)
-    fadd st0, st2                  ; ST0 = sqrt(D) + (-b), ST1 = 2a, ST2 = -b, ST3 = sqrt(D)
-    fdiv st0, st1                  ; ST0 = root1, ST1 = 2a, ST2 = -b, ST3 = sqrt(D)
-    mov rax, rdi
-    fstp qword [rax]              ; *r1_real = root1
-
-    ; Set root1 imaginary part = 0
-    fldz
-    mov rax, rsi
-    fstp qword [rax]
-
-    ; === Compute root2 = (-b - sqrt(D)) / 2a ===
-    fld st2                        ; ST0 = sqrt(D), ST1 = 2a, ST2 = -b, ST3 = sqrt(D)
-    fsub st2, st0                  ; ST2 = -b - sqrt(D), ST1 = 2a, ST0 = sqrt(D), ST3 = sqrt(D)
-    fstp st0                       ; Pop sqrt(D), ST0 = 2a, ST1 = -b - sqrt(D), ST2 = sqrt(D)
-    fxch st1                       ; ST0 = -b - sqrt(D), ST1 = 2a, ST2 = sqrt(D)
-    fdiv st0, st1                  ; ST0 = root2, ST1 = 2a, ST2 = sqrt(D)
-    mov rax, rdx
-    fstp qword [rax]              ; *r2_real = root2
-
-    ; Set root2 imaginary part = 0
-    fldz
-    mov rax, rcx
-    fstp qword [rax]
-
-    ; Clean up FPU stack
-    fstp st0                       ; Pop 2a
-    fstp st0                       ; Pop sqrt(D)
-    add rsp, 32
+    ; === q = -(b + sign(b) sqrt(D)) / 2 ===
+    sqrtsd xmm3, xmm3              ; s = sqrt(D)
+    movapd xmm4, xmm1
+    andpd xmm4, [rel pd_sign]      ; sign(b)
+    orpd xmm3, xmm4                ; sign(b) s
+    addsd xmm3, xmm1               ; b + sign(b) s, never a cancellation
+    mulsd xmm3, [rel sd_neg_half]  ; q
+
+    ; === [q/a, c/q] in one division ===
+    movapd xmm4, xmm3
+    unpcklpd xmm4, xmm2            ; q | c
+    unpcklpd xmm0, xmm3            ; a | q
+    divpd xmm4, xmm0               ; q/a | c/q
+
+    ; q == 0 only when b = D = 0: both roots are then q/a = 0, not 0/0
+    movapd xmm6, xmm4
+    unpckhpd xmm6, xmm6            ; c/q
+    cmpneqsd xmm3, xmm5            ; q != 0
+    andpd xmm6, xmm3
+    andnpd xmm3, xmm4
+    orpd xmm6, xmm3                ; c/q, or q/a when q == 0
+
+    ; === q/a is (-b - s)/2a for b >= 0 and (-b + s)/2a for b < 0 ===
+    movmskpd eax, xmm1             ; bit 0 = sign(b)
+    mov r8, rdx                    ; destination of q/a
+    mov r9, rdi                    ; destination of c/q
+    test eax, 1
+    cmovnz r8, rdi
+    cmovnz r9, rdx
+    movsd [r8], xmm4
+    movsd [r9], xmm6
+
+    ; Imaginary parts are zero
+    movsd [rsi], xmm5
+    movsd [rcx], xmm5
     ret
 
 .complex_roots:
-    ; ST0 = D (negative), ST1 = D
-    fstp st1                   ; ST0 = D, pop duplicate
-
-    ; Compute sqrt(-D)
-    fchs                       ; ST0 = -D
-    fsqrt                      ; ST0 = sqrt(-D)
-
-    ; Save sqrt(-D) for later use
-    fst qword [rsp+24]         ; Store sqrt(-D) at [rsp+24]
-
-    ; Compute real part: -b / 2a
-    fld qword [rsp+8]          ; ST0 = b, ST1 = sqrt(-D)
-    fchs                       ; ST0 = -b, ST1 = sqrt(-D)
-    fld qword [rsp]            ; ST0 = a, ST1 = -b, ST2 = sqrt(-D)
-    fadd st0, st0              ; ST0 = 2a, ST1 = -b, ST2 = sqrt(-D)
-    
-    ; Compute -b / 2a
-    fxch st1                   ; ST0 = -b, ST1 = 2a, ST2 = sqrt(-D)
-    fdiv st0, st1              ; ST0 = -b/2a = real part, ST1 = 2a, ST2 = sqrt(-D)
-
-    ; Store real part to both roots
-    mov rax, rdi
-    fst qword [rax]            ; *r1_real = real part
-    mov rax, rdx
-    fst qword [rax]            ; *r2_real = real part
-
-    ; Compute imag part: sqrt(-D) / 2a
-    fxch st2                   ; ST0 = sqrt(-D), ST1 = 2a, ST2 = real part
-    fdiv st0, st1              ; ST0 = sqrt(-D) / 2a = imag part, ST1 = 2a, ST2 = real part
-
-    ; Store positive imaginary part to r1_imag
-    mov rax, rsi
-    fst qword [rax]            ; *r1_imag = +imag part
-
-    ; Store negative imaginary part to r2_imag
-    fchs                       ; ST0 = -imag part
-    mov rax, rcx
-    fstp qword [rax]           ; *r2_imag = -imag part
-
-    ; Clean up FPU stack
-    fstp st0                   ; Pop 2a
-    fstp st0                   ; Pop real part
-
-    add rsp, 32
+    ; === r1,2 = -b/2a ± i sqrt(-D)/2a, both parts in one division ===
+    movapd xmm4, [rel pd_sign]
+    xorpd xmm3, xmm4               ; -D
+    sqrtsd xmm3, xmm3              ; sqrt(-D)
+    xorpd xmm1, xmm4               ; -b
+    unpcklpd xmm1, xmm3            ; -b | sqrt(-D)
+    addsd xmm0, xmm0               ; 2a
+    unpcklpd xmm0, xmm0            ; 2a | 2a
+    divpd xmm1, xmm0               ; real | imag
+
+    movsd [rdi], xmm1              ; *r1_real = real part
+    movsd [rdx], xmm1              ; *r2_real = real part
+    movhpd [rsi], xmm1             ; *r1_imag = +imag part
+    xorpd xmm1, xmm4
+    movhpd [rcx], xmm1             ; *r2_imag = -imag part
     ret
-    
\ No newline at end of file
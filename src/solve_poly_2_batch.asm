@@ -0,0 +1,403 @@
+;**************************************************************************
+; solve_poly_2_batch.asm
+; Batched quadratic solver for n independent ax^2 + bx + c = 0 problems
+; Structure-of-arrays inputs/outputs, packed SSE2 / AVX2 / AVX-512 kernels
+; The public solve_poly_2_batch symbol lives in dskypoly_dispatch.c and
+; jumps to one of these according to the host CPU.
+;
+; C prototype (all three variants):
+;   void solve_poly_2_batch_<isa>(const double* a, const double* b, const double* c,
+;                                 size_t n,
+;                                 double* r1_real, double* r1_imag,
+;                                 double* r2_real, double* r2_imag);
+;
+; Every lane follows the cancellation-free program of the scalar
+; solve_poly_2 (src/solve_poly_2.asm):
+;   D >= 0 : q = -(b + sign(b) sqrt(D)) / 2,  roots q/a and c/q
+;            (both q/a when q == 0, i.e. b = D = 0), imag = 0
+;   D <  0 : r1,2 = -b/2a ± i sqrt(-D)/2a
+; in the same root order and with the same roundings, so batch and scalar
+; roots agree bit for bit and the smaller root of b^2 >> 4ac keeps full
+; precision. Each lane takes two divisions, with numerators and
+; denominators picked per lane: q/a or -b/2a, then c/q or sqrt(-D)/2a.
+; The real/complex split and the root order are lane masks, not branches,
+; so a batch with interleaved negative discriminants runs at full width.
+;**************************************************************************
+
+section .rodata
+    align 16
+    pd_neg_half dq -0.5, -0.5
+    pd_four     dq 4.0, 4.0
+    pd_abs      dq 0x7FFFFFFFFFFFFFFF, 0x7FFFFFFFFFFFFFFF
+    pd_sign     dq 0x8000000000000000, 0x8000000000000000
+
+section .text
+    global solve_poly_2_batch_sse2
+    global solve_poly_2_batch_avx2
+    global solve_poly_2_batch_avx512
+
+; Arguments (System V AMD64):
+; rdi = a[], rsi = b[], rdx = c[], rcx = n
+; r8  = r1_real[], r9 = r1_imag[]
+; [rsp+8] = r2_real[], [rsp+16] = r2_imag[]
+;
+; Shared register plan for all three kernels:
+; rax = byte offset of the current element, rcx = elements remaining
+; r10 = r2_real[], r11 = r2_imag[]
+;
+; Lane masks: neg = (D < 0), the complex lanes; bneg = sign bit of b. On
+; real lanes q/a is r1 when b is negative and r2 otherwise, as in
+; solve_poly_2; on complex lanes both real parts are -b/2a.
+
+;--------------------------------------------------------------------------
+; SSE2 kernel: 2 quadratics per instruction (baseline x86-64)
+;--------------------------------------------------------------------------
+solve_poly_2_batch_sse2:
+    mov r10, [rsp+8]               ; r2_real[]
+    mov r11, [rsp+16]              ; r2_imag[]
+    xor eax, eax                   ; offset = 0
+
+    ; Wider kernels finish their ragged tail here with rax/rcx/r10/r11 set
+.resume:
+    movapd xmm11, [rel pd_neg_half]    ; -0.5 | -0.5
+    movapd xmm12, [rel pd_four]    ; 4.0 | 4.0
+    movapd xmm13, [rel pd_abs]     ; |x| mask
+    movapd xmm14, [rel pd_sign]    ; sign-flip mask
+    xorpd xmm15, xmm15             ; 0.0 | 0.0
+
+.pair_loop:
+    cmp rcx, 2
+    jb .tail
+
+    movupd xmm0, [rdi+rax]         ; a
+    movupd xmm1, [rsi+rax]         ; b
+    movupd xmm2, [rdx+rax]         ; c
+
+    ; === D = b^2 - 4ac ===
+    movapd xmm3, xmm1
+    mulpd xmm3, xmm1               ; b^2
+    movapd xmm4, xmm0
+    mulpd xmm4, xmm2               ; ac
+    mulpd xmm4, xmm12              ; 4ac
+    subpd xmm3, xmm4               ; D
+
+    ; === Lane masks ===
+    movapd xmm5, xmm3
+    cmpltpd xmm5, xmm15            ; neg = (D < 0)
+    pshufd xmm10, xmm1, 0xF5       ; high dword of b in both halves
+    psrad xmm10, 31                ; bneg
+    andpd xmm3, xmm13              ; |D|
+    sqrtpd xmm3, xmm3              ; s = sqrt(|D|)
+
+    ; === q = -(b + sign(b) s) / 2 ===
+    movapd xmm6, xmm1
+    andpd xmm6, xmm14              ; sign(b)
+    orpd xmm6, xmm3                ; sign(b) s
+    addpd xmm6, xmm1               ; b + sign(b) s, never a cancellation
+    mulpd xmm6, xmm11              ; q
+
+    ; === X = q/a, or -b/2a on complex lanes ===
+    movapd xmm7, xmm0
+    addpd xmm7, xmm0               ; 2a
+    xorpd xmm1, xmm14              ; -b
+    andpd xmm1, xmm5
+    movapd xmm4, xmm5
+    andnpd xmm4, xmm6
+    orpd xmm4, xmm1                ; q | -b
+    movapd xmm8, xmm5
+    andpd xmm8, xmm7
+    movapd xmm9, xmm5
+    andnpd xmm9, xmm0
+    orpd xmm8, xmm9                ; a | 2a
+    divpd xmm4, xmm8               ; X
+
+    ; === Y = c/q, or sqrt(-D)/2a on complex lanes ===
+    andpd xmm3, xmm5
+    movapd xmm9, xmm5
+    andnpd xmm9, xmm2
+    orpd xmm3, xmm9                ; c | s
+    andpd xmm7, xmm5
+    movapd xmm9, xmm5
+    andnpd xmm9, xmm6
+    orpd xmm7, xmm9                ; q | 2a
+    divpd xmm3, xmm7               ; Y
+
+    ; q == 0 only when b = D = 0: both roots are then q/a = 0, not 0/0
+    cmpeqpd xmm7, xmm15
+    movapd xmm9, xmm7
+    andpd xmm9, xmm4
+    andnpd xmm7, xmm3
+    orpd xmm7, xmm9                ; Y, or X where q == 0
+
+    ; === Imaginary parts: ± Y on complex lanes, exact +0 on real lanes ===
+    movapd xmm3, xmm7
+    andpd xmm3, xmm5               ; r1_imag
+    movapd xmm8, xmm3
+    xorpd xmm8, xmm14
+    andpd xmm8, xmm5               ; r2_imag
+
+    ; === Real parts: X where bneg or neg for r1, where !bneg or neg for r2 ===
+    movapd xmm6, xmm10
+    orpd xmm6, xmm5
+    movapd xmm1, xmm6
+    andpd xmm1, xmm4
+    andnpd xmm6, xmm7
+    orpd xmm6, xmm1                ; r1_real
+    andnpd xmm5, xmm10             ; bneg on real lanes
+    movapd xmm1, xmm5
+    andpd xmm1, xmm7
+    andnpd xmm5, xmm4
+    orpd xmm1, xmm5                ; r2_real
+
+    movupd [r8+rax], xmm6
+    movupd [r9+rax], xmm3
+    movupd [r10+rax], xmm1
+    movupd [r11+rax], xmm8
+
+    add rax, 16
+    sub rcx, 2
+    jmp .pair_loop
+
+.tail:
+    ; === Scalar tail: same lane program on the low element only ===
+    test rcx, rcx
+    jz .done
+
+    movsd xmm0, [rdi+rax]          ; a
+    movsd xmm1, [rsi+rax]          ; b
+    movsd xmm2, [rdx+rax]          ; c
+
+    movapd xmm3, xmm1
+    mulsd xmm3, xmm1               ; b^2
+    movapd xmm4, xmm0
+    mulsd xmm4, xmm2               ; ac
+    mulsd xmm4, xmm12              ; 4ac
+    subsd xmm3, xmm4               ; D
+
+    movapd xmm5, xmm3
+    cmpltsd xmm5, xmm15            ; neg
+    pshufd xmm10, xmm1, 0xF5
+    psrad xmm10, 31                ; bneg
+    andpd xmm3, xmm13              ; |D|
+    sqrtsd xmm3, xmm3              ; s
+
+    movapd xmm6, xmm1
+    andpd xmm6, xmm14
+    orpd xmm6, xmm3
+    addsd xmm6, xmm1
+    mulsd xmm6, xmm11              ; q
+
+    movapd xmm7, xmm0
+    addsd xmm7, xmm0               ; 2a
+    xorpd xmm1, xmm14              ; -b
+    andpd xmm1, xmm5
+    movapd xmm4, xmm5
+    andnpd xmm4, xmm6
+    orpd xmm4, xmm1                ; q | -b
+    movapd xmm8, xmm5
+    andpd xmm8, xmm7
+    movapd xmm9, xmm5
+    andnpd xmm9, xmm0
+    orpd xmm8, xmm9                ; a | 2a
+    divsd xmm4, xmm8               ; X
+
+    andpd xmm3, xmm5
+    movapd xmm9, xmm5
+    andnpd xmm9, xmm2
+    orpd xmm3, xmm9                ; c | s
+    andpd xmm7, xmm5
+    movapd xmm9, xmm5
+    andnpd xmm9, xmm6
+    orpd xmm7, xmm9                ; q | 2a
+    divsd xmm3, xmm7               ; Y
+
+    cmpeqsd xmm7, xmm15
+    movapd xmm9, xmm7
+    andpd xmm9, xmm4
+    andnpd xmm7, xmm3
+    orpd xmm7, xmm9                ; Y, or X where q == 0
+
+    movapd xmm3, xmm7
+    andpd xmm3, xmm5               ; r1_imag
+    movapd xmm8, xmm3
+    xorpd xmm8, xmm14
+    andpd xmm8, xmm5               ; r2_imag
+
+    movapd xmm6, xmm10
+    orpd xmm6, xmm5
+    movapd xmm1, xmm6
+    andpd xmm1, xmm4
+    andnpd xmm6, xmm7
+    orpd xmm6, xmm1                ; r1_real
+    andnpd xmm5, xmm10
+    movapd xmm1, xmm5
+    andpd xmm1, xmm7
+    andnpd xmm5, xmm4
+    orpd xmm1, xmm5                ; r2_real
+
+    movsd [r8+rax], xmm6
+    movsd [r9+rax], xmm3
+    movsd [r10+rax], xmm1
+    movsd [r11+rax], xmm8
+
+.done:
+    ret
+
+;--------------------------------------------------------------------------
+; AVX2 kernel: 4 quadratics per instruction
+; No FMA contraction, so every lane rounds exactly like the SSE2 kernel
+;--------------------------------------------------------------------------
+solve_poly_2_batch_avx2:
+    mov r10, [rsp+8]               ; r2_real[]
+    mov r11, [rsp+16]              ; r2_imag[]
+    xor eax, eax                   ; offset = 0
+
+    vbroadcastsd ymm11, [rel pd_neg_half]
+    vbroadcastsd ymm12, [rel pd_four]
+    vbroadcastsd ymm13, [rel pd_abs]
+    vbroadcastsd ymm14, [rel pd_sign]
+    vxorpd ymm15, ymm15, ymm15
+
+.quad_loop:
+    cmp rcx, 4
+    jb .tail
+
+    vmovupd ymm0, [rdi+rax]        ; a
+    vmovupd ymm1, [rsi+rax]        ; b
+    vmovupd ymm2, [rdx+rax]        ; c
+
+    vmulpd ymm3, ymm1, ymm1        ; b^2
+    vmulpd ymm4, ymm0, ymm2        ; ac
+    vmulpd ymm4, ymm4, ymm12       ; 4ac
+    vsubpd ymm3, ymm3, ymm4        ; D
+
+    vcmpltpd ymm5, ymm3, ymm15     ; neg = (D < 0)
+    vpcmpgtq ymm10, ymm15, ymm1    ; bneg
+    vandpd ymm3, ymm3, ymm13       ; |D|
+    vsqrtpd ymm3, ymm3             ; s
+
+    vandpd ymm6, ymm1, ymm14
+    vorpd ymm6, ymm6, ymm3
+    vaddpd ymm6, ymm6, ymm1
+    vmulpd ymm6, ymm6, ymm11       ; q
+
+    vaddpd ymm7, ymm0, ymm0        ; 2a
+    vxorpd ymm1, ymm1, ymm14       ; -b
+    vblendvpd ymm4, ymm6, ymm1, ymm5   ; q | -b
+    vblendvpd ymm8, ymm0, ymm7, ymm5   ; a | 2a
+    vdivpd ymm4, ymm4, ymm8        ; X
+    vblendvpd ymm3, ymm2, ymm3, ymm5   ; c | s
+    vblendvpd ymm7, ymm6, ymm7, ymm5   ; q | 2a
+    vdivpd ymm3, ymm3, ymm7        ; Y
+    vcmpeqpd ymm7, ymm7, ymm15
+    vblendvpd ymm7, ymm3, ymm4, ymm7   ; Y, or X where q == 0
+
+    vandpd ymm3, ymm7, ymm5        ; r1_imag
+    vxorpd ymm8, ymm3, ymm14
+    vandpd ymm8, ymm8, ymm5        ; r2_imag
+
+    vorpd ymm6, ymm10, ymm5
+    vblendvpd ymm6, ymm7, ymm4, ymm6   ; r1_real
+    vandnpd ymm10, ymm5, ymm10     ; bneg on real lanes
+    vblendvpd ymm1, ymm4, ymm7, ymm10  ; r2_real
+
+    vmovupd [r8+rax], ymm6
+    vmovupd [r9+rax], ymm3
+    vmovupd [r10+rax], ymm1
+    vmovupd [r11+rax], ymm8
+
+    add rax, 32
+    sub rcx, 4
+    jmp .quad_loop
+
+.tail:
+    ; Leave the 256-bit state before running legacy-SSE code
+    vzeroupper
+    jmp solve_poly_2_batch_sse2.resume
+
+;--------------------------------------------------------------------------
+; AVX-512 kernel: 8 quadratics per instruction, masked tail (AVX512F only)
+;--------------------------------------------------------------------------
+solve_poly_2_batch_avx512:
+    mov r10, [rsp+8]               ; r2_real[]
+    mov r11, [rsp+16]              ; r2_imag[]
+    xor eax, eax                   ; offset = 0
+
+    vbroadcastsd zmm11, [rel pd_neg_half]
+    vbroadcastsd zmm12, [rel pd_four]
+    vbroadcastsd zmm13, [rel pd_abs]
+    vbroadcastsd zmm14, [rel pd_sign]
+    vpxorq zmm15, zmm15, zmm15
+    kxnorw k2, k2, k2              ; all lanes active
+
+.oct_loop:
+    cmp rcx, 8
+    jb .tail
+
+.body:
+    vmovupd zmm0{k2}{z}, [rdi+rax] ; a
+    vmovupd zmm1{k2}{z}, [rsi+rax] ; b
+    vmovupd zmm2{k2}{z}, [rdx+rax] ; c
+
+    vmulpd zmm3, zmm1, zmm1        ; b^2
+    vmulpd zmm4, zmm0, zmm2        ; ac
+    vmulpd zmm4, zmm4, zmm12       ; 4ac
+    vsubpd zmm3, zmm3, zmm4        ; D
+
+    vcmppd k1, zmm3, zmm15, 1      ; neg = (D < 0)
+    vpcmpq k4, zmm1, zmm15, 1      ; bneg: b < 0 as an integer
+    vpandq zmm3, zmm3, zmm13       ; |D|
+    vsqrtpd zmm3, zmm3             ; s
+
+    vpandq zmm6, zmm1, zmm14
+    vporq zmm6, zmm6, zmm3
+    vaddpd zmm6, zmm6, zmm1
+    vmulpd zmm6, zmm6, zmm11       ; q
+
+    vaddpd zmm7, zmm0, zmm0        ; 2a
+    vmovapd zmm4, zmm6
+    vpxorq zmm4{k1}, zmm1, zmm14   ; q | -b
+    vmovapd zmm0{k1}, zmm7         ; a | 2a
+    vdivpd zmm4, zmm4, zmm0        ; X
+    vmovapd zmm2{k1}, zmm3         ; c | s
+    vmovapd zmm6{k1}, zmm7         ; q | 2a
+    vdivpd zmm2, zmm2, zmm6        ; Y
+    vcmppd k5, zmm6, zmm15, 0
+    vmovapd zmm2{k5}, zmm4         ; Y, or X where q == 0
+
+    vmovapd zmm3{k1}{z}, zmm2          ; r1_imag (+0 on real lanes)
+    vpxorq zmm8{k1}{z}, zmm2, zmm14    ; r2_imag (+0 on real lanes)
+
+    korw k6, k4, k1
+    vmovapd zmm7, zmm2
+    vmovapd zmm7{k6}, zmm4         ; r1_real
+    kandnw k6, k1, k4              ; bneg on real lanes
+    vmovapd zmm1, zmm4
+    vmovapd zmm1{k6}, zmm2         ; r2_real
+
+    vmovupd [r8+rax]{k2}, zmm7
+    vmovupd [r9+rax]{k2}, zmm3
+    vmovupd [r10+rax]{k2}, zmm1
+    vmovupd [r11+rax]{k2}, zmm8
+
+    add rax, 64
+    sub rcx, 8
+    ja .oct_loop                   ; more work left (rcx > 0 and no borrow)
+    jmp .done
+
+.tail:
+    ; === 1..7 leftover quadratics: one masked pass ===
+    test rcx, rcx
+    jz .done
+    push rax
+    mov eax, 1
+    shl eax, cl
+    dec eax                        ; (1 << remaining) - 1
+    kmovw k2, eax
+    pop rax
+    mov ecx, 8                     ; makes the masked pass the last one
+    jmp .body
+
+.done:
+    vzeroupper
+    ret
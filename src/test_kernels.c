@@ -0,0 +1,340 @@
+// === test_kernels.c for DSKYpoly ===
+// Accuracy regressions for the silent kernels, run by make test-kernels.
+// Every case builds a polynomial from known roots and checks that the
+// kernel gives them back to a relative error bound: each computed root is
+// matched to the nearest unused expected one, and the distance is divided
+// by the root scale. Prints one line per case; exits 1 if any failed.
+//
+// usage: test_kernels
+
+#include <complex.h>
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "dskypoly.h"
+
+#define TEST_LANES 100000        // random polynomials per randomized case
+#define TEST_BATCH 37            // quadratics per batch call: every kernel's tail runs
+
+static int failures;
+
+static void report(const char* name, double worst, double tol) {
+    int ok = worst <= tol;
+    printf("%s %-48s worst %.3g (tol %.0e)\n", ok ? "PASS" : "FAIL", name, worst, tol);
+    failures += !ok;
+}
+
+static double uniform(void) {
+    return 2.0 * rand() / (double)RAND_MAX - 1.0;
+}
+
+// Largest |computed - expected| / scale over the n roots
+static double root_error(const double complex* expect, const double* re, const double* im,
+                         int n, double scale) {
+    int used[DSKYPOLY_MAX_DEGREE] = { 0 };
+    double worst = 0.0;
+    for (int i = 0; i < n; i++) {
+        int best = -1;
+        double d = INFINITY;
+        for (int j = 0; j < n; j++) {
+            double dj = cabs(expect[i] - (re[j] + I * im[j]));
+            if (!used[j] && dj < d) {
+                d = dj;
+                best = j;
+            }
+        }
+        if (best < 0)
+            return INFINITY;
+        used[best] = 1;
+        worst = d / scale > worst ? d / scale : worst;
+    }
+    return worst;
+}
+
+// Monic coefficients, highest first, of the polynomial with these roots
+static void from_roots(const double complex* r, int n, double* c) {
+    double complex p[DSKYPOLY_MAX_DEGREE + 1] = { 1.0 };
+    for (int k = 0; k < n; k++)
+        for (int j = k + 1; j > 0; j--)
+            p[j] -= r[k] * p[j - 1];
+    for (int k = 0; k <= n; k++)
+        c[k] = creal(p[k]);
+}
+
+// Four roots of size about scale: all real, or a conjugate pair and two real
+static void random_quartic_roots(double complex* r, double scale) {
+    if (rand() & 1) {
+        for (int k = 0; k < 4; k++)
+            r[k] = scale * uniform();
+    } else {
+        r[0] = scale * (uniform() + I * uniform());
+        r[1] = conj(r[0]);
+        r[2] = scale * uniform();
+        r[3] = scale * uniform();
+    }
+}
+
+// Ferrari at every root scale: the biquadratic shortcut must not fire
+// on a quartic that merely has small coefficients
+static void test_quartic_scales(void) {
+    static const double scales[] = { 1e-8, 1e-5, 1e-2, 1.0, 1e3, 1e6 };
+    char name[64];
+
+    for (size_t i = 0; i < sizeof(scales) / sizeof(scales[0]); i++) {
+        double s = scales[i], c[5], re[4], im[4];
+        double complex r[4] = { 1.0 * s, 2.0 * s, 3.0 * s, -6.0 * s };
+        from_roots(r, 4, c);
+        solve_poly_4_production(c[0], c[1], c[2], c[3], c[4], re, im);
+        snprintf(name, sizeof(name), "quartic {1,2,3,-6} x %g", s);
+        report(name, root_error(r, re, im, 4, s), 1e-9);
+    }
+
+    srand(2025);
+    for (size_t i = 0; i < sizeof(scales) / sizeof(scales[0]); i++) {
+        double s = scales[i], worst = 0.0;
+        for (int n = 0; n < TEST_LANES; n++) {
+            double complex r[4];
+            double c[5], re[4], im[4];
+            random_quartic_roots(r, s);
+            from_roots(r, 4, c);
+            solve_poly_4_production(c[0], c[1], c[2], c[3], c[4], re, im);
+            double e = root_error(r, re, im, 4, s);
+            worst = e > worst ? e : worst;
+        }
+        snprintf(name, sizeof(name), "quartic random roots x %g", s);
+        report(name, worst, 1e-6);
+    }
+}
+
+typedef void (*quad_batch_fn)(const double*, const double*, const double*, size_t,
+                              double*, double*, double*, double*);
+
+// Largest relative error of the two real roots of one quadratic, each
+// against its own magnitude: a cancelling formula loses the small root
+static double quad_error(double e1, double e2, double x1, double x2) {
+    double same = fmax(fabs(x1 - e1) / fabs(e1), fabs(x2 - e2) / fabs(e2));
+    double swap = fmax(fabs(x1 - e2) / fabs(e2), fabs(x2 - e1) / fabs(e1));
+    return fmin(same, swap);
+}
+
+// x^2 ± 1e8 x + 1 through every batch kernel and the sorted bulk solve:
+// the small root -1/1e8 must keep full precision, and every lane must
+// match scalar solve_poly_2 bit for bit
+static void test_quadratic_batch(void) {
+    static const struct { const char* name; quad_batch_fn fn; int level; } kernels[] = {
+        { "SSE2",    solve_poly_2_batch_sse2,   DSKYPOLY_ISA_SSE2 },
+        { "AVX2",    solve_poly_2_batch_avx2,   DSKYPOLY_ISA_AVX2 },
+        { "AVX-512", solve_poly_2_batch_avx512, DSKYPOLY_ISA_AVX512 },
+    };
+    double a[TEST_BATCH], b[TEST_BATCH], c[TEST_BATCH];
+    double r1r[TEST_BATCH], r1i[TEST_BATCH], r2r[TEST_BATCH], r2i[TEST_BATCH];
+    double e1[TEST_BATCH], e2[TEST_BATCH];
+    char name[64];
+
+    // Lane i: roots s and 1/s with s = -(1 + i/64) 1e-8, flipped for odd i
+    for (int i = 0; i < TEST_BATCH; i++) {
+        double s = -(1.0 + i / 64.0) * 1e-8, sign = (i & 1) ? -1.0 : 1.0;
+        e1[i] = sign * s;
+        e2[i] = sign / s;
+        a[i] = 1.0;
+        b[i] = -(e1[i] + e2[i]);
+        c[i] = 1.0;
+    }
+
+    for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++) {
+        if (dskypoly_cpu_level() < kernels[k].level) {
+            printf("SKIP quadratic batch %s (not available)\n", kernels[k].name);
+            continue;
+        }
+        double worst = 0.0;
+        kernels[k].fn(a, b, c, TEST_BATCH, r1r, r1i, r2r, r2i);
+        for (int i = 0; i < TEST_BATCH; i++) {
+            double e = quad_error(e1[i], e2[i], r1r[i], r2r[i]);
+            if (r1i[i] != 0.0 || r2i[i] != 0.0)
+                e = INFINITY;
+            worst = e > worst ? e : worst;
+        }
+        snprintf(name, sizeof(name), "quadratic batch %s x^2 + 1e8 x + 1", kernels[k].name);
+        report(name, worst, 1e-15);
+    }
+
+    dskypoly_poly polys[TEST_BATCH];
+    double re[TEST_BATCH * DSKYPOLY_MAX_DEGREE], im[TEST_BATCH * DSKYPOLY_MAX_DEGREE];
+    double worst = 0.0;
+    for (int i = 0; i < TEST_BATCH; i++)
+        polys[i] = (dskypoly_poly){ 2, { a[i], b[i], c[i] } };
+    dskypoly_solve_sorted(polys, TEST_BATCH, re, im, NULL, 1, NULL);
+    for (int i = 0; i < TEST_BATCH; i++) {
+        double* r = re + i * DSKYPOLY_MAX_DEGREE;
+        double e = quad_error(e1[i], e2[i], r[0], r[1]);
+        worst = e > worst ? e : worst;
+    }
+    report("quadratic dskypoly_solve_sorted x^2 + 1e8 x + 1", worst, 1e-15);
+
+    // Random real, complex, repeated and zero roots against the scalar kernel
+    srand(2025);
+    for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++) {
+        if (dskypoly_cpu_level() < kernels[k].level)
+            continue;
+        int mismatches = 0;
+        for (int pass = 0; pass < TEST_LANES / TEST_BATCH; pass++) {
+            for (int i = 0; i < TEST_BATCH; i++) {
+                a[i] = uniform() * pow(10.0, 6.0 * uniform());
+                b[i] = rand() % 8 ? uniform() * pow(10.0, 6.0 * uniform()) : 0.0;
+                c[i] = rand() % 8 ? uniform() * pow(10.0, 6.0 * uniform()) : 0.0;
+            }
+            kernels[k].fn(a, b, c, TEST_BATCH, r1r, r1i, r2r, r2i);
+            for (int i = 0; i < TEST_BATCH; i++) {
+                double s[4];
+                solve_poly_2(a[i], b[i], c[i], &s[0], &s[1], &s[2], &s[3]);
+                double v[4] = { r1r[i], r1i[i], r2r[i], r2i[i] };
+                mismatches += memcmp(s, v, sizeof(s)) != 0;
+            }
+        }
+        snprintf(name, sizeof(name), "quadratic batch %s vs solve_poly_2", kernels[k].name);
+        report(name, mismatches, 0.0);
+    }
+}
+
+// Float quartics with small roots: lanes flagged for the double redo must
+// come back at their own scale, not be re-solved as raw tiny coefficients
+static void test_f32_quartic_small(void) {
+    // Clustered roots -9.797e-5 and -9.559e-5 flag this lane; the double
+    // solve of the same float coefficients is the reference
+    float a = 1.0f, b = 2.32662e-4f, c = 1.43586e-8f, d = -1.32226e-13f, e = -2.41151e-17f;
+    float re[4], im[4];
+    double zr[4], zi[4], xr[4], xi[4];
+    double complex z[4];
+    solve_poly_4_production(a, b, c, d, e, zr, zi);
+    for (int k = 0; k < 4; k++)
+        z[k] = zr[k] + I * zi[k];
+    int redo = solve_poly_4_batch_f32(&a, &b, &c, &d, &e, 1, re, im, 0.0f);
+    for (int k = 0; k < 4; k++) {
+        xr[k] = re[k];
+        xi[k] = im[k];
+    }
+    report("f32 quartic small clustered roots (redo)",
+           redo == 1 ? root_error(z, xr, xi, 4, 1e-4) : INFINITY, 1e-6);
+
+    static const double scales[] = { 1e-10, 1e-8, 1e-6, 1e-4, 1e-2 };
+    char name[64];
+    for (size_t i = 0; i < sizeof(scales) / sizeof(scales[0]); i++) {
+        double s = scales[i], q[5];
+        double complex r[4] = { 0.98 * s, 1.0 * s, 3.0 * s, -6.0 * s };
+        from_roots(r, 4, q);
+        float fa = q[0], fb = q[1], fc = q[2], fd = q[3], fe = q[4];
+        redo = solve_poly_4_batch_f32(&fa, &fb, &fc, &fd, &fe, 1, re, im, 0.0f);
+        for (int k = 0; k < 4; k++) {
+            xr[k] = re[k];
+            xi[k] = im[k];
+        }
+        snprintf(name, sizeof(name), "f32 quartic {0.98,1,3,-6} x %g (redo)", s);
+        report(name, redo == 1 ? root_error(r, xr, xi, 4, s) : INFINITY, 1e-4);
+    }
+}
+
+// Quintics with tiny coefficients: 1e-14 x^5 + 5e-13 x^4 - 1e-14 is not
+// the monomial 1e-14 x^5 - 1e-14, whatever its absolute size. Judged by
+// the relative residual |p(z)| / sum |c_k| |z|^k of every root, which the
+// fifth roots of unity put near 1
+static void test_quintic_small_coefficients(void) {
+    dskypoly_poly polys[2];
+    double re[2 * DSKYPOLY_MAX_DEGREE], im[2 * DSKYPOLY_MAX_DEGREE];
+    int nroots[2];
+    polys[0] = (dskypoly_poly){ 5, { 1e-14, 5e-13, 0.0, 0.0, 0.0, -1e-14 } };
+    polys[1] = (dskypoly_poly){ 5, { 1e-14, 0.0, 0.0, 0.0, 0.0, -1e-14 } };
+
+    for (int sorted = 0; sorted < 2; sorted++) {
+        if (sorted)
+            dskypoly_solve_sorted(polys, 2, re, im, nroots, 1, NULL);
+        else
+            dskypoly_solve(polys, 2, re, im, nroots, 1);
+        for (int i = 0; i < 2; i++) {
+            double worst = nroots[i] == 5 ? 0.0 : INFINITY;
+            for (int k = 0; k < 5 && nroots[i] == 5; k++) {
+                double complex z = re[i * DSKYPOLY_MAX_DEGREE + k] + I * im[i * DSKYPOLY_MAX_DEGREE + k];
+                double complex p = 0.0;
+                double scale = 0.0;
+                for (int j = 0; j <= 5; j++) {
+                    p = p * z + polys[i].coeffs[j];
+                    scale = scale * cabs(z) + fabs(polys[i].coeffs[j]);
+                }
+                double e = cabs(p) / scale;
+                worst = e > worst ? e : worst;
+            }
+            char name[80];
+            snprintf(name, sizeof(name), "quintic %s 1e-14 x^5 %s- 1e-14 residual",
+                     sorted ? "dskypoly_solve_sorted" : "dskypoly_solve", i ? "" : "+ 5e-13 x^4 ");
+            report(name, worst, 1e-12);
+        }
+    }
+}
+
+// Degree cap of the polisher's stack work area: x^1024 - 1 from roots of
+// unity nudged by 1e-6 is polished; one degree more is refused untouched
+static void test_refine_degree_cap(void) {
+    enum { N = DSKYPOLY_REFINE_MAX_DEGREE };
+    static double c[N + 2], re[N + 1], im[N + 1];
+    double worst = 0.0;
+    c[0] = 1.0;
+    c[N] = -1.0;
+    for (int k = 0; k < N; k++) {
+        re[k] = cos(2.0 * M_PI * k / N) + 1e-6;
+        im[k] = sin(2.0 * M_PI * k / N) - 1e-6;
+    }
+    int met = refine_poly_n(c, N, re, im, NULL, 8, 1e-12);
+    for (int k = 0; k < N; k++) {
+        double e = hypot(re[k] - cos(2.0 * M_PI * k / N), im[k] - sin(2.0 * M_PI * k / N));
+        worst = e > worst ? e : worst;
+    }
+    report("refine_poly_n x^1024 - 1", met == N ? worst : INFINITY, 1e-12);
+
+    c[N] = 0.0;
+    c[N + 1] = -1.0;
+    re[N] = im[N] = 0.5;
+    errno = 0;
+    int r = refine_poly_n(c, N + 1, re, im, NULL, 8, 1e-12);
+    report("refine_poly_n degree 1025 refused", r == -1 && errno == EINVAL && re[N] == 0.5 ? 0.0 : 1.0, 0.0);
+}
+
+// The same cap on the Aberth engine's stack planes: x^1024 - 1 converges
+// at the cap, and one degree more is refused untouched
+static void test_aberth_degree_cap(void) {
+    enum { N = DSKYPOLY_ABERTH_MAX_DEGREE };
+    static double c[N + 2], re[N + 1], im[N + 1];
+    double worst = 0.0;
+    c[0] = 1.0;
+    c[N] = -1.0;
+    int met = solve_poly_n_aberth(c, N, re, im);
+    for (int k = 0; k < N; k++) {
+        double e = fabs(hypot(re[k], im[k]) - 1.0);
+        double pk = carg(re[k] + I * im[k]) * N / (2.0 * M_PI);
+        e = fmax(e, fabs(pk - round(pk)) * 2.0 * M_PI / N);
+        worst = e > worst ? e : worst;
+    }
+    report("solve_poly_n_aberth x^1024 - 1", met == N ? worst : INFINITY, 1e-12);
+
+    c[N] = 0.0;
+    c[N + 1] = -1.0;
+    re[N] = im[N] = 0.5;
+    errno = 0;
+    int sweeps = -1;
+    int r = solve_poly_n_aberth_sweeps(c, N + 1, re, im, &sweeps);
+    report("solve_poly_n_aberth degree 1025 refused",
+           r == -1 && errno == EINVAL && sweeps == 0 && re[N] == 0.5 ? 0.0 : 1.0, 0.0);
+}
+
+int main(void) {
+    printf("=== DSKYpoly Kernel Accuracy Tests ===\n");
+    test_quartic_scales();
+    test_quadratic_batch();
+    test_f32_quartic_small();
+    test_quintic_small_coefficients();
+    test_refine_degree_cap();
+    test_aberth_degree_cap();
+    printf("%d failed\n", failures);
+    return failures ? 1 : 0;
+}